@@ -0,0 +1,72 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_BENCHMARK_BGCODE_BENCHMARK_H
+#define CURAENGINE_BENCHMARK_BGCODE_BENCHMARK_H
+
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "utils/BinaryGCode.h"
+
+namespace cura
+{
+class BinaryGCodeFixture : public benchmark::Fixture
+{
+public:
+    std::string gcode;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        gcode.clear();
+        for (int64_t line = 0; line < state.range(0); line++)
+        {
+            gcode += "G1 X" + std::to_string(100 + line % 37) + "." + std::to_string(line % 1000) + " Y" + std::to_string(50 + line % 23) + "." + std::to_string(line % 7)
+                   + " E" + std::to_string(line / 10) + "." + std::to_string(line % 10) + "\n";
+        }
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+    }
+};
+
+BENCHMARK_DEFINE_F(BinaryGCodeFixture, bgcode_encode)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        std::ostringstream file;
+        BinaryGCodeEncoder encoder(file);
+        std::ostream stream(&encoder);
+        stream << gcode;
+        stream.flush();
+        benchmark::DoNotOptimize(file.str());
+    }
+    st.SetBytesProcessed(static_cast<int64_t>(st.iterations()) * static_cast<int64_t>(gcode.size()));
+}
+
+BENCHMARK_REGISTER_F(BinaryGCodeFixture, bgcode_encode)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(BinaryGCodeFixture, bgcode_decode)(benchmark::State& st)
+{
+    std::ostringstream file;
+    {
+        BinaryGCodeEncoder encoder(file);
+        std::ostream stream(&encoder);
+        stream << gcode;
+        stream.flush();
+    }
+    const std::string encoded = file.str();
+    for (auto _ : st)
+    {
+        benchmark::DoNotOptimize(bgcode::decode(encoded));
+    }
+    st.SetBytesProcessed(static_cast<int64_t>(st.iterations()) * static_cast<int64_t>(gcode.size()));
+}
+
+BENCHMARK_REGISTER_F(BinaryGCodeFixture, bgcode_decode)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+} // namespace cura
+#endif // CURAENGINE_BENCHMARK_BGCODE_BENCHMARK_H
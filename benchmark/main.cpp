@@ -1,6 +1,7 @@
 
 // Copyright (c) 2023 UltiMaker
 // CuraEngine is released under the terms of the AGPLv3 or higher
+#include "bgcode_benchmark.h"
 #include "infill_benchmark.h"
 #include "wall_benchmark.h"
 #include "simplify_benchmark.h"
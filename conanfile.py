@@ -28,6 +28,7 @@ class CuraEngineConan(ConanFile):
     options = {
         "enable_arcus": [True, False],
         "enable_benchmarks": [True, False],
+        "enable_clipper2": [True, False],
         "enable_extensive_warnings": [True, False],
         "enable_plugins": [True, False],
         "enable_sentry": [True, False],
@@ -37,6 +38,7 @@ class CuraEngineConan(ConanFile):
     default_options = {
         "enable_arcus": True,
         "enable_benchmarks": False,
+        "enable_clipper2": False,
         "enable_extensive_warnings": False,
         "enable_plugins": True,
         "enable_sentry": False,
@@ -124,6 +126,8 @@ class CuraEngineConan(ConanFile):
         if self.options.enable_arcus or self.options.enable_plugins:
             self.requires("protobuf/3.21.12")
         self.requires("clipper/6.4.2@ultimaker/stable")
+        if self.options.enable_clipper2:
+            self.requires("clipper2/1.3.0")
         self.requires("boost/1.82.0")
         self.requires("rapidjson/cci.20230929")
         self.requires("stb/20200203")
@@ -143,6 +147,7 @@ class CuraEngineConan(ConanFile):
         tc.variables["ENABLE_ARCUS"] = self.options.enable_arcus
         tc.variables["ENABLE_TESTING"] = not self.conf.get("tools.build:skip_test", False, check_type=bool)
         tc.variables["ENABLE_BENCHMARKS"] = self.options.enable_benchmarks
+        tc.variables["ENABLE_CLIPPER2"] = self.options.enable_clipper2
         tc.variables["EXTENSIVE_WARNINGS"] = self.options.enable_extensive_warnings
         tc.variables["OLDER_APPLE_CLANG"] = self.settings.compiler == "apple-clang" and Version(self.settings.compiler.version) < "14"
         tc.variables["ENABLE_THREADING"] = not (self.settings.arch == "wasm" and self.settings.os == "Emscripten")
@@ -4,14 +4,16 @@
 #ifndef GCODE_WRITER_H
 #define GCODE_WRITER_H
 
-#include <fstream>
 #include <optional>
+#include <ostream>
+#include <string>
 
 #include "ExtruderUse.h"
 #include "FanSpeedLayerTime.h"
 #include "GCodePathConfig.h"
 #include "LayerPlanBuffer.h"
 #include "gcodeExport.h"
+#include "utils/AsyncFileStreamBuffer.h"
 #include "utils/LayerVector.h"
 #include "utils/NoCopy.h"
 #include "utils/gettime.h"
@@ -52,16 +54,29 @@ private:
     LayerPlanBuffer layer_plan_buffer;
 
     /*!
-     * The class holding the current state of the gcode being written.
+     * The gcode file to write to when using CuraEngine as command line tool.
      *
-     * It holds information such as the last written position etc.
+     * The file itself is written by a separate thread, so that slow storage doesn't hold up the g-code generation.
      */
-    GCodeExport gcode;
+    AsyncFileStreamBuffer output_file_buffer;
 
     /*!
-     * The gcode file to write to when using CuraEngine as command line tool.
+     * The name of the file that \ref output_file_buffer writes to, if any.
+     */
+    std::string output_file_name;
+
+    /*!
+     * Stream on top of \ref output_file_buffer.
      */
-    std::ofstream output_file;
+    std::ostream output_file{ &output_file_buffer };
+
+    /*!
+     * The class holding the current state of the gcode being written.
+     *
+     * It holds information such as the last written position etc.
+     * It is declared after the output streams, so that it is destroyed before them and can't write into them once they're gone.
+     */
+    GCodeExport gcode;
 
     //!< For each layer, the extruders to be used in that layer in the order in which they are going to be used
     LayerVector<std::vector<ExtruderUse>> extruder_order_per_layer;
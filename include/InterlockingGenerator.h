@@ -5,11 +5,11 @@
 #define INTERLOCKING_GENERATOR_H
 
 #include <cassert>
-#include <unordered_set>
 #include <vector>
 
 #include "geometry/PointMatrix.h"
 #include "geometry/Polygon.h"
+#include "utils/VoxelGrid.h"
 #include "utils/VoxelUtils.h"
 
 namespace cura
@@ -114,16 +114,17 @@ protected:
      * Expand the meshes into each other where they need it, namely when a thin strip of material needs to be attached.
      * \param has_all_meshes Only do this special handling if there's actually microstructure nearby that needs to be adhered to.
      */
-    void handleThinAreas(const std::unordered_set<GridPoint3>& has_all_meshes) const;
+    void handleThinAreas(const VoxelGrid& has_all_meshes) const;
 
     /*!
      * Compute the voxels overlapping with the shell of both models.
      * This includes the walls, but also top/bottom skin.
      *
      * \param kernel The dilation kernel to give the returned voxel shell more thickness
+     * \param empty_grid An empty voxel grid covering both models, see \ref createEmptyGrid
      * \return The shell voxels for mesh a and those for mesh b
      */
-    std::vector<std::unordered_set<GridPoint3>> getShellVoxels(const DilationKernel& kernel) const;
+    std::vector<VoxelGrid> getShellVoxels(const DilationKernel& kernel, const VoxelGrid& empty_grid) const;
 
     /*!
      * Compute the voxels overlapping with the shell of some layers.
@@ -133,7 +134,7 @@ protected:
      * \param kernel The dilation kernel to give the returned voxel shell more thickness
      * \param[out] cells The output cells which elong to the shell
      */
-    void addBoundaryCells(const std::vector<Shape>& layers, const DilationKernel& kernel, std::unordered_set<GridPoint3>& cells) const;
+    void addBoundaryCells(const std::vector<Shape>& layers, const DilationKernel& kernel, VoxelGrid& cells) const;
 
     /*!
      * Compute the regions occupied by both models.
@@ -143,6 +144,14 @@ protected:
      */
     std::vector<Shape> computeUnionedVolumeRegions() const;
 
+    /*!
+     * Create an empty voxel grid which is large enough to hold all cells of both models, including their dilations.
+     *
+     * \param layer_regions The total volume of the two meshes combined, see \ref computeUnionedVolumeRegions
+     * \return The empty voxel grid
+     */
+    VoxelGrid createEmptyGrid(const std::vector<Shape>& layer_regions) const;
+
     /*!
      * Generate the polygons for the beams of a single cell
      * \return cell_area_per_mesh_per_layer The output polygons for each beam
@@ -155,7 +164,7 @@ protected:
      * \param cells The cells where we want to apply the interlocking structure.
      * \param layer_regions The total volume of the two meshes combined (and small gaps closed)
      */
-    void applyMicrostructureToOutlines(const std::unordered_set<GridPoint3>& cells, const std::vector<Shape>& layer_regions) const;
+    void applyMicrostructureToOutlines(const VoxelGrid& cells, const std::vector<Shape>& layer_regions) const;
 
     static const coord_t ignored_gap_ = 100u; //!< Distance between models to be considered next to each other so that an interlocking structure will be generated there
 
@@ -20,6 +20,7 @@
 #include "settings/PathConfigStorage.h"
 #include "settings/types/LayerIndex.h"
 #include "utils/ExtrusionJunction.h"
+#include "utils/ShapeInsideIndex.h"
 
 #ifdef BUILD_TESTS
 #include <gtest/gtest_prod.h> //Friend tests, so that they can inspect the privates.
@@ -97,7 +98,9 @@ private:
     Comb* comb_;
     coord_t comb_move_inside_distance_; //!< Whenever using the minimum boundary for combing it tries to move the coordinates inside by this distance after calculating the combing.
     Shape bridge_wall_mask_; //!< The regions of a layer part that are not supported, used for bridging
+    std::optional<ShapeInsideIndex> bridge_wall_mask_index_; //!< For testing whether points are inside \ref bridge_wall_mask_, set together with it
     Shape overhang_mask_; //!< The regions of a layer part where the walls overhang
+    std::optional<ShapeInsideIndex> overhang_mask_index_; //!< For testing whether points are inside \ref overhang_mask_, set together with it
     Shape seam_overhang_mask_; //!< The regions of a layer part where the walls overhang, specifically as defined for the seam
     Shape roofing_mask_; //!< The regions of a layer part where the walls are exposed to the air
 
@@ -185,6 +188,11 @@ public:
 
     LayerIndex getLayerNr() const;
 
+    /*!
+     * Get the (approximate) heap memory used by the planned paths and the boundaries of this layer, in bytes.
+     */
+    size_t memoryUsage() const;
+
     /*!
      * Get the last planned position, or if no position has been planned yet, the user specified layer start position.
      *
@@ -14,6 +14,7 @@
 #include "geometry/Shape.h"
 #include "settings/EnumSettings.h" //To store whether X/Y or Z distance gets priority.
 #include "settings/types/LayerIndex.h" //Part of the RadiusLayerPair.
+#include "utils/MemoryUsage.h"
 #include "utils/PairHash.h"
 #include "utils/Simplify.h"
 
@@ -149,6 +150,11 @@ public:
      */
     coord_t getRadiusNextCeil(coord_t radius, bool min_xy_dist) const;
 
+    /*!
+     * \brief Add the (approximate) heap memory used by the model outlines and the caches to a report.
+     */
+    void memoryUsage(MemoryReport& report) const;
+
 
 private:
     /*!
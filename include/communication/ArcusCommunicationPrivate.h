@@ -8,8 +8,12 @@
 #include "ArcusCommunication.h" //We're adding a subclass to this.
 #include "SliceDataStruct.h"
 #include "settings/types/LayerIndex.h"
+#include "utils/ChunkedStreamBuffer.h" //To collect the g-code in.
 
-#include <sstream> //For ostringstream.
+#include <condition_variable> //To wait for the socket to send g-code.
+#include <memory>
+#include <mutex>
+#include <ostream> //To write g-code to.
 
 namespace cura
 {
@@ -46,10 +50,44 @@ public:
      */
     void readMeshGroupMessage(const proto::ObjectList& mesh_group_message);
 
+    /*
+     * \brief Wait until there is room to send more g-code to the front-end.
+     *
+     * The socket sends its messages on a separate thread. If the front-end
+     * reads them slower than we produce g-code, this blocks until enough of
+     * the earlier g-code messages have been sent, so that at most
+     * max_gcode_bytes_in_flight bytes of g-code are waiting in the queue.
+     * \param bytes The size of the g-code that is about to be sent.
+     */
+    void waitForGCodeCapacity(const size_t bytes);
+
+    /*
+     * \brief Create a message to send g-code with, which is counted as in
+     * flight until the socket releases it.
+     * \param gcode The g-code to send.
+     */
+    std::shared_ptr<proto::GCodeLayer> createGCodeMessage(std::string&& gcode);
+
     Arcus::Socket* socket; //!< Socket to send data to.
     size_t object_count; //!< Number of objects that need to be sliced.
     std::string temp_gcode_file; //!< Temporary buffer for the g-code.
-    std::ostringstream gcode_output_stream; //!< The stream to write g-code to.
+    ChunkedStreamBuffer gcode_output_buffer; //!< The buffer in which the g-code is collected until it is flushed.
+    std::ostream gcode_output_stream; //!< The stream to write g-code to.
+
+    /*
+     * \brief The amount of g-code which the socket hasn't sent yet.
+     *
+     * This is shared with the g-code messages, which release their bytes when
+     * the socket is done with them, even if that's after we're destroyed.
+     */
+    struct GCodeInFlight
+    {
+        std::mutex mutex;
+        std::condition_variable sent; //!< Notified whenever a g-code message has been sent.
+        size_t bytes = 0;
+    };
+    std::shared_ptr<GCodeInFlight> gcode_in_flight;
+    static constexpr size_t max_gcode_bytes_in_flight = 64 * 1024 * 1024; //!< Maximum amount of g-code to queue before waiting for the front-end.
 
     SliceDataStruct<cura::proto::Layer> sliced_layers;
     SliceDataStruct<cura::proto::LayerOptimized> optimized_layers;
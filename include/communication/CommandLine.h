@@ -4,11 +4,14 @@
 #ifndef COMMANDLINE_H
 #define COMMANDLINE_H
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <rapidjson/document.h> //Loading JSON documents to get settings from them.
 #include <string> //To store the command line arguments.
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector> //To store the command line arguments.
 
 #include "Communication.h" //The class we're implementing.
@@ -16,6 +19,7 @@
 namespace cura
 {
 class Settings;
+struct DefinitionBundle;
 
 using setting_map = std::unordered_map<std::string, std::string>;
 using container_setting_map = std::unordered_map<std::string, setting_map>;
@@ -166,6 +170,22 @@ protected:
 private:
     std::vector<std::filesystem::path> search_directories_;
 
+    /*
+     * Hash of the contents of all definition files that were loaded so far, to version a compiled definition bundle.
+     */
+    uint64_t definitions_hash_ = 0;
+
+    /*
+     * All definition files that were loaded so far, in the order in which they were hashed into definitions_hash_.
+     */
+    std::vector<std::string> definition_files_;
+
+    /*
+     * The files that were given with -j so far, with the settings stack they were loaded into: 0 for the global stack, else 1 + the extruder
+     * number.
+     */
+    std::vector<std::pair<uint32_t, std::string>> given_definitions_;
+
     /*
      * The last progress update that we output to stdcerr.
      */
@@ -173,6 +193,8 @@ private:
 
     /*
      * \brief Load a JSON file and store the settings inside it.
+     *
+     * The file may also be a definition bundle compiled with --compile-definitions.
      * \param json_filename The location of the JSON file to load settings from.
      * \param settings The settings storage to store the settings in.
      * \param force_read_parent Also read-in values of non-leaf settings. (Off by default: Only leaf-settings should be used in the engine.)
@@ -183,6 +205,34 @@ private:
      */
     int loadJSON(const std::filesystem::path& json_filename, Settings& settings, bool force_read_parent = false, bool force_read_nondefault = false);
 
+    /*
+     * \brief Load a compiled definition bundle and store the settings inside it.
+     * \param bundle_data The contents of the bundle file.
+     * \param settings The settings storage to store the global settings of the bundle in. The extruder settings go to the extruders of the
+     * scene.
+     *
+     * If the definition files that the bundle was compiled from changed since, the definition files are loaded instead.
+     * \return Error code. If it's 0, the bundle was successfully loaded. If it's 2, the bundle is corrupt or of an unsupported version.
+     */
+    int loadDefinitionBundle(const std::string_view bundle_data, Settings& settings);
+
+    /*
+     * \brief Load the definition files that a bundle was compiled from, as they were given with -j when compiling it.
+     *
+     * Settings that were given with -s when compiling the bundle are not part of those files, so they are not restored.
+     * \param bundle The bundle to load the definition files of.
+     * \param settings The settings storage to load the global definitions into. Extruder definitions go to the extruders of the scene.
+     * \return Error code, as for \ref loadJSON.
+     */
+    int loadDefinitionBundleSources(const DefinitionBundle& bundle, Settings& settings);
+
+    /*
+     * \brief Write the settings of the scene and its extruders, as loaded so far, to a definition bundle.
+     * \param bundle_filename The file to write the bundle to.
+     * \return Whether the bundle was written successfully.
+     */
+    bool writeDefinitionBundle(const std::filesystem::path& bundle_filename) const;
+
     /*
      * \brief Load a JSON document and store the settings inside it.
      * \param document The JSON document to load the settings from.
@@ -4,10 +4,13 @@
 #ifndef GCODEEXPORT_H
 #define GCODEEXPORT_H
 
+#include <atomic>
 #include <deque> // for extrusionAmountAtPreviousRetractions
+#include <future>
 #ifdef BUILD_TESTS
 #include <gtest/gtest_prod.h> //To allow tests to use protected members.
 #endif
+#include <memory>
 #include <optional>
 #include <sstream> // for stream.str()
 #include <stdio.h>
@@ -20,6 +23,7 @@
 #include "settings/types/Velocity.h"
 #include "timeEstimate.h"
 #include "utils/AABB3D.h" //To track the used build volume for the Griffin header.
+#include "utils/BinaryGCode.h"
 #include "utils/NoCopy.h"
 
 namespace cura
@@ -43,6 +47,7 @@ class GCodeExport : public NoCopy
     FRIEND_TEST(GCodeExportTest, CommentTimeZero);
     FRIEND_TEST(GCodeExportTest, CommentTimeInteger);
     FRIEND_TEST(GCodeExportTest, CommentTimeFloatRoundingError);
+    FRIEND_TEST(GCodeExportTest, CommentTimeAfterLayer);
     FRIEND_TEST(GCodeExportTest, CommentTypeAllTypesCovered);
     FRIEND_TEST(GCodeExportTest, CommentLayer);
     FRIEND_TEST(GCodeExportTest, CommentLayerNegative);
@@ -119,6 +124,9 @@ private:
     std::string slice_uuid_; //!< The UUID of the current slice.
 
     std::ostream* output_stream_;
+    std::ostream* binary_target_stream_ = nullptr; //!< The stream that \ref binary_encoder_ writes the encoded g-code to
+    std::unique_ptr<BinaryGCodeEncoder> binary_encoder_; //!< Encodes the g-code as binary g-code when writing to a file, if the printer accepts that
+    std::unique_ptr<std::ostream> binary_stream_; //!< Stream on top of \ref binary_encoder_
     std::string new_line_;
 
     double current_e_value_; //!< The last E value written to gcode (in mm or mm^3)
@@ -155,8 +163,28 @@ private:
     size_t fans_count_{ 0 };
     EGCodeFlavor flavor_;
 
+    /*!
+     * The print time estimate of a layer. It's calculated by a worker of the thread pool while the next layer is written, or by the writer
+     * thread if that needs the result before a worker got to it.
+     */
+    struct PrintTimeEstimateJob
+    {
+        std::packaged_task<std::vector<Duration>()> task;
+        std::future<std::vector<Duration>> result;
+        std::atomic<bool> started{ false };
+
+        void run()
+        {
+            if (! started.exchange(true))
+            {
+                task();
+            }
+        }
+    };
+
     std::vector<Duration> total_print_times_; //!< The total estimated print time in seconds for each feature
     TimeEstimateCalculator estimate_calculator_;
+    std::shared_ptr<PrintTimeEstimateJob> pending_print_time_estimate_; //!< The estimate of the last layer, if it isn't added to the totals yet
 
     LayerIndex layer_nr_; //!< for sending travel data
 
@@ -301,7 +329,21 @@ public:
      * \return total print time in seconds for the complete print
      */
     double getSumTotalPrintTimes();
+
+    /*!
+     * Start estimating the print time of the moves written since the last estimate, in the background.
+     *
+     * The estimate is added to the totals, and its TIME_ELAPSED comment is written, by \ref writePendingPrintTime.
+     */
     void updateTotalPrintTime();
+
+    /*!
+     * Wait for the estimate started by \ref updateTotalPrintTime, add it to the totals and write its TIME_ELAPSED comment.
+     *
+     * This must be called before anything else is written after the moves that were estimated, so that the comment ends up in the same place as
+     * if the estimate was calculated right away. It does nothing if there is no pending estimate.
+     */
+    void writePendingPrintTime();
     void resetTotalPrintTimeAndFilament();
 
     void writeComment(const std::string& comment);
@@ -592,6 +634,11 @@ public:
      */
     void writeJerk(const Velocity& jerk);
 
+    /*!
+     * Whether the g-code is written as binary g-code, which is only done when writing to a file.
+     */
+    bool isBinaryGCodeSelected() const;
+
     /*!
      * Set member variables using the settings in \p settings.
      */
@@ -625,6 +672,15 @@ public:
      */
     void finalize(const char* endCode);
 
+    /*!
+     * Write the metadata and all binary g-code that is still buffered, and write plain g-code to the underlying stream again from now on.
+     *
+     * This has to be done after the very last g-code is written, since the binary g-code is encoded in blocks and the metadata precedes it.
+     *
+     * \param header The g-code header with the final print time and material usage, which is written as metadata.
+     */
+    void finishBinaryOutput(const std::string& header);
+
     /*!
      * Get amount of material extruded since last wipe script was inserted.
      *
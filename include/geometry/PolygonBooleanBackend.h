@@ -0,0 +1,82 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef GEOMETRY_POLYGON_BOOLEAN_BACKEND_H
+#define GEOMETRY_POLYGON_BOOLEAN_BACKEND_H
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <polyclipping/clipper.hpp>
+
+#include "utils/Coord_t.h"
+
+namespace cura
+{
+
+class Polygon;
+class Shape;
+class SingleShape;
+
+/*!
+ * The library that does the boolean operations and offsets of \ref Shape.
+ *
+ * Clipper 6 (ClipperLib) is always available, and it's the default. When built with ENABLE_CLIPPER2, Clipper2 is available too. Another
+ * backend can be chosen when starting the engine, by setting the environment variable CURAENGINE_POLYGON_BACKEND to the name of one.
+ *
+ * The parameters use the ClipperLib types, since those are what the rest of the engine uses. Other backends translate them. The polygons to
+ * operate on are passed as spans, so that both the polygons of a shape and a single polygon can be passed without copying them.
+ */
+class PolygonBooleanBackend
+{
+public:
+    virtual ~PolygonBooleanBackend() = default;
+
+    /*!
+     * The name to select this backend with, e.g. "clipper" or "clipper2".
+     */
+    [[nodiscard]] virtual std::string_view name() const = 0;
+
+    /*!
+     * Compute the union, difference, intersection or xor of two shapes.
+     * \param clip_type The operation to perform.
+     * \param subject The polygons of the shape to clip.
+     * \param clip_shape The polygons of the shape to clip with. For a union, it is filled together with the subject, as if they were one shape.
+     * \param fill_type The fill rule for both shapes.
+     * \return The polygons of the resulting shape, outlines counter-clockwise and holes clockwise.
+     */
+    [[nodiscard]] virtual Shape
+        clip(ClipperLib::ClipType clip_type, std::span<const Polygon> subject, std::span<const Polygon> clip_shape, ClipperLib::PolyFillType fill_type) const = 0;
+
+    /*!
+     * Offset polygons as they are, without resolving overlaps first.
+     * \param polygons The polygons to offset.
+     * \param distance The distance to offset with. Negative distances shrink the shape.
+     * \param join_type How to join the offset edges at convex corners.
+     * \param miter_limit The maximum distance of a mitered corner to the original vertex, relative to the offset distance.
+     */
+    [[nodiscard]] virtual Shape offset(std::span<const Polygon> polygons, coord_t distance, ClipperLib::JoinType join_type, double miter_limit) const = 0;
+
+    /*!
+     * Split a shape into parts, each with an outline followed by its holes.
+     * \param shape The shape to split.
+     * \param fill_type The fill rule that decides what is inside the shape.
+     */
+    [[nodiscard]] virtual std::vector<SingleShape> splitIntoParts(const Shape& shape, ClipperLib::PolyFillType fill_type) const = 0;
+
+    /*!
+     * Get the backend that all shapes use.
+     */
+    static const PolygonBooleanBackend& get();
+
+    /*!
+     * Find a backend by its name.
+     * \return The backend, or nullptr if it's unknown or wasn't built.
+     */
+    static const PolygonBooleanBackend* find(std::string_view name);
+};
+
+} // namespace cura
+
+#endif // GEOMETRY_POLYGON_BOOLEAN_BACKEND_H
@@ -4,6 +4,10 @@
 #ifndef GEOMETRY_SHAPE_H
 #define GEOMETRY_SHAPE_H
 
+#if defined(BUILD_TESTS) || defined(BUILD_BENCHMARKS)
+#include <atomic>
+#endif
+
 #include "geometry/LinesSet.h"
 #include "geometry/Polygon.h"
 #include "settings/types/Angle.h"
@@ -35,7 +39,11 @@ public:
     Shape() = default;
 
     /*! \brief Creates a copy of the given shape */
+#if defined(BUILD_TESTS) || defined(BUILD_BENCHMARKS)
+    Shape(const Shape& other);
+#else
     Shape(const Shape& other) = default;
+#endif
 
     /*! \brief Constructor that takes the inner polygons list from the given shape */
     Shape(Shape&& other) = default;
@@ -52,7 +60,11 @@ public:
      */
     explicit Shape(ClipperLib::Paths&& paths, bool explicitely_closed = clipper_explicitely_closed_);
 
+#if defined(BUILD_TESTS) || defined(BUILD_BENCHMARKS)
+    Shape& operator=(const Shape& other);
+#else
     Shape& operator=(const Shape& other) = default;
+#endif
 
     Shape& operator=(Shape&& other) noexcept = default;
 
@@ -67,7 +79,10 @@ public:
         LinesSet<Polygon>::emplace_back(std::forward<decltype(args)>(args)...);
     }
 
-    [[nodiscard]] Shape difference(const Shape& other) const;
+    [[nodiscard]] Shape difference(const Shape& other) const&;
+
+    /*! \brief Same as the above, but the polygons of this temporary shape are moved instead of copied if \p other is empty */
+    [[nodiscard]] Shape difference(const Shape& other) &&;
 
     [[nodiscard]] Shape difference(const Polygon& polygon) const;
 
@@ -87,7 +102,10 @@ public:
      *  @note The behavior of this method is exactly the same, but it just exists because it allows
      *        for a performance optimization
      */
-    [[nodiscard]] Shape offset(coord_t distance, ClipperLib::JoinType join_type = ClipperLib::jtMiter, double miter_limit = 1.2) const;
+    [[nodiscard]] Shape offset(coord_t distance, ClipperLib::JoinType join_type = ClipperLib::jtMiter, double miter_limit = 1.2) const&;
+
+    /*! \brief Same as the above, but the polygons of this temporary shape are moved instead of copied if \p distance is 0 */
+    [[nodiscard]] Shape offset(coord_t distance, ClipperLib::JoinType join_type = ClipperLib::jtMiter, double miter_limit = 1.2) &&;
 
     /*!
      * Intersect polylines with the area covered by the shape.
@@ -185,7 +203,10 @@ public:
      * Exclude holes and parts within holes.
      * \return the resulting polygons.
      */
-    [[nodiscard]] Shape getOutsidePolygons() const;
+    [[nodiscard]] Shape getOutsidePolygons() const&;
+
+    /*! \brief Same as the above, but the polygon of this temporary shape is moved instead of copied if it is the only one */
+    [[nodiscard]] Shape getOutsidePolygons() &&;
 
     /*!
      * Split up the polygons into groups according to the even-odd rule.
@@ -256,6 +277,14 @@ public:
      */
     void simplify(ClipperLib::PolyFillType fill_type = ClipperLib::pftEvenOdd);
 
+#if defined(BUILD_TESTS) || defined(BUILD_BENCHMARKS)
+    /*!
+     * Get the number of non-empty shapes that were copied since the program started, to measure how much geometry is duplicated.
+     * \note Only counted in builds with tests or benchmarks, so that the copies in release builds don't pay for it.
+     */
+    static size_t getCopyCount();
+#endif
+
 #ifdef BUILD_TESTS
     /*!
      * @brief Import the polygon from a WKT string
@@ -272,6 +301,10 @@ public:
 #endif
 
 private:
+#if defined(BUILD_TESTS) || defined(BUILD_BENCHMARKS)
+    static std::atomic<size_t> copy_count_;
+#endif
+
     /*!
      * recursive part of \ref Polygons::removeEmptyHoles and \ref Polygons::getEmptyHoles
      * \param node The node of the polygons part to process
@@ -279,7 +312,6 @@ private:
      * \param ret Where to store polygons which are not empty holes
      */
     void removeEmptyHolesProcessPolyTreeNode(const ClipperLib::PolyNode& node, const bool remove_holes, Shape& ret) const;
-    void splitIntoPartsProcessPolyTreeNode(ClipperLib::PolyNode* node, std::vector<SingleShape>& ret) const;
     void sortByNestingProcessPolyTreeNode(ClipperLib::PolyNode* node, const size_t nesting_idx, std::vector<Shape>& ret) const;
     void splitIntoPartsViewProcessPolyTreeNode(PartsView& parts_view, Shape& reordered, ClipperLib::PolyNode* node) const;
 };
@@ -210,7 +210,7 @@ public:
         int layer_idx,
         SectionType section_type,
         const std::shared_ptr<SierpinskiFillProvider>& cross_fill_provider = nullptr,
-        const std::shared_ptr<LightningLayer>& lightning_layer = nullptr,
+        const std::shared_ptr<const LightningLayer>& lightning_layer = nullptr,
         const SliceMeshStorage* mesh = nullptr,
         const Shape& prevent_small_exposed_to_air = Shape());
 
@@ -234,6 +234,11 @@ public:
         int layer_idx,
         SectionType section_type);
 
+    /*!
+     * Forget the results of the infill generate plugin that are kept for areas that repeat, so that a new slice doesn't reuse them.
+     */
+    static void clearPluginResults();
+
 private:
     struct InfillLineSegment
     {
@@ -377,7 +382,7 @@ private:
         OpenLinesSet& result_lines,
         const Settings& settings,
         const std::shared_ptr<SierpinskiFillProvider>& cross_fill_pattern = nullptr,
-        const std::shared_ptr<LightningLayer>& lightning_layer = nullptr,
+        const std::shared_ptr<const LightningLayer>& lightning_layer = nullptr,
         const SliceMeshStorage* mesh = nullptr);
 
     /*!
@@ -405,7 +410,7 @@ private:
      * see https://hal.archives-ouvertes.fr/hal-02155929/document
      * \param result (output) The resulting polygons
      */
-    void generateLightningInfill(const std::shared_ptr<LightningLayer>& lightning_layer, OpenLinesSet& result_lines);
+    void generateLightningInfill(const std::shared_ptr<const LightningLayer>& lightning_layer, OpenLinesSet& result_lines);
 
     /*!
      * Generate sparse concentric infill
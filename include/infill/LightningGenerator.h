@@ -57,6 +57,12 @@ public:
     const LightningLayer& getTreesForLayer(const size_t& layer_id) const;
 
 protected:
+    /*!
+     * Calculate the areas the trees have to stay within on each layer, which
+     * is the infill area of the mesh minus the infill walls.
+     */
+    std::vector<Shape> generateInfillOutlines(const SliceMeshStorage& mesh) const;
+
     /*!
      * Calculate the overhangs above the infill areas that need to be supported
      * by infill.
@@ -64,13 +70,15 @@ protected:
      * Normally, overhangs are only generated for the outside of the model and
      * only when support is generated. For this pattern, we also need to
      * generate overhang areas for the inside of the model.
+     * \param infill_outlines The areas to fill on each layer, see \ref generateInfillOutlines.
      */
-    void generateInitialInternalOverhangs(const SliceMeshStorage& mesh);
+    void generateInitialInternalOverhangs(const std::vector<Shape>& infill_outlines);
 
     /*!
      * Calculate the tree structure of all layers.
+     * \param infill_outlines The areas to fill on each layer, see \ref generateInfillOutlines.
      */
-    void generateTrees(const SliceMeshStorage& mesh);
+    void generateTrees(const std::vector<Shape>& infill_outlines);
 
     /*!
      * How far each piece of infill can support skin in the layer above.
@@ -4,9 +4,6 @@
 #ifndef LIGHTNING_LAYER_H
 #define LIGHTNING_LAYER_H
 
-#include <list>
-#include <memory>
-#include <unordered_map>
 #include <vector>
 
 #include "geometry/LinesSet.h"
@@ -17,14 +14,13 @@
 
 namespace cura
 {
-using LightningTreeNodeSPtr = std::shared_ptr<LightningTreeNode>;
-using SparseLightningTreeNodeGrid = SparsePointGridInclusive<std::weak_ptr<LightningTreeNode>>;
+using SparseLightningTreeNodeGrid = SparsePointGridInclusive<LightningNodeIdx>;
 
 struct GroundingLocation
 {
-    LightningTreeNodeSPtr tree_node; //!< not null if the gounding location is on a tree
+    LightningNodeIdx tree_node; //!< not \ref no_lightning_node if the gounding location is on a tree
     std::optional<ClosestPointPolygon> boundary_location; //!< in case the gounding location is on the boundary
-    Point2LL p() const;
+    Point2LL p(const LightningTreeForest& forest) const;
 };
 
 /*!
@@ -35,7 +31,8 @@ struct GroundingLocation
 class LightningLayer
 {
 public:
-    std::vector<LightningTreeNodeSPtr> tree_roots;
+    LightningTreeForest forest; //!< Storage of all the nodes of the trees on this layer.
+    std::vector<LightningNodeIdx> tree_roots;
 
     void generateNewTrees(
         const Shape& current_overhang,
@@ -54,17 +51,17 @@ public:
         const coord_t supporting_radius,
         const coord_t wall_supporting_radius,
         const SparseLightningTreeNodeGrid& tree_node_locator,
-        const LightningTreeNodeSPtr& exclude_tree = nullptr);
+        const LightningNodeIdx exclude_tree = no_lightning_node);
 
     /*!
      * \param[out] new_child The new child node introduced
      * \param[out] new_root The new root node if one had been made
      * \return Whether a new root was added
      */
-    bool attach(const Point2LL& unsupported_location, const GroundingLocation& ground, LightningTreeNodeSPtr& new_child, LightningTreeNodeSPtr& new_root);
+    bool attach(const Point2LL& unsupported_location, const GroundingLocation& ground, LightningNodeIdx& new_child, LightningNodeIdx& new_root);
 
     void reconnectRoots(
-        std::vector<LightningTreeNodeSPtr>& to_be_reconnected_tree_roots,
+        const std::vector<LightningNodeIdx>& to_be_reconnected_tree_roots,
         const Shape& current_outlines,
         const LocToLineGrid& outline_locator,
         const coord_t supporting_radius,
@@ -74,7 +71,7 @@ public:
 
     coord_t getWeightedDistance(const Point2LL& boundary_loc, const Point2LL& unsupported_location);
 
-    void fillLocator(SparseLightningTreeNodeGrid& tree_node_locator);
+    void fillLocator(SparseLightningTreeNodeGrid& tree_node_locator) const;
 };
 } // namespace cura
 
@@ -4,8 +4,8 @@
 #ifndef LIGHTNING_TREE_NODE_H
 #define LIGHTNING_TREE_NODE_H
 
-#include <functional>
-#include <memory>
+#include <cassert>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -20,6 +20,16 @@ namespace cura
 
 constexpr coord_t locator_cell_size = 4000;
 
+/*!
+ * Index of a node within the \ref LightningTreeForest of a single layer.
+ */
+using LightningNodeIdx = int;
+
+/*!
+ * Index value used to indicate the absence of a node (no parent, no child, no sibling).
+ */
+constexpr LightningNodeIdx no_lightning_node = -1;
+
 // NOTE: As written, this struct will only be valid for a single layer, will have to be updated for the next.
 // NOTE: Reasons for implementing this with some separate closures:
 //       - keep clear deliniation during development
@@ -31,64 +41,122 @@ constexpr coord_t locator_cell_size = 4000;
  *
  * In essence these vertices are just a position linked to other positions in
  * 2D. The nodes have a hierarchical structure of parents and children, forming
- * a tree. The class also has some helper functions specific to Lightning Infill
- * e.g. to straighten the paths around this node.
+ * a tree. The links are indices into the node array of the
+ * \ref LightningTreeForest the node lives in, so the node itself is plain data.
+ *
+ * The children of a node form a doubly linked list through the sibling links,
+ * so that children can be added, removed and replaced without any allocation
+ * while keeping their order.
  */
-class LightningTreeNode : public std::enable_shared_from_this<LightningTreeNode>
+struct LightningTreeNode
 {
-    using LightningTreeNodeSPtr = std::shared_ptr<LightningTreeNode>;
+    Point2LL p; //!< The position on this layer that this node represents, a vertex of the path to print.
+    std::optional<Point2LL> last_grounding_location; //<! The last known grounding location, see \ref LightningTreeForest::getLastGroundingLocation.
 
-public:
-    // Workaround for private/protected constructors and 'make_shared': https://stackoverflow.com/a/27832765
-    template<typename... Arg>
-    LightningTreeNodeSPtr static create(Arg&&... arg)
+    LightningNodeIdx parent = no_lightning_node;
+    LightningNodeIdx first_child = no_lightning_node;
+    LightningNodeIdx last_child = no_lightning_node;
+    LightningNodeIdx prev_sibling = no_lightning_node;
+    LightningNodeIdx next_sibling = no_lightning_node;
+    uint32_t child_count = 0;
+
+    /*!
+     * Returns whether this node is the root of a lightning tree. It is the root
+     * if it has no parents.
+     */
+    bool isRoot() const
     {
-        struct EnableMakeShared : public LightningTreeNode
-        {
-            EnableMakeShared(Arg&&... arg)
-                : LightningTreeNode(std::forward<Arg>(arg)...)
-            {
-            }
-        };
-        return std::make_shared<EnableMakeShared>(std::forward<Arg>(arg)...);
+        return parent == no_lightning_node;
     }
+};
+
+/*!
+ * All the Lightning Trees of a single layer, stored as one flat array of nodes.
+ *
+ * Nodes are only ever appended to the forest. Nodes that are pruned away or
+ * straightened out of a tree stay behind in the array as unreachable garbage;
+ * they are dropped when the trees are copied to the next layer by
+ * \ref propagateToNextLayer, which only copies the nodes still reachable from
+ * the root, in depth order.
+ *
+ * Node indices are stable, but references to nodes are invalidated by anything
+ * that adds a node to the forest.
+ */
+class LightningTreeForest
+{
+public:
+    /*!
+     * Reserve space for a number of nodes, to prevent reallocations.
+     */
+    void reserve(const size_t node_count);
 
     /*!
-     * Get the position on this layer that this node represents, a vertex of the
+     * The number of nodes in the forest, including unreachable ones.
+     */
+    size_t size() const;
+
+    /*!
+     * Construct a new root node.
+     * \param p The physical location in the 2D layer that this node represents.
+     * Connecting other nodes to this node indicates that a line segment should
+     * be drawn between those two physical positions.
+     * \param last_grounding_location See \ref getLastGroundingLocation.
+     * \return The index of the new node.
+     */
+    LightningNodeIdx createNode(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location = std::nullopt);
+
+    /*!
+     * Get the position on this layer that a node represents, a vertex of the
      * path to print.
+     * \param node The node to get the location of.
      * \return The position that this node represents.
      */
-    const Point2LL& getLocation() const;
+    const Point2LL& getLocation(const LightningNodeIdx node) const;
 
     /*!
-     * Change the position on this layer that the node represents.
+     * Change the position on this layer that a node represents.
+     * \param node The node to move.
      * \param p The position that the node needs to represent.
      */
-    void setLocation(const Point2LL& p);
+    void setLocation(const LightningNodeIdx node, const Point2LL& p);
 
     /*!
-     * Construct a new ``LightningTreeNode`` instance and add it as a child of
-     * this node.
+     * Returns whether a node is the root of a lightning tree.
+     */
+    bool isRoot(const LightningNodeIdx node) const;
+
+    /*! If a node was ever a direct child of the root, it'll have a previous grounding location.
+     *
+     * This needs to be known when roots are reconnected, so that the last (higher) layer is supported by the next one.
+     */
+    const std::optional<Point2LL>& getLastGroundingLocation(const LightningNodeIdx node) const;
+
+    /*!
+     * Construct a new node and add it as a child of \p parent.
+     * \param parent The node to add the child to.
      * \param p The location of the new node.
-     * \return A shared pointer to the new node.
+     * \return The index of the new node.
      */
-    LightningTreeNodeSPtr addChild(const Point2LL& p);
+    LightningNodeIdx addChild(const LightningNodeIdx parent, const Point2LL& p);
 
     /*!
-     * Add an existing ``LightningTreeNode`` as a child of this node.
+     * Add an existing root node as a child of \p parent.
+     * \param parent The node to add the child to.
      * \param new_child The node that must be added as a child.
      * \return Always returns \p new_child.
      */
-    LightningTreeNodeSPtr addChild(LightningTreeNodeSPtr& new_child);
+    LightningNodeIdx addChild(const LightningNodeIdx parent, const LightningNodeIdx new_child);
 
     /*!
-     * Propagate this node's sub-tree to the next layer.
+     * Propagate a tree to the next layer.
      *
-     * Creates a copy of this tree, realign it to the new layer boundaries
-     * \p next_outlines and reduce (i.e. prune and straighten) it. A copy of
-     * this node and all of its descendant nodes will be added to the
-     * \p next_trees vector.
-     * \param next_trees A collection of tree nodes to use for the next layer.
+     * Copies the reachable part of the tree into the forest of the next layer,
+     * realigns it to the new layer boundaries \p next_outlines and reduces
+     * (i.e. prunes and straightens) it. The roots of the resulting trees will
+     * be added to the \p next_trees vector.
+     * \param root The root of the tree to propagate.
+     * \param next_forest The forest of the next layer.
+     * \param next_trees The tree roots of the next layer.
      * \param next_outlines The shape of the layer below, to make sure that the
      * tree stays within the bounds of the infill area.
      * \param prune_distance The maximum distance that a leaf node may be moved
@@ -100,7 +168,9 @@ public:
      * from which straightening may remove a colinear point.
      */
     void propagateToNextLayer(
-        std::vector<LightningTreeNodeSPtr>& next_trees,
+        const LightningNodeIdx root,
+        LightningTreeForest& next_forest,
+        std::vector<LightningNodeIdx>& next_trees,
         const Shape& next_outlines,
         const LocToLineGrid& outline_locator,
         const coord_t prune_distance,
@@ -108,108 +178,139 @@ public:
         const coord_t max_remove_colinear_dist) const;
 
     /*!
-     * Executes a given function for every line segment in this node's sub-tree.
+     * Executes a given function for every line segment in a node's sub-tree.
      *
      * The function takes two `Point` arguments. These arguments will be filled
      * in with the higher-order node (closer to the root) first, and the
      * downtree node (closer to the leaves) as the second argument. The segment
-     * from this node's parent to this node itself is not included.
+     * from the node's parent to the node itself is not included.
      * The order in which the segments are visited is depth-first.
+     * \param node The root of the sub-tree to visit.
      * \param visitor A function to execute for every branch in the node's sub-
      * tree.
      */
-    void visitBranches(const std::function<void(const Point2LL&, const Point2LL&)>& visitor) const;
+    template<typename F>
+    void visitBranches(const LightningNodeIdx node, F&& visitor) const
+    {
+        for (LightningNodeIdx child = nodes_[node].first_child; child != no_lightning_node; child = nodes_[child].next_sibling)
+        {
+            assert(nodes_[child].parent == node);
+            visitor(nodes_[node].p, nodes_[child].p);
+            visitBranches(child, visitor);
+        }
+    }
 
     /*!
-     * Execute a given function for every node in this node's sub-tree.
+     * Execute a given function for every node in a node's sub-tree.
      *
-     * The visitor function takes a node as input. This node is not const, so
-     * this can be used to change the tree.
-     * Nodes are visited in depth-first order. This node itself is visited as
+     * The visitor function takes a node index as input.
+     * Nodes are visited in depth-first order. The node itself is visited as
      * well (pre-order).
-     * \param visitor A function to execute for every node in this node's sub-
-     * tree.
+     * \param node The root of the sub-tree to visit.
+     * \param visitor A function to execute for every node in the sub-tree.
      */
-    void visitNodes(const std::function<void(LightningTreeNodeSPtr)>& visitor);
+    template<typename F>
+    void visitNodes(const LightningNodeIdx node, F&& visitor) const
+    {
+        visitor(node);
+        for (LightningNodeIdx child = nodes_[node].first_child; child != no_lightning_node; child = nodes_[child].next_sibling)
+        {
+            assert(nodes_[child].parent == node);
+            visitNodes(child, visitor);
+        }
+    }
 
     /*!
-     * Get a weighted distance from an unsupported point to this node (given the current supporting radius).
+     * Get a weighted distance from an unsupported point to a node (given the current supporting radius).
      *
      * When attaching a unsupported location to a node, not all nodes have the same priority.
      * (Eucludian) closer nodes are prioritised, but that's not the whole story.
      * For instance, we give some nodes a 'valence boost' depending on the nr. of branches.
+     * \param node The node to compute the distance to.
      * \param unsupported_location The (unsuppported) location of which the weighted distance needs to be calculated.
      * \param supporting_radius The maximum distance which can be bridged without (infill) supporting it.
      * \return The weighted distance.
      */
-    coord_t getWeightedDistance(const Point2LL& unsupported_location, const coord_t& supporting_radius) const;
-
-    /*!
-     * Returns whether this node is the root of a lightning tree. It is the root
-     * if it has no parents.
-     * \return ``true`` if this node is the root (no parents) or ``false`` if it
-     * is a child node of some other node.
-     */
-    bool isRoot() const
-    {
-        return is_root_;
-    }
+    coord_t getWeightedDistance(const LightningNodeIdx node, const Point2LL& unsupported_location, const coord_t& supporting_radius) const;
 
     /*!
-     * Reverse the parent-child relationship all the way to the root, from this node onward.
-     * This has the effect of 're-rooting' the tree at the current node if no immediate parent is given as argument.
-     * That is, the current node will become the root, it's (former) parent if any, will become one of it's children.
+     * Reverse the parent-child relationship all the way to the root, from a node onward.
+     * This has the effect of 're-rooting' the tree at the node if no immediate parent is given as argument.
+     * That is, the node will become the root, it's (former) parent if any, will become one of it's children.
      * This is then recursively bubbled up until it reaches the (former) root, which then will become a leaf.
-     * \param new_parent The (new) parent-node of the root, useful for recursing or immediately attaching the node to another tree.
+     * \param node The node to become the new root.
+     * \param new_parent The (new) parent-node of the root, used for recursing. The caller is responsible for
+     * linking \p node into the children of \p new_parent.
      */
-    void reroot(LightningTreeNodeSPtr new_parent = nullptr);
+    void reroot(const LightningNodeIdx node, const LightningNodeIdx new_parent = no_lightning_node);
 
     /*!
      * Retrieves the closest node to the specified location.
+     * \param node The root of the sub-tree to search.
      * \param loc The specified location.
      * \result The branch that starts at the position closest to the location within this tree.
      */
-    LightningTreeNodeSPtr closestNode(const Point2LL& loc);
+    LightningNodeIdx closestNode(const LightningNodeIdx node, const Point2LL& loc) const;
 
     /*!
-     * Returns whether the given tree node is a descendant of this node.
+     * Returns whether the given tree node is a descendant of a node.
      *
-     * If this node itself is given, it is also considered to be a descendant.
+     * If the node itself is given, it is also considered to be a descendant.
+     * \param node The root of the sub-tree to search.
      * \param to_be_checked A node to find out whether it is a descendant of
-     * this node.
-     * \return ``true`` if the given node is a descendant or this node itself,
+     * \p node.
+     * \return ``true`` if the given node is a descendant or \p node itself,
      * or ``false`` if it is not in the sub-tree.
      */
-    bool hasOffspring(const LightningTreeNodeSPtr& to_be_checked) const;
+    bool hasOffspring(const LightningNodeIdx node, const LightningNodeIdx to_be_checked) const;
+
+    /*!
+     * Convert a tree into polylines
+     *
+     * At each junction one line is chosen at random to continue
+     *
+     * The lines start at a leaf and end in a junction
+     *
+     * \param root The root of the tree to convert.
+     * \param output all branches in this tree connected into polylines
+     */
+    void convertToPolylines(const LightningNodeIdx root, OpenLinesSet& output, const coord_t line_width) const;
 
 protected:
-    LightningTreeNode() = delete; // Don't allow empty contruction
+    struct RectilinearJunction
+    {
+        coord_t total_recti_dist; //!< rectilinear distance along the tree from the last junction above to the junction below
+        Point2LL junction_loc; //!< junction location below
+    };
 
     /*!
-     * Construct a new node, either for insertion in a tree or as root.
-     * \param p The physical location in the 2D layer that this node represents.
-     * Connecting other nodes to this node indicates that a line segment should
-     * be drawn between those two physical positions.
+     * Copy the reachable nodes of a tree from another forest into this one.
+     * \param source The forest containing the tree to copy.
+     * \param source_root The root of the tree to copy.
+     * \return The root of the copy.
+     */
+    LightningNodeIdx copyTree(const LightningTreeForest& source, const LightningNodeIdx source_root);
+
+    /*!
+     * Append \p child to the end of the children of \p parent.
      */
-    LightningTreeNode(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location = std::nullopt);
+    void linkChild(const LightningNodeIdx parent, const LightningNodeIdx child);
 
     /*!
-     * Copy this node and its entire sub-tree.
-     * \return The equivalent of this node in the copy (the root of the new sub-
-     * tree).
+     * Remove \p child from the children of its parent, making it a root.
      */
-    LightningTreeNodeSPtr deepCopy() const;
+    void unlinkChild(const LightningNodeIdx child);
+
+    /*!
+     * Put \p replacement in the place of \p node among the children of the
+     * parent of \p node. \p node is left detached.
+     */
+    void replaceChild(const LightningNodeIdx node, const LightningNodeIdx replacement);
 
     /*! Reconnect trees from the layer above to the new outlines of the lower layer.
      * \return Wether or not the root is kept (false is no, true is yes).
      */
-    bool realign(const Shape& outlines, const LocToLineGrid& outline_locator, std::vector<LightningTreeNodeSPtr>& rerooted_parts);
-
-    struct RectilinearJunction
-    {
-        coord_t total_recti_dist; //!< rectilinear distance along the tree from the last junction above to the junction below
-        Point2LL junction_loc; //!< junction location below
-    };
+    bool realign(const LightningNodeIdx node, const Shape& outlines, const LocToLineGrid& outline_locator, std::vector<LightningNodeIdx>& rerooted_parts);
 
     /*!
      * Smoothen the tree to make it a bit more printable, while still supporting
@@ -217,7 +318,7 @@ protected:
      * \param magnitude The maximum allowed distance to move the node.
      * \param max_remove_colinear_dist Maximum distance of the (compound) line-segment from which a co-linear point may be removed.
      */
-    void straighten(const coord_t magnitude, const coord_t max_remove_colinear_dist);
+    void straighten(const LightningNodeIdx root, const coord_t magnitude, const coord_t max_remove_colinear_dist);
 
     /*! Recursive part of \ref straighten(.)
      * \param junction_above The last seen junction with multiple children above
@@ -225,32 +326,18 @@ protected:
      * \param max_remove_colinear_dist2 Maximum distance _squared_ of the (compound) line-segment from which a co-linear point may be removed.
      * \return the total distance along the tree from the last junction above to the first next junction below and the location of the next junction below
      */
-    RectilinearJunction straighten(const coord_t magnitude, const Point2LL& junction_above, const coord_t accumulated_dist, const coord_t max_remove_colinear_dist2);
+    RectilinearJunction straighten(
+        const LightningNodeIdx node,
+        const coord_t magnitude,
+        const Point2LL& junction_above,
+        const coord_t accumulated_dist,
+        const coord_t max_remove_colinear_dist2);
 
     /*! Prune the tree from the extremeties (leaf-nodes) until the pruning distance is reached.
      * \return The distance that has been pruned. If less than \p distance, then the whole tree was puned away.
      */
-    coord_t prune(const coord_t& distance);
+    coord_t prune(const LightningNodeIdx node, const coord_t& distance);
 
-public:
-    /*!
-     * Convert the tree into polylines
-     *
-     * At each junction one line is chosen at random to continue
-     *
-     * The lines start at a leaf and end in a junction
-     *
-     * \param output all branches in this tree connected into polylines
-     */
-    void convertToPolylines(OpenLinesSet& output, const coord_t line_width) const;
-
-    /*! If this was ever a direct child of the root, it'll have a previous grounding location.
-     *
-     * This needs to be known when roots are reconnected, so that the last (higher) layer is supported by the next one.
-     */
-    const std::optional<Point2LL>& getLastGroundingLocation() const;
-
-protected:
     /*!
      * Convert the tree into polylines
      *
@@ -261,16 +348,11 @@ protected:
      * \param long_line a reference to a polyline in \p output which to continue building on in the recursion
      * \param output all branches in this tree connected into polylines
      */
-    void convertToPolylines(size_t long_line_idx, OpenLinesSet& output) const;
-
-    void removeJunctionOverlap(OpenLinesSet& polylines, const coord_t line_width) const;
+    void convertToPolylines(const LightningNodeIdx node, size_t long_line_idx, OpenLinesSet& output) const;
 
-    bool is_root_;
-    Point2LL p_;
-    std::weak_ptr<LightningTreeNode> parent_;
-    std::vector<LightningTreeNodeSPtr> children_;
+    static void removeJunctionOverlap(OpenLinesSet& polylines, const coord_t line_width);
 
-    std::optional<Point2LL> last_grounding_location_; //<! The last known grounding location, see 'getLastGroundingLocation()'.
+    std::vector<LightningTreeNode> nodes_;
 };
 
 } // namespace cura
@@ -22,12 +22,11 @@ class SubDivCube
 {
 public:
     /*!
-     * Constructor for SubDivCube. Recursively calls itself eight times to flesh out the octree.
-     * \param mesh contains infill layer data and settings
-     * \param my_center the center of the cube
+     * Constructor for SubDivCube. The children of the cube are added by \ref precomputeOctree.
+     * \param center the center of the cube
      * \param depth the recursion depth of the cube (0 is most recursed)
      */
-    SubDivCube(SliceMeshStorage& mesh, Point3LL& center, size_t depth);
+    SubDivCube(const Point3LL& center, size_t depth);
 
     /*!
      * Precompute the octree of subdivided cubes
@@ -72,24 +71,38 @@ private:
      */
     static void rotatePointInitial(Point2LL& target);
 
+    /*!
+     * The infill areas of all layers of a mesh, prepared for fast distance queries. These are computed once before the octree is built.
+     */
+    struct MeshInfillAreas;
+
+    /*!
+     * Add the children of this cube that need to be subdivided.
+     * \param infill_areas the prepared infill areas of the mesh
+     * \param recursive whether to subdivide the children as well, all the way down
+     */
+    void subdivide(const MeshInfillAreas& infill_areas, const bool recursive);
+
     /*!
      * Determines if a described theoretical cube should be subdivided based on if a sphere that encloses the cube touches the infill mesh.
-     * \param mesh contains infill layer data and settings
+     * \param infill_areas the prepared infill areas of the mesh
      * \param center the center of the described cube
      * \param radius the radius of the enclosing sphere
      * \return the described cube should be subdivided
      */
-    static bool isValidSubdivision(SliceMeshStorage& mesh, Point3LL& center, coord_t radius);
+    static bool isValidSubdivision(const MeshInfillAreas& infill_areas, const Point3LL& center, coord_t radius);
 
     /*!
-     * Finds the distance to the infill border at the specified layer from the specified point.
-     * \param mesh contains infill layer data and settings
+     * Determines whether the specified point is inside the infill area at the specified layer, and whether it is within a distance of its border.
+     * \param infill_areas the prepared infill areas of the mesh
      * \param layer_nr the number of the specified layer
      * \param location the location of the specified point
-     * \param[out] distance2 the squared distance to the infill border
+     * \param max_distance2 the squared distance to the infill border to test for
+     * \param[out] is_close whether the infill border is closer than the square root of \p max_distance2. A layer without infill area has no
+     * border, so the point is never close to it.
      * \return Code 0: outside, 1: inside, 2: boundary does not exist at specified layer
      */
-    static coord_t distanceFromPointToMesh(SliceMeshStorage& mesh, const LayerIndex layer_nr, Point2LL& location, coord_t* distance2);
+    static int distanceFromPointToMesh(const MeshInfillAreas& infill_areas, const LayerIndex layer_nr, const Point2LL& location, const coord_t max_distance2, bool& is_close);
 
     /*!
      * Adds the defined line to the specified polygons. It assumes that the specified polygons are all parallel lines. Combines line segments with touching ends closer than
@@ -30,7 +30,8 @@ class SliceMeshStorage;
  * \param settings The settings to get the settings from (whether to union or
  * not).
  * \param storageLayer Where to store the parts.
- * \param layer The layer to split.
+ * \param layer The layer to split. Its polygons are released once the parts
+ * are made.
  */
 void createLayerWithParts(const Settings& settings, SliceLayer& storageLayer, SlicerLayer* layer);
 
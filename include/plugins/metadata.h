@@ -4,6 +4,8 @@
 #ifndef CURAENGINE_INCLUDE_PLUGINS_METADATA_H
 #define CURAENGINE_INCLUDE_PLUGINS_METADATA_H
 
+#include <atomic>
+#include <chrono>
 #include <grpcpp/client_context.h>
 #include <grpcpp/support/string_ref.h>
 #include <map>
@@ -34,6 +36,25 @@ struct slot_metadata
     std::string_view engine_uuid;
 };
 
+/**
+ * @brief The accumulated cost of the calls made to a plugin.
+ */
+struct call_statistics
+{
+    std::atomic<size_t> calls{ 0 };
+    std::atomic<int64_t> latency_us{ 0 }; ///< Sum of the round trip times of all calls, in microseconds
+    std::atomic<size_t> request_bytes{ 0 };
+    std::atomic<size_t> response_bytes{ 0 };
+
+    void record(const std::chrono::steady_clock::duration latency, const size_t request_size, const size_t response_size)
+    {
+        calls++;
+        latency_us += std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+        request_bytes += request_size;
+        response_bytes += response_size;
+    }
+};
+
 } // namespace cura::plugins
 
 namespace cura::plugins::v0
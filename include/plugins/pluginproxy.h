@@ -6,6 +6,9 @@
 
 #include <chrono>
 
+#ifdef BUILD_TESTS
+#include <gtest/gtest_prod.h> //To allow tests to use protected members.
+#endif
 #include <agrpc/asio_grpc.hpp>
 #include <agrpc/client_rpc.hpp>
 #include <agrpc/grpc_context.hpp>
@@ -41,6 +44,8 @@
 #include <optional>
 #include <string>
 #include <thread>
+#include <tuple>
+#include <vector>
 
 namespace cura::plugins
 {
@@ -72,6 +77,9 @@ class PluginProxy
 
     ranges::semiregular_box<invoke_stub_t> invoke_stub_; ///< The gRPC Invoke stub for communication.
     ranges::semiregular_box<broadcast_stub_t> broadcast_stub_; ///< The gRPC Broadcast stub for communication.
+#ifdef BUILD_TESTS
+    FRIEND_TEST(PluginProxyTest, ModifyBatch);
+#endif
 public:
     /**
      * @brief Constructs a PluginProxy object.
@@ -126,11 +134,7 @@ public:
             boost::asio::detached);
         grpc_context.run();
 
-        if (! status.ok()) // TODO: handle different kind of status codes
-        {
-            spdlog::error(status.error_message());
-            throw exceptions::RemoteException(slot_info_, status.error_message());
-        }
+        checkStatus(status);
         if (! plugin_info.plugin_name.empty() && ! plugin_info.slot_version_range.empty())
         {
             plugin_info_.emplace(plugin_info);
@@ -148,6 +152,7 @@ public:
             valid_ = other.valid_;
             plugin_info_ = other.plugin_info_;
             slot_info_ = other.slot_info_;
+            statistics_ = other.statistics_;
         }
         return *this;
     }
@@ -160,6 +165,7 @@ public:
             valid_ = std::move(other.valid_);
             plugin_info_ = std::move(other.plugin_info_);
             slot_info_ = std::move(other.slot_info_);
+            statistics_ = std::move(other.statistics_);
         }
         return *this;
     }
@@ -180,21 +186,7 @@ public:
             boost::asio::detached);
         grpc_context.run();
 
-        if (! status.ok()) // TODO: handle different kind of status codes
-        {
-            if (plugin_info_.has_value())
-            {
-                spdlog::error(
-                    "Plugin '{}' running at [{}] for slot {} failed with error: {}",
-                    plugin_info_.value().plugin_name,
-                    plugin_info_.value().peer,
-                    slot_info_.slot_id,
-                    status.error_message());
-                throw exceptions::RemoteException(slot_info_, plugin_info_.value(), status.error_message());
-            }
-            spdlog::error("Plugin for slot {} failed with error: {}", slot_info_.slot_id, status.error_message());
-            throw exceptions::RemoteException(slot_info_, status.error_message());
-        }
+        checkStatus(status);
         return ret_value;
     }
 
@@ -213,22 +205,85 @@ public:
             boost::asio::detached);
         grpc_context.run();
 
-        if (! status.ok()) // TODO: handle different kind of status codes
+        checkStatus(status);
+        return ret_value;
+    }
+
+    /**
+     * @brief Modifies a batch of values.
+     *
+     * All requests are sent before waiting for any of the responses, so the batch costs a single round trip instead of one per value.
+     *
+     * @param values The values to modify, which are replaced by the modified values.
+     * @param args_of Callable returning a tuple with the additional request arguments for the value at the given index.
+     */
+    void modifyBatch(auto& values, auto&& args_of)
+    {
+        agrpc::GrpcContext grpc_context;
+        std::vector<value_type> ret_values(values.size());
+        std::vector<grpc::Status> statuses(values.size());
+        std::vector<decltype(args_of(size_t(0)))> args; // Kept alive until all calls are done, since the calls refer to them.
+        args.reserve(values.size());
+        for (size_t value_idx = 0; value_idx < values.size(); value_idx++)
+        {
+            args.push_back(args_of(value_idx));
+        }
+
+        for (size_t value_idx = 0; value_idx < values.size(); value_idx++)
+        {
+            boost::asio::co_spawn(
+                grpc_context,
+                [this, &grpc_context, &statuses, &ret_values, &values, &args, value_idx]()
+                {
+                    return std::apply(
+                        [&](auto&... value_args)
+                        {
+                            return this->modifyCall(grpc_context, statuses[value_idx], ret_values[value_idx], values[value_idx], value_args...);
+                        },
+                        args[value_idx]);
+                },
+                boost::asio::detached);
+        }
+        grpc_context.run();
+
+        for (const grpc::Status& status : statuses)
         {
-            if (plugin_info_.has_value())
-            {
-                spdlog::error(
-                    "Plugin '{}' running at [{}] for slot {} failed with error: {}",
-                    plugin_info_.value().plugin_name,
-                    plugin_info_.value().peer,
-                    slot_info_.slot_id,
-                    status.error_message());
-                throw exceptions::RemoteException(slot_info_, plugin_info_.value(), status.error_message());
-            }
-            spdlog::error("Plugin for slot {} failed with error: {}", slot_info_.slot_id, status.error_message());
-            throw exceptions::RemoteException(slot_info_, status.error_message());
+            checkStatus(status);
         }
-        return ret_value;
+        for (size_t value_idx = 0; value_idx < values.size(); value_idx++)
+        {
+            values[value_idx] = std::move(ret_values[value_idx]);
+        }
+    }
+
+    const std::optional<plugin_metadata>& getPluginInfo() const
+    {
+        return plugin_info_;
+    }
+
+    /**
+     * @brief Logs the number of calls made to the plugin since the last time they were logged, and their latency and size.
+     *
+     * The statistics are reset, so that each mesh group logs only its own calls.
+     */
+    void logStatistics()
+    {
+        const size_t calls = statistics_->calls.exchange(0);
+        const int64_t latency_us = statistics_->latency_us.exchange(0);
+        const size_t request_bytes = statistics_->request_bytes.exchange(0);
+        const size_t response_bytes = statistics_->response_bytes.exchange(0);
+        if (calls == 0)
+        {
+            return;
+        }
+        spdlog::info(
+            "Plugin '{}' for slot {}: {} calls, {:.3f} ms average round trip, {} bytes sent, {} bytes received",
+            plugin_info_.has_value() ? plugin_info_.value().plugin_name : "",
+            slot_info_.slot_id,
+            calls,
+            static_cast<double>(latency_us) / 1000.0 / static_cast<double>(calls),
+            request_bytes,
+            response_bytes);
     }
 
     template<plugins::v0::SlotID Subscription>
@@ -250,24 +305,36 @@ public:
             boost::asio::detached);
         grpc_context.run();
 
-        if (! status.ok()) // TODO: handle different kind of status codes
+        checkStatus(status);
+    }
+
+private:
+    /**
+     * @brief Logs and throws the error of a failed call to the plugin.
+     *
+     * @param status The status of the call.
+     * @throws exceptions::RemoteException if the call failed.
+     */
+    void checkStatus(const grpc::Status& status) const
+    {
+        if (status.ok()) // TODO: handle different kind of status codes
         {
-            if (plugin_info_.has_value())
-            {
-                spdlog::error(
-                    "Plugin '{}' running at [{}] for slot {} failed with error: {}",
-                    plugin_info_.value().plugin_name,
-                    plugin_info_.value().peer,
-                    slot_info_.slot_id,
-                    status.error_message());
-                throw exceptions::RemoteException(slot_info_, plugin_info_.value(), status.error_message());
-            }
-            spdlog::error("Plugin for slot {} failed with error: {}", slot_info_.slot_id, status.error_message());
-            throw exceptions::RemoteException(slot_info_, status.error_message());
+            return;
         }
+        if (plugin_info_.has_value())
+        {
+            spdlog::error(
+                "Plugin '{}' running at [{}] for slot {} failed with error: {}",
+                plugin_info_.value().plugin_name,
+                plugin_info_.value().peer,
+                slot_info_.slot_id,
+                status.error_message());
+            throw exceptions::RemoteException(slot_info_, plugin_info_.value(), status.error_message());
+        }
+        spdlog::error("Plugin for slot {} failed with error: {}", slot_info_.slot_id, status.error_message());
+        throw exceptions::RemoteException(slot_info_, status.error_message());
     }
 
-private:
     inline static void prep_client_context(grpc::ClientContext& client_context, const slot_metadata& slot_info, const std::chrono::milliseconds& timeout = std::chrono::minutes(5))
     {
         // Set time-out
@@ -300,7 +367,9 @@ private:
 
         // Make unary request
         rsp_msg_type response;
+        const auto start = std::chrono::steady_clock::now();
         status = co_await RPC::request(grpc_context, invoke_stub_, client_context, request, response, boost::asio::use_awaitable);
+        statistics_->record(std::chrono::steady_clock::now() - start, request.ByteSizeLong(), response.ByteSizeLong());
         ret_value = rsp_(response);
         co_return;
     }
@@ -316,7 +385,9 @@ private:
 
         // Make unary request
         rsp_msg_type response;
+        const auto start = std::chrono::steady_clock::now();
         status = co_await RPC::request(grpc_context, invoke_stub_, client_context, request, response, boost::asio::use_awaitable);
+        statistics_->record(std::chrono::steady_clock::now() - start, request.ByteSizeLong(), response.ByteSizeLong());
         ret_value = std::move(rsp_(original_value, response));
         co_return;
     }
@@ -343,6 +414,7 @@ private:
                               .version = SlotVersion.value,
                               .engine_uuid = Application::getInstance().instance_uuid_ }; ///< Holds information about the plugin slot.
     std::optional<plugin_metadata> plugin_info_{ std::optional<plugin_metadata>(std::nullopt) }; ///< Optional object that holds the plugin metadata, set after handshake
+    std::shared_ptr<call_statistics> statistics_{ std::make_shared<call_statistics>() }; ///< The cost of the calls to the plugin, shared between copies of this proxy.
 };
 
 } // namespace cura::plugins
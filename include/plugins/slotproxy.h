@@ -9,6 +9,8 @@
 #include <grpcpp/channel.h>
 #include <memory>
 #include <optional>
+#include <string>
+#include <tuple>
 
 #include <boost/asio/use_awaitable.hpp>
 
@@ -83,11 +85,11 @@ public:
         return std::invoke(default_process, std::forward<decltype(args)>(args)...);
     }
 
-    constexpr auto modify(auto& original_value, auto&&... args)
+    constexpr auto modify(auto&& original_value, auto&&... args)
     {
         if (! plugins_.empty())
         {
-            auto modified_value = original_value;
+            auto modified_value = std::forward<decltype(original_value)>(original_value);
 
             for (value_type& plugin : plugins_)
             {
@@ -98,9 +100,62 @@ public:
         }
         if constexpr (sizeof...(args) == 0)
         {
-            return std::invoke(default_process, original_value);
+            return std::invoke(default_process, std::forward<decltype(original_value)>(original_value));
+        }
+        return std::invoke(default_process, std::forward<decltype(original_value)>(original_value), std::forward<decltype(args)>(args)...);
+    }
+
+    /**
+     * @brief Modifies a batch of values in place.
+     *
+     * Each plugin gets all requests of the batch at once, so that the batch costs a single round trip per plugin.
+     *
+     * @param values The values to modify.
+     * @param args_of Callable returning a tuple with the additional arguments for the value at the given index.
+     */
+    void modifyBatch(auto& values, auto&& args_of)
+    {
+        if (! plugins_.empty())
+        {
+            for (value_type& plugin : plugins_)
+            {
+                plugin.modifyBatch(values, args_of);
+            }
+            return;
+        }
+        for (size_t value_idx = 0; value_idx < values.size(); value_idx++)
+        {
+            values[value_idx] = std::apply(
+                [this, &values, value_idx](auto&&... args)
+                {
+                    return std::invoke(default_process, std::move(values[value_idx]), std::forward<decltype(args)>(args)...);
+                },
+                args_of(value_idx));
+        }
+    }
+
+    /**
+     * @brief Gets the names and versions of the plugins of this slot, which tells apart the results of different plugins.
+     */
+    std::string getPluginIdentity() const
+    {
+        std::string identity;
+        for (const value_type& plugin : plugins_)
+        {
+            if (plugin.getPluginInfo().has_value())
+            {
+                identity += plugin.getPluginInfo()->plugin_name + "-" + plugin.getPluginInfo()->plugin_version + ";";
+            }
+        }
+        return identity;
+    }
+
+    void logStatistics()
+    {
+        for (value_type& plugin : plugins_)
+        {
+            plugin.logStatistics();
         }
-        return std::invoke(default_process, original_value, std::forward<decltype(args)>(args)...);
     }
 
     template<v0::SlotID S>
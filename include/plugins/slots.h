@@ -123,6 +123,10 @@ public:
     {
     }
 
+    constexpr void logStatistics() noexcept
+    {
+    }
+
     template<v0::SlotID S>
     constexpr void broadcast([[maybe_unused]] auto&&... args) noexcept
     {
@@ -145,9 +149,9 @@ public:
     }
 
     template<v0::SlotID S>
-    constexpr auto modify(auto& original_value, auto&&... args)
+    constexpr auto modify(auto&& original_value, auto&&... args)
     {
-        return get<S>().modify(original_value, std::forward<decltype(args)>(args)...);
+        return get<S>().modify(std::forward<decltype(original_value)>(original_value), std::forward<decltype(args)>(args)...);
     }
 
     template<v0::SlotID S>
@@ -156,6 +160,18 @@ public:
         return get<S>().generate(std::forward<decltype(args)>(args)...);
     }
 
+    template<v0::SlotID S>
+    void modifyBatch(auto& values, auto&& args_of)
+    {
+        get<S>().modifyBatch(values, std::forward<decltype(args_of)>(args_of));
+    }
+
+    void logStatistics()
+    {
+        value_.proxy.logStatistics();
+        Base::logStatistics();
+    }
+
     void connect(const v0::SlotID& slot_id, auto name, auto& version, auto&& channel)
     {
         if (slot_id == T::slot_id)
@@ -264,6 +280,11 @@ struct Slots
         return std::forward<decltype(data)>(data);
     }
 
+    template<plugins::v0::SlotID S>
+    constexpr void modifyBatch(auto&, auto&&) noexcept
+    {
+    }
+
     template<plugins::v0::SlotID S>
     constexpr auto broadcast(auto&&... args) noexcept
     {
@@ -272,6 +293,10 @@ struct Slots
     constexpr auto connect(auto&&... args) noexcept
     {
     }
+
+    constexpr void logStatistics() noexcept
+    {
+    }
 };
 } // namespace details
 
@@ -89,6 +89,13 @@ public:
      */
     bool has(const std::string& key) const;
 
+    /*!
+     * \brief Get the settings stored in this particular instance, without
+     * those that would be obtained via inheritance.
+     * \return The keys and (unparsed) values of the settings in this instance.
+     */
+    const std::unordered_map<std::string, std::string>& getLocalSettings() const;
+
     /*
      * Change the parent settings object.
      *
@@ -4,9 +4,12 @@
 #ifndef SLICE_DATA_STORAGE_H
 #define SLICE_DATA_STORAGE_H
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <tuple>
 
 #include "SupportInfillPart.h"
 #include "TopSurface.h"
@@ -23,6 +26,8 @@
 #include "settings/types/LayerIndex.h"
 #include "utils/AABB.h"
 #include "utils/AABB3D.h"
+#include "utils/CompactShapeArena.h"
+#include "utils/MemoryUsage.h"
 #include "utils/NoCopy.h"
 
 namespace cura
@@ -155,6 +160,56 @@ public:
      * \return true if there is at least one ExtrusionLine at the specified wall index, false otherwise
      */
     bool hasWallAtInsetIndex(size_t inset_idx) const;
+
+    /*!
+     * Get the \ref outline offset by a distance.
+     *
+     * Several stages offset the outline of the same part by the same distance. The offsets are computed on first use and then kept, so that
+     * they are shared. To limit the memory, offsets are only kept while they have at most a few times the vertices of the outline in total.
+     * This is safe to call from multiple threads. After the outline is changed, \ref clearOutlineOffsets must be called.
+     *
+     * \param distance The distance to offset by. Negative values shrink the outline.
+     * \param join_type How to join the offset edges at convex corners.
+     * \return The offset outline.
+     */
+    std::shared_ptr<const Shape> getOutlineOffset(const coord_t distance, const ClipperLib::JoinType join_type = ClipperLib::jtMiter) const;
+
+    /*!
+     * Forget the offsets of the outline, see \ref getOutlineOffset.
+     */
+    void clearOutlineOffsets();
+
+    /*!
+     * Get the (approximate) heap memory used by the geometry of this part, in bytes.
+     */
+    size_t memoryUsage() const;
+
+private:
+    /*!
+     * The offsets of the outline that were computed before. A copy of a part starts without them, since its outline may be changed.
+     */
+    struct OutlineOffsets
+    {
+        OutlineOffsets() = default;
+
+        OutlineOffsets(const OutlineOffsets&)
+        {
+        }
+
+        OutlineOffsets& operator=(const OutlineOffsets&)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            offsets.clear();
+            point_count = 0;
+            return *this;
+        }
+
+        std::mutex mutex;
+        std::map<std::pair<coord_t, ClipperLib::JoinType>, std::shared_ptr<const Shape>> offsets;
+        size_t point_count = 0; //!< The number of vertices of all offsets together.
+    };
+
+    mutable OutlineOffsets outline_offsets_;
 };
 
 /*!
@@ -200,7 +255,63 @@ public:
      */
     void getOutlines(Shape& result, bool external_polys_only = false) const;
 
+    /*!
+     * Get the (approximate) heap memory used by the geometry of this layer, in bytes.
+     */
+    size_t memoryUsage() const;
+
+    /*!
+     * Get the number of vertices in the outlines of the parts, as an estimate of the work needed to process this layer.
+     */
+    size_t outlineVertexCount() const;
+
+    /*!
+     * Release the geometry that is only needed to export this layer to g-code.
+     *
+     * Only the outlines of the parts are kept. This must only be called once no other layer that is still being exported needs the data of this
+     * layer anymore.
+     */
+    void releaseExportData();
+
+    /*!
+     * Store the geometry that is only read when this layer itself is exported in a compact form, to save memory while the layer waits to be
+     * exported.
+     *
+     * These are the inner areas, the infill areas per density and the top and bottom most surface fill of the skin parts. They are left empty
+     * until \ref expand is called. The outlines, and everything that other layers read while they are exported, are kept as they are.
+     */
+    void compact();
+
+    /*!
+     * Decode the geometry that was stored by \ref compact. This does nothing if the layer isn't compact.
+     *
+     * Only call this from the thread that exports this layer.
+     */
+    void expand();
+
+    /*!
+     * Whether the geometry of this layer is stored compactly, see \ref compact.
+     */
+    bool isCompact() const;
+
     ~SliceLayer();
+
+private:
+    /*!
+     * The geometry stored by \ref compact, in the order in which \ref forEachCompactShape visits the shapes.
+     */
+    struct CompactGeometry
+    {
+        CompactShapeArena arena;
+        std::vector<CompactShapeArena::Handle> handles;
+    };
+
+    std::optional<CompactGeometry> compact_geometry_;
+
+    /*!
+     * Call a function on each shape that \ref compact stores, always in the same order.
+     */
+    void forEachCompactShape(const std::function<void(Shape&)>& function);
 };
 
 /******************/
@@ -274,6 +385,11 @@ public:
         const coord_t grow_layer_above = 0,
         const bool unionAll = false,
         const coord_t custom_line_distance = 0);
+
+    /*!
+     * Get the (approximate) heap memory used by the geometry of this support layer, in bytes.
+     */
+    size_t memoryUsage() const;
 };
 
 class SupportStorage
@@ -357,6 +473,11 @@ public:
      * \return the mesh's user specified z seam hint
      */
     Point2LL getZSeamHint() const;
+
+    /*!
+     * Add the (approximate) heap memory used by the layers and overhang areas of this mesh to a report.
+     */
+    void memoryUsage(MemoryReport& report) const;
 };
 
 class SliceDataStorage : public NoCopy
@@ -420,11 +541,40 @@ public:
         const int extruder_nr = -1,
         const bool include_models = true) const;
 
+    /*!
+     * Get the outlines of the models within a given layer, without support, raft or prime tower.
+     *
+     * The outlines are computed on first use and then kept, so that all callers share them. This is safe to call from multiple threads. After the
+     * parts of the meshes are changed, \ref invalidateLayerOutlines must be called.
+     *
+     * \param layer_nr The index of the layer for which to get the outlines. Must not be negative.
+     * \param external_polys_only Whether to disregard all hole polygons.
+     * \param extruder_nr (optional) only give back outlines for this extruder (where the walls are printed with this extruder)
+     */
+    std::shared_ptr<const Shape> getModelOutlines(const LayerIndex layer_nr, const bool external_polys_only = false, const int extruder_nr = -1) const;
+
+    /*!
+     * Forget the outlines that were kept by \ref getModelOutlines, because the parts of the meshes changed.
+     */
+    void invalidateLayerOutlines();
+
+    /*!
+     * Forget the outlines of a single layer that were kept by \ref getModelOutlines, once that layer is exported.
+     *
+     * \param layer_nr The index of the layer.
+     */
+    void releaseLayerOutlines(const LayerIndex layer_nr);
+
     /*!
      * Get the axis-aligned bounding-box of the complete model (all meshes).
      */
     AABB3D getModelBoundingBox() const;
 
+    /*!
+     * Get the (approximate) heap memory used by the slice data, per structure and per layer.
+     */
+    MemoryReport memoryUsage() const;
+
     /*!
      * Get the extruders used.
      *
@@ -464,6 +614,9 @@ private:
      * Construct the retraction_wipe_config_per_extruder
      */
     std::vector<RetractionAndWipeConfig> initializeRetractionAndWipeConfigs();
+
+    mutable std::mutex model_outlines_mutex_;
+    mutable std::map<std::tuple<LayerIndex, bool, int>, std::shared_ptr<const Shape>> model_outlines_; //!< Per layer, external polygons only and extruder
 };
 
 } // namespace cura
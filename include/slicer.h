@@ -6,7 +6,7 @@
 
 #include <optional>
 #include <queue>
-#include <unordered_map>
+#include <vector>
 
 #include "geometry/LinesSet.h"
 #include "geometry/OpenLinesSet.h"
@@ -60,7 +60,7 @@ class SlicerLayer
 {
 public:
     std::vector<SlicerSegment> segments_;
-    std::unordered_map<int, int> face_idx_to_segment_idx_; // topology
+    std::vector<int> segment_face_indices_; //!< topology: the face of each segment in \ref segments_, which are stored in order of ascending face index
 
     int z_ = -1;
     Shape polygons_;
@@ -486,6 +486,13 @@ public:
 
     const Mesh* mesh = nullptr; //!< The sliced mesh
 
+    /*!
+     * The [first, end) range of layers that the mesh spans, with a margin of one layer on both sides.
+     *
+     * Only these layers are sliced; the other layers are left empty.
+     */
+    std::pair<size_t, size_t> sliced_layer_range;
+
     Slicer(Mesh* mesh, const coord_t thickness, const size_t slice_layer_count, bool use_variable_layer_heights, std::vector<AdaptiveLayer>* adaptive_layers);
 
 
@@ -524,12 +531,23 @@ private:
      */
     static std::vector<std::pair<int32_t, int32_t>> buildZHeightsForFaces(const Mesh& mesh);
 
+    /*!
+     * Get the range of layers that the faces of a mesh span.
+     *
+     * The layers in between two slicing heights are combined for some slicing tolerances, so the range is extended with one layer on both sides.
+     * \param zbboxes The z part of the bounding boxes of the faces of the mesh.
+     * \param layers The layers, with their z values set.
+     * \return The [first, end) range of layers that can intersect a face.
+     */
+    static std::pair<size_t, size_t> getLayerRange(const std::vector<std::pair<int32_t, int32_t>>& zbboxes, const std::vector<SlicerLayer>& layers);
+
     /*! Creates the polygons in layers.
      * \param[in] mesh The mesh which is analyzed.
      * \param[in] slicing_tolerance The way the slicing tolerance should be applied (MIDDLE/INCLUSIVE/EXCLUSIVE).
+     * \param[in] layer_range The [first, end) range of layers that can contain polygons.
      * \param[in, out] layers The polygon are created here.
      */
-    static void makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, std::vector<SlicerLayer>& layers);
+    static void makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, const std::pair<size_t, size_t>& layer_range, std::vector<SlicerLayer>& layers);
 
     /*! Creates a vector of layers and set their z value.
      * \param[in] mesh The mesh which is analyzed.
@@ -553,10 +571,15 @@ private:
      * \param[in] mesh The mesh which is analyzed.
      * \param[in] zbboxes The z part of the bounding boxes of the faces of the mesh.
      * \param[in] slicing_tolderance Slicing tolerance in order to figure out what happens when vertices are exactly on the slicing boundary.
+     * \param[in] layer_range The [first, end) range of layers that can intersect a face.
      * \param[in, out] layers The segments are created here.
      */
-    static void
-        buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbboxes, const SlicingTolerance& slicing_tolerance, std::vector<SlicerLayer>& layers);
+    static void buildSegments(
+        const Mesh& mesh,
+        const std::vector<std::pair<int32_t, int32_t>>& zbboxes,
+        const SlicingTolerance& slicing_tolerance,
+        const std::pair<size_t, size_t>& layer_range,
+        std::vector<SlicerLayer>& layers);
 };
 
 } // namespace cura
@@ -214,15 +214,24 @@ private:
         const double minimum_interface_area,
         Shape& interface_polygons);
 
+    /*!
+     * \brief Get the area that conical support may expand into: the build
+     * volume, minus the room needed for the platform adhesion.
+     * \param storage The slice data storage, for the machine size.
+     * \return The allowed area.
+     */
+    static Shape getMachineVolumeBorder(const SliceDataStorage& storage);
+
     /*!
      * \brief Join current support layer with the support of the layer above,
      * (make support conical) and perform smoothing etc. operations.
-     * \param storage Where to store the resulting support.
      * \param supportLayer_up The support areas the layer above.
      * \param supportLayer_this The overhang areas of the current layer at hand.
+     * \param machine_volume_border The area that conical support may expand
+     * into, see \ref getMachineVolumeBorder.
      * \return The joined support areas for this layer.
      */
-    static Shape join(const SliceDataStorage& storage, const Shape& supportLayer_up, Shape& supportLayer_this);
+    static Shape join(const Shape& supportLayer_up, Shape& supportLayer_this, const Shape& machine_volume_border);
 
     /*!
      * Move the support up from model (cut away polygons to ensure bottom z distance)
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_ASYNC_FILE_STREAM_BUFFER_H
+#define UTILS_ASYNC_FILE_STREAM_BUFFER_H
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace cura
+{
+
+/*!
+ * Stream buffer which writes to a file from a dedicated thread.
+ *
+ * The data is collected in one large buffer while the other one is written to the file, so writing to the stream only blocks when the
+ * file can't keep up with both buffers.
+ *
+ * Flushing the stream waits until everything written so far has reached the file.
+ */
+class AsyncFileStreamBuffer : public std::streambuf
+{
+public:
+    static constexpr size_t default_buffer_size = 4 * 1024 * 1024;
+
+    explicit AsyncFileStreamBuffer(const size_t buffer_size = default_buffer_size);
+
+    ~AsyncFileStreamBuffer() override;
+
+    AsyncFileStreamBuffer(const AsyncFileStreamBuffer&) = delete;
+    AsyncFileStreamBuffer& operator=(const AsyncFileStreamBuffer&) = delete;
+
+    /*!
+     * Open a file to write to, closing the previous one if any.
+     *
+     * \param filename The file to (over)write.
+     * \param binary Whether to write the data as is, such as binary g-code. Otherwise it's written as text, with the line endings of the
+     * platform.
+     * \return Whether the file could be opened.
+     */
+    bool open(const char* filename, const bool binary = false);
+
+    bool isOpen() const;
+
+    /*!
+     * Whether the open file is written as is, see \ref open.
+     */
+    bool isBinary() const;
+
+    /*!
+     * Write all remaining data to the file and close it.
+     */
+    void close();
+
+protected:
+    int_type overflow(int_type ch) override;
+
+    int sync() override;
+
+private:
+    size_t buffer_size_;
+    std::ofstream file_; //!< Only accessed by the writer thread while it is running
+    bool binary_ = false;
+    std::thread writer_;
+
+    std::vector<char> front_buffer_; //!< The buffer which is currently written to by the stream
+    std::vector<char> back_buffer_; //!< The buffer which is handed over to the writer thread
+
+    std::mutex mutex_; //!< Guards all members below
+    std::condition_variable condition_;
+    size_t back_buffer_used_ = 0; //!< The number of bytes in the back buffer which should be written
+    bool back_buffer_pending_ = false; //!< Whether the back buffer still has to be written by the writer thread
+    bool flush_requested_ = false; //!< Whether the file should be flushed after writing the back buffer
+    bool stopping_ = false;
+    bool failed_ = false;
+
+    /*!
+     * Hand the data in the front buffer over to the writer thread, and continue with an empty front buffer.
+     *
+     * \param flush Whether the file should be flushed after writing the data.
+     * \return Whether the file is still fine.
+     */
+    bool handOver(const bool flush);
+
+    /*!
+     * Wait until the writer thread has written all data which was handed over to it.
+     *
+     * \return Whether the data could be written.
+     */
+    bool waitUntilWritten();
+
+    void writeLoop();
+};
+
+} // namespace cura
+
+#endif // UTILS_ASYNC_FILE_STREAM_BUFFER_H
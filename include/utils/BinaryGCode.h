@@ -0,0 +1,209 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_BINARY_GCODE_H
+#define UTILS_BINARY_GCODE_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cura
+{
+
+/*!
+ * The binary g-code container format.
+ *
+ * A binary g-code file starts with a file header, followed by blocks. Each block has a type, a compression method and a CRC32 checksum.
+ * The metadata blocks come first (printer, print and slicer metadata, in that order) and hold "key=value" lines.
+ * They are followed by the g-code blocks, each of which holds a number of complete g-code lines.
+ */
+namespace bgcode
+{
+
+enum class BlockType : uint16_t
+{
+    FILE_METADATA = 0,
+    GCODE = 1,
+    SLICER_METADATA = 2,
+    PRINTER_METADATA = 3,
+    PRINT_METADATA = 4,
+    THUMBNAIL = 5,
+};
+
+enum class Compression : uint16_t
+{
+    NONE = 0,
+    DEFLATE = 1,
+    HEATSHRINK_11_4 = 2,
+    HEATSHRINK_12_4 = 3,
+};
+
+/*!
+ * A decoded block.
+ */
+struct Block
+{
+    BlockType type;
+    std::string data; //!< The uncompressed contents of the block
+};
+
+using Metadata = std::vector<std::pair<std::string, std::string>>;
+
+/*!
+ * Get the file header, which uses CRC32 checksums for the blocks.
+ */
+std::string encodeFileHeader();
+
+/*!
+ * Encode a block, including its checksum.
+ *
+ * \param type The type of block, which must not be a thumbnail.
+ * \param data The uncompressed contents of the block.
+ * \param compression Either no compression or heatshrink with a window of 12 bits and a lookahead of 4 bits. If the compressed data
+ * turns out larger than the original, the block is stored uncompressed.
+ */
+std::string encodeBlock(const BlockType type, const std::string_view data, const Compression compression);
+
+/*!
+ * Get the contents of a metadata block.
+ */
+std::string encodeMetadata(const Metadata& metadata);
+
+/*!
+ * Get the "KEY:VALUE" comments of a g-code header as metadata.
+ */
+Metadata parseHeaderComments(const std::string_view header);
+
+/*!
+ * Decode a binary g-code file.
+ *
+ * \return The blocks in the file, or nothing if it is malformed, uses an unsupported compression or has a wrong checksum.
+ */
+std::optional<std::vector<Block>> decode(const std::string_view file);
+
+/*!
+ * Compress data with heatshrink, using a window of 12 bits and a lookahead of 4 bits.
+ */
+std::string heatshrinkCompress(const std::string_view data);
+
+/*!
+ * Decompress data compressed with heatshrink, using a window of 12 bits and a lookahead of 4 bits.
+ *
+ * \param decompressed_size The size of the original data.
+ * \return The original data, or nothing if the compressed data is malformed.
+ */
+std::optional<std::string> heatshrinkDecompress(const std::string_view data, const size_t decompressed_size);
+
+uint32_t crc32(const std::string_view data, const uint32_t crc = 0);
+
+} // namespace bgcode
+
+/*!
+ * Stream buffer which encodes the g-code written to it as binary g-code, and writes that to another stream.
+ *
+ * The g-code is cut into blocks of complete lines, which are compressed by the engine's thread pool while the next block is written.
+ * The encoded blocks are written to the target stream in order.
+ */
+class BinaryGCodeEncoder : public std::streambuf
+{
+public:
+    static constexpr size_t default_block_size = 64 * 1024;
+
+    /*!
+     * Start a binary g-code file.
+     *
+     * \param target The stream to write the encoded file to. It should be opened in binary mode.
+     * \param block_size The maximum amount of g-code per block.
+     */
+    explicit BinaryGCodeEncoder(std::ostream& target, const size_t block_size = default_block_size);
+
+    ~BinaryGCodeEncoder() override;
+
+    /*!
+     * Add a metadata block. These have to be added before any g-code is written, unless the g-code is held back with \ref holdGCode.
+     */
+    void writeMetadata(const bgcode::BlockType type, const bgcode::Metadata& metadata);
+
+    /*!
+     * Keep the encoded g-code in memory instead of writing it to the target stream, until \ref releaseGCode is called.
+     *
+     * This way metadata that is only known once all g-code is written, like the print time, can still be written in front of the g-code.
+     */
+    void holdGCode();
+
+    /*!
+     * Encode the rest of the g-code and write all g-code that was held back to the target stream, after the metadata written so far.
+     */
+    void releaseGCode();
+
+protected:
+    int_type overflow(int_type ch) override;
+
+    int sync() override;
+
+private:
+    /*!
+     * A block that is being encoded. It's encoded by whichever thread gets to it first: a worker of the thread pool, or the thread that
+     * needs its result, so that waiting for a block never depends on a free worker.
+     */
+    struct EncodeJob
+    {
+        std::packaged_task<std::string()> task;
+        std::future<std::string> result;
+        std::atomic<bool> started{ false };
+
+        void run()
+        {
+            if (! started.exchange(true))
+            {
+                task();
+            }
+        }
+    };
+
+    std::ostream& target_;
+    size_t block_size_;
+    size_t max_pending_blocks_; //!< The number of blocks which may be encoded at the same time
+    std::string text_; //!< The g-code written since the last block, sized to the block size
+    std::deque<std::shared_ptr<EncodeJob>> pending_blocks_; //!< Blocks which are not written to the target yet, in order
+    std::optional<std::string> held_gcode_; //!< The encoded g-code blocks that are held back by \ref holdGCode, if any
+
+    /*!
+     * Encode the first \p length bytes of written g-code as a block, and keep the rest for the next block.
+     */
+    void emitBlock(const size_t length);
+
+    /*!
+     * Add a block to be written after the blocks before it.
+     *
+     * \param encode The function that encodes the block.
+     * \param in_background Whether to encode it on the thread pool, or only when it has to be written.
+     */
+    void enqueue(std::packaged_task<std::string()>&& encode, const bool in_background);
+
+    /*!
+     * Write the first pending block to the target stream, or to the held back g-code, encoding it on this thread if no worker started on it yet.
+     */
+    void writeFrontBlock();
+
+    /*!
+     * Write the encoded blocks at the front of the queue to the target stream.
+     *
+     * \param wait Whether to wait for all blocks, or only write the blocks that are already done.
+     */
+    void writePendingBlocks(const bool wait);
+};
+
+} // namespace cura
+
+#endif // UTILS_BINARY_GCODE_H
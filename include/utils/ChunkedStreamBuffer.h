@@ -0,0 +1,62 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_CHUNKED_STREAM_BUFFER_H
+#define UTILS_CHUNKED_STREAM_BUFFER_H
+
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace cura
+{
+
+/*!
+ * Stream buffer which collects the written data in blocks of a fixed size.
+ *
+ * Unlike an std::stringbuf, the data is never moved around when more is written. \ref take hands the written blocks over as they are, without
+ * copying them. Blocks that the consumer is done with can be given back with \ref recycle, so that they are written to again instead of
+ * allocating new ones.
+ */
+class ChunkedStreamBuffer : public std::streambuf
+{
+public:
+    static constexpr size_t default_block_size = 64 * 1024;
+
+    explicit ChunkedStreamBuffer(const size_t block_size = default_block_size);
+
+    /*!
+     * Get the number of bytes written since the last \ref take.
+     */
+    size_t size() const;
+
+    /*!
+     * Take out all data written since the last call.
+     *
+     * \return The blocks with the data, in order. All but the last one are full. Empty if nothing was written.
+     */
+    std::vector<std::string> take();
+
+    /*!
+     * Give back blocks that were taken out, so that they can be written to again.
+     */
+    void recycle(std::vector<std::string>&& blocks);
+
+protected:
+    int_type overflow(int_type ch) override;
+
+private:
+    size_t block_size_;
+    std::vector<std::string> full_blocks_; //!< The blocks which have been written completely since the last take
+    std::string current_block_; //!< The block currently written to, of the block size
+    std::vector<std::string> spare_blocks_; //!< Blocks which can be reused
+
+    /*!
+     * Start writing to a new block, reusing a spare block if possible.
+     */
+    void startBlock();
+};
+
+} // namespace cura
+
+#endif // UTILS_CHUNKED_STREAM_BUFFER_H
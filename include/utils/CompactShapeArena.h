@@ -0,0 +1,61 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_COMPACT_SHAPE_ARENA_H
+#define UTILS_COMPACT_SHAPE_ARENA_H
+
+#include <cstdint>
+#include <vector>
+
+#include "geometry/Shape.h"
+
+namespace cura
+{
+
+/*!
+ * Compact storage for shapes that are finished, but only read much later, e.g. the areas of a layer that waits to be exported.
+ *
+ * \ref SliceLayer::compact stores the layer geometry that is only read when the layer is exported in one of these.
+ *
+ * The shapes are stored one after the other in a single buffer. Each coordinate is stored as the difference with the previous one, encoded as
+ * a zigzag variable-length integer. Since most vertices lie within a few millimeters of their predecessor, a vertex usually takes 4 to 6 bytes
+ * instead of 16.
+ *
+ * Adding shapes is not thread-safe, but getting them is.
+ */
+class CompactShapeArena
+{
+public:
+    /*!
+     * Identifies a shape in the arena.
+     */
+    using Handle = size_t;
+
+    /*!
+     * Encode a shape into the arena.
+     * \return The handle to decode it with.
+     */
+    Handle add(const Shape& shape);
+
+    /*!
+     * Decode a shape that was added to this arena.
+     */
+    Shape get(const Handle handle) const;
+
+    /*!
+     * Release the memory that was allocated for shapes that were never added.
+     */
+    void shrinkToFit();
+
+    /*!
+     * Get the heap memory used by the arena, in bytes.
+     */
+    size_t memoryUsage() const;
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+} // namespace cura
+
+#endif // UTILS_COMPACT_SHAPE_ARENA_H
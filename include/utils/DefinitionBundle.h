@@ -0,0 +1,64 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_DEFINITION_BUNDLE_H
+#define UTILS_DEFINITION_BUNDLE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cura
+{
+
+/*!
+ * A machine definition with its whole inheritance chain already resolved, stored in a compact binary format.
+ *
+ * Loading a bundle only copies the setting values into the settings storage, skipping the JSON parsing and the search for the inherited
+ * definition files. The bundle records which definition files it was compiled from and a hash of their contents, so that the definition
+ * files can be loaded instead when they changed.
+ *
+ * The format is little-endian: a magic string, the format version, the source hash, the number of source files followed by their
+ * length-prefixed paths, the number of definitions followed by the settings stack and length-prefixed path of each, and the number of
+ * settings stacks (the global stack followed by one stack per extruder). Each stack holds its number of settings, followed by the
+ * length-prefixed key and value of each setting.
+ */
+struct DefinitionBundle
+{
+    using SettingList = std::vector<std::pair<std::string, std::string>>;
+
+    uint64_t source_hash = 0; //!< Hash of the contents of the definition files this bundle was compiled from
+    std::vector<std::string> source_files; //!< All definition files this bundle was compiled from, in the order they were hashed
+    std::vector<std::pair<uint32_t, std::string>> definitions; //!< The files given with -j, with their stack: 0 for global, else 1 + extruder number
+    SettingList global_settings;
+    std::vector<SettingList> extruder_settings; //!< The settings of each extruder, by extruder number
+
+    /*!
+     * Whether \p data starts like a definition bundle, as opposed to e.g. a JSON definition.
+     */
+    static bool isBundle(const std::string_view data);
+
+    /*!
+     * Hash the contents of a definition file, combining it with the hash of the previous files.
+     */
+    static uint64_t hashSource(const std::string_view data, const uint64_t seed = 0);
+
+    /*!
+     * Get the binary representation of this bundle. The settings are sorted, so the same definitions always give the same bundle.
+     */
+    std::string serialize() const;
+
+    /*!
+     * Read a bundle from its binary representation.
+     *
+     * \return The bundle, or nothing if \p data is not a bundle of a supported version or if it's truncated.
+     */
+    static std::optional<DefinitionBundle> deserialize(std::string_view data);
+};
+
+} // namespace cura
+
+#endif // UTILS_DEFINITION_BUNDLE_H
@@ -0,0 +1,50 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_DETERMINISTIC_RANDOM_H
+#define UTILS_DETERMINISTIC_RANDOM_H
+
+#include <cassert>
+#include <cstdint>
+
+namespace cura
+{
+
+/*!
+ * Random numbers that only depend on a seed, e.g. a layer number.
+ *
+ * Unlike rand(), every unit of work can have its own sequence, so the results are the same regardless of the number of threads and the order
+ * in which the work is done. The numbers are the SplitMix64 hashes of a counter, which is random enough for geometric jitter.
+ */
+class DeterministicRandom
+{
+public:
+    explicit DeterministicRandom(const uint64_t seed)
+        : state_(seed)
+    {
+    }
+
+    //! Get the next number of the sequence.
+    uint64_t next()
+    {
+        state_ += 0x9E3779B97F4A7C15;
+        uint64_t mixed = state_;
+        mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EB;
+        return mixed ^ (mixed >> 31);
+    }
+
+    //! Get the next number of the sequence, in the range [0, \p range).
+    int64_t below(const int64_t range)
+    {
+        assert(range > 0);
+        return static_cast<int64_t>(next() % static_cast<uint64_t>(range));
+    }
+
+private:
+    uint64_t state_;
+};
+
+} // namespace cura
+
+#endif // UTILS_DETERMINISTIC_RANDOM_H
@@ -0,0 +1,86 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_MEMORY_USAGE_H
+#define UTILS_MEMORY_USAGE_H
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "geometry/LinesSet.h"
+#include "geometry/PointsSet.h"
+
+namespace cura
+{
+
+class ExtrusionLine;
+class MixedLinesSet;
+
+/*!
+ * Get the highest amount of physical memory used by this process so far.
+ *
+ * \return The peak resident set size in bytes, or 0 if it can't be determined on this platform.
+ */
+size_t getPeakResidentMemory();
+
+/*!
+ * The (approximate) heap memory used by the data structures of a slice, per structure and per layer.
+ */
+struct MemoryReport
+{
+    std::vector<std::pair<std::string, size_t>> bytes_per_structure;
+    std::vector<size_t> bytes_per_layer; //!< Over all structures that store data per layer
+
+    void add(const std::string& structure, const size_t bytes);
+
+    void addToLayer(const size_t layer_idx, const size_t bytes);
+
+    size_t total() const;
+
+    /*!
+     * Log the total at info level, the structures at debug level and the layers at trace level.
+     */
+    void log(const std::string_view title) const;
+};
+
+/*
+ * Estimates of the heap memory that is owned by geometric data, in bytes. They use the capacity of the containers, not their size.
+ */
+
+size_t memoryUsage(const PointsSet& points);
+
+size_t memoryUsage(const MixedLinesSet& lines);
+
+size_t memoryUsage(const ExtrusionLine& line);
+
+template<class LineType>
+size_t memoryUsage(const LinesSet<LineType>& lines)
+{
+    size_t bytes = lines.getLines().capacity() * sizeof(LineType);
+    for (const LineType& line : lines)
+    {
+        bytes += memoryUsage(line);
+    }
+    return bytes;
+}
+
+template<typename T>
+size_t memoryUsage(const std::vector<T>& elements)
+{
+    size_t bytes = elements.capacity() * sizeof(T);
+    if constexpr (! std::is_trivially_copyable_v<T>)
+    {
+        for (const T& element : elements)
+        {
+            bytes += memoryUsage(element);
+        }
+    }
+    return bytes;
+}
+
+} // namespace cura
+
+#endif // UTILS_MEMORY_USAGE_H
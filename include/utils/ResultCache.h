@@ -0,0 +1,118 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_RESULT_CACHE_H
+#define UTILS_RESULT_CACHE_H
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace cura
+{
+
+/*!
+ * Thread-safe cache of expensive results, bounded by the (approximate) memory used by the cached values.
+ *
+ * When the cache is full, the least recently used results are evicted first.
+ *
+ * \tparam Key The type identifying a result, which must be comparable and hashable with \p Hash.
+ * \tparam Value The type of the results, which is copied out of the cache.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class ResultCache
+{
+public:
+    /*!
+     * \param max_bytes The maximum total size of the cached values.
+     */
+    explicit ResultCache(const size_t max_bytes)
+        : max_bytes_(max_bytes)
+    {
+    }
+
+    /*!
+     * Get a copy of the result for \p key, if it is cached.
+     */
+    std::optional<Value> get(const Key& key)
+    {
+        std::lock_guard lock(mutex_);
+        const auto it = index_.find(key);
+        if (it == index_.end())
+        {
+            return std::nullopt;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second); // Mark as most recently used.
+        return it->second->value;
+    }
+
+    /*!
+     * Store the result for \p key, evicting the least recently used results if the cache gets too large.
+     *
+     * \param bytes The approximate memory used by \p value. Values larger than the whole cache are not stored.
+     */
+    void put(const Key& key, Value value, const size_t bytes)
+    {
+        if (bytes > max_bytes_)
+        {
+            return;
+        }
+        std::lock_guard lock(mutex_);
+        if (index_.contains(key))
+        {
+            return; // Another thread computed the same result in the meantime.
+        }
+        while (used_bytes_ + bytes > max_bytes_)
+        {
+            used_bytes_ -= entries_.back().bytes;
+            index_.erase(entries_.back().key);
+            entries_.pop_back();
+        }
+        entries_.push_front(Entry{ key, std::move(value), bytes });
+        index_.emplace(key, entries_.begin());
+        used_bytes_ += bytes;
+    }
+
+    /*!
+     * Forget all cached results.
+     */
+    void clear()
+    {
+        std::lock_guard lock(mutex_);
+        index_.clear();
+        entries_.clear();
+        used_bytes_ = 0;
+    }
+
+    size_t size()
+    {
+        std::lock_guard lock(mutex_);
+        return entries_.size();
+    }
+
+    size_t usedBytes()
+    {
+        std::lock_guard lock(mutex_);
+        return used_bytes_;
+    }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        size_t bytes;
+    };
+
+    std::mutex mutex_; //!< Guards all members below
+    std::list<Entry> entries_; //!< The cached results, most recently used first
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index_;
+    size_t max_bytes_;
+    size_t used_bytes_ = 0;
+};
+
+} // namespace cura
+
+#endif // UTILS_RESULT_CACHE_H
@@ -0,0 +1,76 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_SHAPE_INSIDE_INDEX_H
+#define UTILS_SHAPE_INSIDE_INDEX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "geometry/Point2LL.h"
+
+namespace cura
+{
+
+class Shape;
+
+/*!
+ * Answers many point-in-polygon queries on the same shape quickly.
+ *
+ * \ref Shape::inside tests a point against every edge of the shape. This index cuts the shape into horizontal slabs and keeps, per slab, the
+ * edges that overlap it, so that a query only tests the edges at the height of the point. The edges are stored coordinate by coordinate, and
+ * the test per edge is free of branches, so that the compiler can test several edges at once with vector instructions.
+ *
+ * The results are exactly the same as those of \ref Shape::inside, including the points on the border.
+ *
+ * The index copies the edges, so the shape may change or be deleted afterwards, but the index then still describes the old shape. Queries are
+ * thread-safe.
+ */
+class ShapeInsideIndex
+{
+public:
+    /*!
+     * Build an index of the edges of a shape.
+     */
+    explicit ShapeInsideIndex(const Shape& shape);
+
+    /*!
+     * Check whether a point is inside the shape.
+     * \param p The point to check.
+     * \param border_result What to return when the point lies exactly on the border.
+     * \return Whether the point is inside, like \ref Shape::inside.
+     */
+    bool inside(const Point2LL& p, const bool border_result = false) const;
+
+    /*!
+     * Check for many points whether they are inside the shape.
+     * \param points The points to check.
+     * \param border_result What to return for points that lie exactly on the border.
+     * \return For each point, whether it is inside.
+     */
+    std::vector<bool> inside(const std::vector<Point2LL>& points, const bool border_result = false) const;
+
+    /*!
+     * Get the heap memory used by the index, in bytes.
+     */
+    size_t memoryUsage() const;
+
+private:
+    coord_t min_y_ = 0;
+    coord_t slab_height_ = 1;
+
+    /*!
+     * For each slab, the index of its first edge. The edges of slab i are [slab_start_[i], slab_start_[i + 1]).
+     */
+    std::vector<size_t> slab_start_;
+
+    // The edges, from (from_x_, from_y_) to (to_x_, to_y_), grouped by slab. Edges that overlap multiple slabs are stored in each of them.
+    std::vector<coord_t> from_x_;
+    std::vector<coord_t> from_y_;
+    std::vector<coord_t> to_x_;
+    std::vector<coord_t> to_y_;
+};
+
+} // namespace cura
+
+#endif // UTILS_SHAPE_INSIDE_INDEX_H
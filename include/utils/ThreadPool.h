@@ -4,14 +4,19 @@
 #ifndef THREADPOOL_H
 #define THREADPOOL_H
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional> // std::function<>
 #include <mutex>
+#include <string_view>
 #include <thread>
 #include <vector>
 
+#include <spdlog/spdlog.h>
+
 #include "../Application.h" // accessing singleton's Application::thread_pool
 #include "../utils/math.h" // round_up_divide
 
@@ -218,6 +223,133 @@ auto parallel_for(Container& container, F&& loop_body, size_t chunk_size_factor
 }
 
 
+//! The cost hint of parallel_for_adaptive() when the items are not known to differ in cost.
+struct UniformCost
+{
+    template<typename T>
+    size_t operator()(const T&) const
+    {
+        return 1;
+    }
+};
+
+/*!
+ * \brief An implementation of parallel for, for loops where the cost of the items is very uneven, like loops over the layers of a print.
+ *
+ * Instead of dividing the range in fixed chunks beforehand, every worker takes a new chunk as soon as it finished the previous one (guided
+ * self-scheduling). A chunk gets about 1/(2 * workers) of the remaining cost, so the chunks get smaller towards the end of the range and a
+ * single expensive chunk doesn't keep the other workers waiting at the end of the loop.
+ *
+ * The time that each worker spent in the loop is logged at debug level, to find the loops in which the work is still badly divided.
+ *
+ * \param region_name The name of the loop in the log.
+ * \param first, last The [inclusive, exclusive) range of iteration. Integers or random access iterators
+ * \param loop_body The loop-body, as a closure. Receives the index on invocation.
+ * \param cost_hint Estimates the relative cost of an item, e.g. its number of parts or vertices. Called once for every item, before the loop.
+ */
+template<typename T, typename F, typename C = UniformCost>
+void parallel_for_adaptive(const std::string_view region_name, T first, T last, F&& loop_body, C&& cost_hint = C{})
+{
+    using lock_t = ThreadPool::lock_t;
+
+    const auto dist = distance(first, last);
+    if (dist <= 0)
+    {
+        return;
+    }
+    const size_t nitems = dist;
+
+    ThreadPool* const thread_pool = Application::getInstance().thread_pool_;
+    assert(thread_pool);
+    const size_t nworkers = thread_pool->thread_count() + 1; // One task per std::thread + 1 for main thread
+    const size_t ntasks = std::min(nworkers, nitems);
+
+    // The cost of all items before each item, to find the end of a chunk with a binary search. Every item costs something, even if it's empty.
+    std::vector<size_t> cumulative_cost(nitems + 1, 0);
+    for (size_t item = 0; item < nitems; item++)
+    {
+        cumulative_cost[item + 1] = cumulative_cost[item] + std::max<size_t>(cost_hint(first + static_cast<decltype(dist)>(item)), 1);
+    }
+
+    // Packs state variables such that they can be referenced by the task closure through a single reference
+    struct
+    {
+        std::decay_t<F> loop_body; // User's closure data
+        size_t next_item;
+        size_t chunks;
+        size_t tasks_remaining;
+        std::vector<std::chrono::duration<double>> busy_times = {};
+        std::condition_variable work_done = {};
+    } shared_state = { std::forward<F>(loop_body), 0, 0, ntasks };
+
+    // Schedules one task per worker, which take chunks until the range is done
+    lock_t lock = thread_pool->get_lock();
+    for (size_t task = 0; task < ntasks; task++)
+    {
+        thread_pool->push(
+            lock,
+            [&shared_state, &cumulative_cost, first, nitems, nworkers](lock_t& th_lock)
+            {
+                std::chrono::duration<double> busy_time{ 0 };
+                while (shared_state.next_item < nitems)
+                {
+                    const size_t chunk_first = shared_state.next_item;
+                    const size_t chunk_cost = std::max<size_t>((cumulative_cost[nitems] - cumulative_cost[chunk_first]) / (2 * nworkers), 1);
+                    const auto chunk_end = std::lower_bound(cumulative_cost.begin() + chunk_first + 1, cumulative_cost.end(), cumulative_cost[chunk_first] + chunk_cost);
+                    const size_t chunk_last = std::min(static_cast<size_t>(chunk_end - cumulative_cost.begin()), nitems);
+                    shared_state.next_item = chunk_last;
+                    shared_state.chunks++;
+
+                    th_lock.unlock(); // Enter unsynchronized region
+                    const auto start = std::chrono::steady_clock::now();
+                    for (size_t item = chunk_first; item < chunk_last; item++)
+                    {
+                        shared_state.loop_body(first + static_cast<decltype(dist)>(item));
+                    }
+                    busy_time += std::chrono::steady_clock::now() - start;
+                    th_lock.lock();
+                }
+                shared_state.busy_times.push_back(busy_time);
+                if (--shared_state.tasks_remaining == 0)
+                {
+                    shared_state.work_done.notify_one();
+                }
+            });
+    }
+
+    // Do work while parallel_for_adaptive's tasks are running
+    thread_pool->work_while(
+        lock,
+        [&]
+        {
+            return shared_state.tasks_remaining > 0;
+        });
+    while (shared_state.tasks_remaining > 0) // Wait until all the task are completed
+    {
+        shared_state.work_done.wait(lock);
+    }
+
+    if (spdlog::should_log(spdlog::level::debug))
+    {
+        std::chrono::duration<double> total_time{ 0 };
+        std::chrono::duration<double> max_time{ 0 };
+        for (const std::chrono::duration<double>& busy_time : shared_state.busy_times)
+        {
+            total_time += busy_time;
+            max_time = std::max(max_time, busy_time);
+        }
+        const double mean_time = total_time.count() / nworkers;
+        spdlog::debug(
+            "{}: {} items in {} chunks, busiest worker {:.3f}s, mean {:.3f}s, imbalance {:.2f}",
+            region_name,
+            nitems,
+            shared_state.chunks,
+            max_time.count(),
+            mean_time,
+            mean_time > 0.0 ? max_time.count() / mean_time : 1.0);
+    }
+}
+
 //! \private Internal state for run_multiple_producers_ordered_consumer()
 template<typename Producer, typename Consumer>
 class MultipleProducersOrderedConsumer;
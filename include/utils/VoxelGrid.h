@@ -0,0 +1,179 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_VOXEL_GRID_H
+#define UTILS_VOXEL_GRID_H
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "utils/VoxelUtils.h"
+
+namespace cura
+{
+
+/*!
+ * A dense set of voxel cells within a fixed box of the voxel grid.
+ *
+ * Each row of cells along the X axis is stored as a sequence of bits,
+ * so that set operations and dilations process 64 cells at a time instead of hashing individual cells.
+ *
+ * Cells outside of the box are never part of the set: inserting them has no effect and dilations are cropped to the box.
+ */
+class VoxelGrid
+{
+public:
+    using word_t = uint64_t;
+    static constexpr coord_t word_bits = 64;
+
+    /*!
+     * Create an empty set covering the box of cells from \p min up to and including \p max.
+     */
+    VoxelGrid(const GridPoint3& min, const GridPoint3& max);
+
+    const GridPoint3& min() const
+    {
+        return min_;
+    }
+
+    GridPoint3 max() const
+    {
+        return min_ + size_ - GridPoint3(1, 1, 1);
+    }
+
+    bool inBounds(const GridPoint3& cell) const
+    {
+        return cell.x_ >= min_.x_ && cell.y_ >= min_.y_ && cell.z_ >= min_.z_ && cell.x_ < min_.x_ + size_.x_ && cell.y_ < min_.y_ + size_.y_ && cell.z_ < min_.z_ + size_.z_;
+    }
+
+    bool contains(const GridPoint3& cell) const
+    {
+        if (! inBounds(cell))
+        {
+            return false;
+        }
+        const coord_t x = cell.x_ - min_.x_;
+        return (words_[rowIndex(cell.y_, cell.z_) + x / word_bits] >> (x % word_bits)) & 1;
+    }
+
+    /*!
+     * Add a cell to the set.
+     *
+     * \warning Not thread safe, not even for different cells, since neighboring cells share the same storage.
+     */
+    void insert(const GridPoint3& cell)
+    {
+        if (! inBounds(cell))
+        {
+            return;
+        }
+        const coord_t x = cell.x_ - min_.x_;
+        words_[rowIndex(cell.y_, cell.z_) + x / word_bits] |= word_t(1) << (x % word_bits);
+    }
+
+    /*!
+     * Get the number of cells in the set.
+     */
+    size_t size() const;
+
+    bool empty() const;
+
+    /*!
+     * Union with another set covering the same box.
+     */
+    VoxelGrid& operator|=(const VoxelGrid& other);
+
+    /*!
+     * Intersection with another set covering the same box.
+     */
+    VoxelGrid& operator&=(const VoxelGrid& other);
+
+    /*!
+     * Difference with another set covering the same box.
+     */
+    VoxelGrid& operator-=(const VoxelGrid& other);
+
+    /*!
+     * Dilate with a kernel.
+     *
+     * The result contains every cell which is one of the kernel offsets away from a cell in this set,
+     * i.e. the same cells as processed by \ref VoxelUtils::dilate for all cells in this set.
+     *
+     * The kernel is applied as one shifted bitwise OR of whole rows for each of its offsets, for all layers of the grid in parallel.
+     *
+     * \param kernel The offset positions relative to each cell
+     * \return The dilated set, covering the same box
+     */
+    VoxelGrid dilate(const DilationKernel& kernel) const;
+
+    /*!
+     * Process all cells in the set at a given height in the grid.
+     *
+     * \param z The grid coordinate of the layer of cells to process
+     * \param process_cell_func Function to perform on each cell
+     */
+    template<typename F>
+    void forEachInLayer(const coord_t z, F&& process_cell_func) const
+    {
+        if (z < min_.z_ || z >= min_.z_ + size_.z_)
+        {
+            return;
+        }
+        for (coord_t y = min_.y_; y < min_.y_ + size_.y_; y++)
+        {
+            const size_t row_idx = rowIndex(y, z);
+            for (size_t word_idx = 0; word_idx < words_per_row_; word_idx++)
+            {
+                for (word_t word = words_[row_idx + word_idx]; word != 0; word &= word - 1)
+                {
+                    const coord_t x = min_.x_ + static_cast<coord_t>(word_idx) * word_bits + std::countr_zero(word);
+                    process_cell_func(GridPoint3(x, y, z));
+                }
+            }
+        }
+    }
+
+    /*!
+     * Process all cells in the set.
+     *
+     * \param process_cell_func Function to perform on each cell
+     */
+    template<typename F>
+    void forEach(F&& process_cell_func) const
+    {
+        for (coord_t z = min_.z_; z < min_.z_ + size_.z_; z++)
+        {
+            forEachInLayer(z, process_cell_func);
+        }
+    }
+
+private:
+    GridPoint3 min_; //!< The lowest cell covered
+    GridPoint3 size_; //!< The number of cells covered in each dimension
+    size_t words_per_row_; //!< The number of words used for one row of cells along the X axis
+    std::vector<word_t> words_; //!< The bits of all rows, ordered by Z and then by Y
+
+    size_t rowIndex(const coord_t y, const coord_t z) const
+    {
+        return (static_cast<size_t>(z - min_.z_) * static_cast<size_t>(size_.y_) + static_cast<size_t>(y - min_.y_)) * words_per_row_;
+    }
+
+    /*!
+     * Bitwise OR a row of cells into another row, after shifting it by a number of cells along the X axis.
+     *
+     * \param src The first word of the row to shift
+     * \param shift The number of cells to shift the row by, towards higher X coordinates when positive
+     * \param[out] dst The first word of the row to OR the shifted row into
+     */
+    void orShiftedRow(const word_t* src, const coord_t shift, word_t* dst) const;
+
+    /*!
+     * Reset the bits beyond the end of each row, which may have been set by shifting rows.
+     */
+    void clearPadding();
+};
+
+} // namespace cura
+
+#endif // UTILS_VOXEL_GRID_H
@@ -107,6 +107,21 @@ public:
      */
     bool walkDilatedPolygons(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const;
 
+    /*!
+     * Process voxels which the line segments of a polygon cross, aligned to be dilated with a kernel afterwards.
+     *
+     * Dilating all processed voxels with the \p kernel, for example using \ref VoxelGrid::dilate, results in the same voxels as processed by \ref walkDilatedPolygons.
+     *
+     * \warning Voxels may be processed multiple times!
+     *
+     * \param polys The polygons to walk
+     * \param z The height at which the polygons occur
+     * \param kernel The kernel which is going to be used for the dilation
+     * \param process_cell_func Function to perform on each voxel cell
+     * \return Whether executing was stopped short as indicated by the \p cell_processing_function
+     */
+    bool walkPolygonsForDilation(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const;
+
 private:
     /*!
      * \warning the \p polys is assumed to be translated by half the cell_size in xy already
@@ -139,6 +154,19 @@ public:
      */
     bool walkDilatedAreas(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const;
 
+    /*!
+     * Process all voxels inside the area of a polygons object, aligned to be dilated with a kernel afterwards.
+     *
+     * Dilating all processed voxels with the \p kernel, for example using \ref VoxelGrid::dilate, results in the same voxels as processed by \ref walkDilatedAreas.
+     *
+     * \param polys The area to fill
+     * \param z The height at which the polygons occur
+     * \param kernel The kernel which is going to be used for the dilation
+     * \param process_cell_func Function to perform on each voxel cell
+     * \return Whether executing was stopped short as indicated by the \p cell_processing_function
+     */
+    bool walkAreasForDilation(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const;
+
     /*!
      * Dilate with a kernel.
      *
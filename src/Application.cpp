@@ -139,6 +139,8 @@ void Application::printHelp() const
     fmt::print("  -e<extruder_nr>\n\tSwitch setting focus to the extruder train with the given number.\n");
     fmt::print("  --next\n\tGenerate gcode for the previously supplied mesh group and append that to \n\tthe gcode of further models for one-at-a-time printing.\n");
     fmt::print("  -o <output_file>\n\tSpecify a file to which to write the generated gcode.\n");
+    fmt::print("  --compile-definitions <bundle_file>\n\tInstead of slicing, write the settings loaded with -j (and -s) for the scene and\n\tits extruders to a binary "
+               "bundle, which can be loaded with -j much faster.\n");
     fmt::print("\n");
     fmt::print("The settings are appended to the last supplied object:\n");
     fmt::print("CuraEngine slice [general settings] \n\t-g [current group settings] \n\t-e0 [extruder train 0 settings] \n\t-l obj_inheriting_from_last_extruder_train.stl [object "
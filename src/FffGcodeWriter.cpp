@@ -71,9 +71,10 @@ std::vector<Duration> FffGcodeWriter::getTotalPrintTimePerFeature()
 
 bool FffGcodeWriter::setTargetFile(const char* filename)
 {
-    output_file.open(filename);
-    if (output_file.is_open())
+    if (output_file_buffer.open(filename))
     {
+        output_file_name = filename;
+        output_file.clear();
         gcode.setOutputStream(&output_file);
         return true;
     }
@@ -83,10 +84,15 @@ bool FffGcodeWriter::setTargetFile(const char* filename)
 void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keeper)
 {
     const size_t start_extruder_nr = getStartExtruder(storage);
+    Scene& scene = Application::getInstance().current_slice_->scene;
+    if (scene.current_mesh_group == scene.mesh_groups.begin() && gcode.isBinaryGCodeSelected() && output_file_buffer.isOpen() && ! output_file_buffer.isBinary())
+    {
+        // The file is opened before the settings are known. Nothing is written to it yet, so open it again to write the encoded g-code as is.
+        output_file_buffer.open(output_file_name.c_str(), true);
+    }
     gcode.preSetup(start_extruder_nr);
     gcode.setSliceUUID(slice_uuid);
 
-    Scene& scene = Application::getInstance().current_slice_->scene;
     if (scene.current_mesh_group == scene.mesh_groups.begin()) // First mesh group.
     {
         gcode.resetTotalPrintTimeAndFilament();
@@ -184,16 +190,49 @@ void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keep
         total_layers,
         [&storage, total_layers, this](int layer_nr)
         {
+            if (layer_nr >= 0)
+            {
+                // Layers are only expanded by the thread that exports them, since only that layer reads the geometry that was compacted.
+                for (std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+                {
+                    if (layer_nr < LayerIndex(mesh->layers.size()))
+                    {
+                        mesh->layers[layer_nr].expand();
+                    }
+                }
+            }
             return std::make_optional(processLayer(storage, layer_nr, total_layers));
         },
-        [this, total_layers](std::optional<ProcessLayerResult> result_opt)
+        [&storage, this, total_layers](std::optional<ProcessLayerResult> result_opt)
         {
             const ProcessLayerResult& result = result_opt.value();
-            Progress::messageProgressLayer(result.layer_plan->getLayerNr(), total_layers, result.total_elapsed_time, result.stages_times);
+            const LayerIndex layer_nr = result.layer_plan->getLayerNr();
+            Progress::messageProgressLayer(layer_nr, total_layers, result.total_elapsed_time, result.stages_times);
+            if (spdlog::should_log(spdlog::level::trace))
+            {
+                spdlog::trace("Layer plan [{}] uses {:.1f} kiB", layer_nr, result.layer_plan->memoryUsage() / 1024.0);
+            }
             layer_plan_buffer.handle(*result.layer_plan, gcode);
+
+            // Exporting a layer reads the layers at most this far below it (to find bridges). Those layers are all done by now, so the lowest one
+            // isn't needed anymore.
+            constexpr LayerIndex::value_type max_layers_looked_down = 3;
+            const LayerIndex release_layer_nr = layer_nr - max_layers_looked_down;
+            if (release_layer_nr >= 0)
+            {
+                for (std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+                {
+                    if (release_layer_nr < LayerIndex(mesh->layers.size()))
+                    {
+                        mesh->layers[release_layer_nr].releaseExportData();
+                    }
+                }
+                storage.releaseLayerOutlines(release_layer_nr);
+            }
         });
 
     layer_plan_buffer.flush();
+    gcode.writePendingPrintTime(); // The estimate of the last layer.
 
     Progress::messageProgressStage(Progress::Stage::FINISH, &time_keeper);
 
@@ -1918,10 +1957,11 @@ bool FffGcodeWriter::processMultiLayerInfill(
             constexpr size_t zag_skip_count = 0;
             const bool fill_gaps = density_idx == 0; // Only fill gaps for the lowest density.
 
-            std::shared_ptr<LightningLayer> lightning_layer = nullptr;
+            std::shared_ptr<const LightningLayer> lightning_layer = nullptr;
             if (mesh.lightning_generator)
             {
-                lightning_layer = std::make_shared<LightningLayer>(mesh.lightning_generator->getTreesForLayer(gcode_layer.getLayerNr()));
+                // Share ownership with the generator instead of copying the trees of the layer.
+                lightning_layer = std::shared_ptr<const LightningLayer>(mesh.lightning_generator, &mesh.lightning_generator->getTreesForLayer(gcode_layer.getLayerNr()));
             }
             Infill infill_comp(
                 infill_pattern,
@@ -2494,10 +2534,10 @@ bool FffGcodeWriter::processSingleLayerInfill(
 
         Shape in_outline = part.infill_area_per_combine_per_density[density_idx][0];
 
-        std::shared_ptr<LightningLayer> lightning_layer;
+        std::shared_ptr<const LightningLayer> lightning_layer;
         if (mesh.lightning_generator)
         {
-            lightning_layer = std::make_shared<LightningLayer>(mesh.lightning_generator->getTreesForLayer(gcode_layer.getLayerNr()));
+            lightning_layer = std::shared_ptr<const LightningLayer>(mesh.lightning_generator, &mesh.lightning_generator->getTreesForLayer(gcode_layer.getLayerNr()));
         }
 
         const bool fill_gaps = density_idx == 0; // Only fill gaps in the lowest infill density pattern.
@@ -3058,7 +3098,7 @@ bool FffGcodeWriter::processInsets(
             // expanded to take into account the overhang angle, the greater the overhang angle, the larger the supported area is
             // considered to be
             const coord_t overhang_width = layer_height * std::tan(overhang_angle / (180 / std::numbers::pi));
-            return part.outline.offset(-half_outer_wall_width).difference(outlines_below.offset(10 + overhang_width - half_outer_wall_width)).offset(10);
+            return part.getOutlineOffset(-half_outer_wall_width)->difference(outlines_below.offset(10 + overhang_width - half_outer_wall_width)).offset(10);
         };
         gcode_layer.setOverhangMask(get_overhang_region(mesh.settings.get<AngleDegrees>("wall_overhang_angle")));
         gcode_layer.setSeamOverhangMask(get_overhang_region(mesh.settings.get<AngleDegrees>("seam_overhang_angle")));
@@ -3079,7 +3119,7 @@ bool FffGcodeWriter::processInsets(
             {
                 if (boundaryBox.hit(layer_part.boundaryBox))
                 {
-                    roofing_mask = roofing_mask.difference(layer_part.outline.offset(-wall_line_width_0 / 4));
+                    roofing_mask = roofing_mask.difference(*layer_part.getOutlineOffset(-wall_line_width_0 / 4));
                 }
             }
             return roofing_mask;
@@ -4420,6 +4460,7 @@ void FffGcodeWriter::finalize()
     }
 
     gcode.writeComment("End of Gcode");
+    gcode.finishBinaryOutput(prefix);
     /*
     the profile string below can be executed since the M25 doesn't end the gcode on an UMO and when printing via USB.
     gcode.writeCode("M25 ;Stop reading from this point on.");
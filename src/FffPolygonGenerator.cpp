@@ -5,6 +5,7 @@
 #include <atomic>
 #include <fstream> // ifstream.good()
 #include <map> // multimap (ordered map allowing duplicate keys)
+#include <mutex>
 #include <numeric>
 
 #include <spdlog/spdlog.h>
@@ -46,6 +47,7 @@
 #include "settings/types/Angle.h"
 #include "settings/types/LayerIndex.h"
 #include "utils/algorithm.h"
+#include "utils/DeterministicRandom.h"
 #include "utils/ThreadPool.h"
 #include "utils/gettime.h"
 #include "utils/math.h"
@@ -198,31 +200,41 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
         return true; // This is NOT an error state!
     }
 
-    std::vector<Slicer*> slicerList;
-    for (unsigned int mesh_idx = 0; mesh_idx < meshgroup->meshes.size(); mesh_idx++)
+    // Check if adaptive layers is populated to prevent accessing a method on NULL
+    std::vector<AdaptiveLayer>* adaptive_layer_height_values = {};
+    if (adaptive_layer_heights != nullptr)
     {
-        // Check if adaptive layers is populated to prevent accessing a method on NULL
-        std::vector<AdaptiveLayer>* adaptive_layer_height_values = {};
-        if (adaptive_layer_heights != nullptr)
-        {
-            adaptive_layer_height_values = adaptive_layer_heights->getLayers();
-        }
-
-        Mesh& mesh = meshgroup->meshes[mesh_idx];
-        Slicer* slicer = new Slicer(&mesh, layer_thickness, slice_layer_count, use_variable_layer_heights, adaptive_layer_height_values);
-
-        slicerList.push_back(slicer);
+        adaptive_layer_height_values = adaptive_layer_heights->getLayers();
+    }
 
-        /*
-        for(SlicerLayer& layer : slicer->layers)
+    // The meshes are sliced concurrently, and each slicer runs its layers in parallel on the same thread pool. Slicing the meshes one after the other
+    // would leave most of the workers waiting at the end of every mesh, if there are many small meshes.
+    std::vector<Slicer*> slicerList(meshgroup->meshes.size(), nullptr);
+    std::mutex progress_mutex;
+    std::atomic<size_t> sliced_mesh_count = 0;
+    cura::parallel_for_adaptive<size_t>(
+        "Slicing",
+        0,
+        meshgroup->meshes.size(),
+        [&](const size_t mesh_idx)
         {
-            //Reporting the outline here slows down the engine quite a bit, so only do so when debugging.
-            sendPolygons("outline", layer_nr, layer.z, layer.polygonList);
-            sendPolygons("openoutline", layer_nr, layer.openPolygonList);
-        }
-        */
+            Mesh& mesh = meshgroup->meshes[mesh_idx];
+            slicerList[mesh_idx] = new Slicer(&mesh, layer_thickness, slice_layer_count, use_variable_layer_heights, adaptive_layer_height_values);
 
-        Progress::messageProgress(Progress::Stage::SLICING, mesh_idx + 1, meshgroup->meshes.size());
+            sliced_mesh_count.fetch_add(1);
+            std::unique_lock<std::mutex> lock(progress_mutex, std::try_to_lock);
+            if (lock)
+            { // Only one thread messages progress at a time. The count is read under the lock, so that the progress never goes backwards.
+                Progress::messageProgress(Progress::Stage::SLICING, sliced_mesh_count.load(), meshgroup->meshes.size());
+            }
+        },
+        [&meshgroup](const size_t mesh_idx)
+        {
+            return meshgroup->meshes[mesh_idx].faces_.size();
+        });
+    if (! meshgroup->meshes.empty())
+    { // The thread that sliced the last mesh may not have gotten the lock to report it.
+        Progress::messageProgress(Progress::Stage::SLICING, meshgroup->meshes.size(), meshgroup->meshes.size());
     }
 
     // Clear the mesh face and vertex data, it is no longer needed after this point, and it saves a lot of memory.
@@ -271,6 +283,7 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
 
     storage.meshes.reserve(
         slicerList.size()); // causes there to be no resize in meshes so that the pointers in sliceMeshStorage._config to retraction_config don't get invalidated.
+    std::vector<std::pair<SliceMeshStorage*, Slicer*>> part_meshes; // The meshes to create layer parts for, once all meshes are added.
     for (unsigned int meshIdx = 0; meshIdx < slicerList.size(); meshIdx++)
     {
         Slicer* slicer = slicerList[meshIdx];
@@ -280,12 +293,7 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
         storage.meshes.push_back(std::make_shared<SliceMeshStorage>(&meshgroup->meshes[meshIdx], slicer->layers.size())); // new mesh in storage had settings from the Mesh
         SliceMeshStorage& meshStorage = *storage.meshes.back();
 
-        // only create layer parts for normal meshes
         const bool is_support_modifier = AreaSupport::handleSupportModifierMesh(storage, mesh.settings_, slicer);
-        if (! is_support_modifier)
-        {
-            createLayerParts(meshStorage, slicer);
-        }
 
         // Do not add and process support _modifier_ meshes further, and ONLY skip support _modifiers_. They have been
         // processed in AreaSupport::handleSupportModifierMesh(), but other helper meshes such as infill meshes are
@@ -293,8 +301,15 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
         if (is_support_modifier && ! mesh.settings_.get<bool>("support_mesh"))
         {
             storage.meshes.pop_back();
+            delete slicerList[meshIdx];
             continue;
         }
+        // only create layer parts for normal meshes
+        part_meshes.emplace_back(&meshStorage, is_support_modifier ? nullptr : slicer);
+        if (is_support_modifier)
+        {
+            delete slicerList[meshIdx];
+        }
 
         // check one if raft offset is needed
         const bool has_raft = mesh_group_settings.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::RAFT;
@@ -336,10 +351,38 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
                 }
             }
         }
+    }
 
-        delete slicerList[meshIdx];
+    // Like the slicing, the layer parts of all meshes are created concurrently.
+    std::atomic<size_t> parts_mesh_count = 0;
+    cura::parallel_for_adaptive<size_t>(
+        "Layer parts of meshes",
+        0,
+        part_meshes.size(),
+        [&](const size_t part_mesh_idx)
+        {
+            auto [mesh_storage, slicer] = part_meshes[part_mesh_idx];
+            if (slicer != nullptr)
+            {
+                createLayerParts(*mesh_storage, slicer);
+                delete slicer;
+            }
 
-        Progress::messageProgress(Progress::Stage::PARTS, meshIdx + 1, slicerList.size());
+            parts_mesh_count.fetch_add(1);
+            std::unique_lock<std::mutex> lock(progress_mutex, std::try_to_lock);
+            if (lock)
+            { // Only one thread messages progress at a time. The count is read under the lock, so that the progress never goes backwards.
+                Progress::messageProgress(Progress::Stage::PARTS, parts_mesh_count.load(), part_meshes.size());
+            }
+        },
+        [&part_meshes](const size_t part_mesh_idx)
+        {
+            const Slicer* slicer = part_meshes[part_mesh_idx].second;
+            return slicer == nullptr ? 0 : slicer->sliced_layer_range.second - slicer->sliced_layer_range.first;
+        });
+    if (! part_meshes.empty())
+    {
+        Progress::messageProgress(Progress::Stage::PARTS, part_meshes.size(), part_meshes.size());
     }
     return true;
 }
@@ -440,6 +483,22 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper&
     spdlog::debug("Processing gradual support");
     // generate gradual support
     AreaSupport::generateSupportInfillFeatures(storage);
+
+    const Settings& scene_settings = Application::getInstance().current_slice_->scene.settings;
+    if ((scene_settings.has("compact_finished_layers") || mesh_group_settings.has("compact_finished_layers")) && mesh_group_settings.get<bool>("compact_finished_layers"))
+    {
+        spdlog::debug("Compacting the finished layers");
+        // The layers are finished, but are only exported later. They are expanded again by the g-code writer, when it exports them.
+        for (std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+        {
+            cura::parallel_for(
+                mesh->layers,
+                [](auto layer_it)
+                {
+                    layer_it->compact();
+                });
+        }
+    }
 }
 
 void FffPolygonGenerator::processBasicWallsSkinInfill(
@@ -492,8 +551,15 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(
         }
     } guarded_progress = { inset_skin_progress_estimate };
 
+    // The layers with many vertices (detailed or with many parts) take much longer than the others.
+    const auto layer_cost = [&mesh](const size_t layer_number)
+    {
+        return mesh.layers[layer_number].outlineVertexCount();
+    };
+
     // walls
-    cura::parallel_for<size_t>(
+    cura::parallel_for_adaptive<size_t>(
+        "Walls",
         0,
         mesh_layer_count,
         [&](size_t layer_number)
@@ -501,7 +567,8 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(
             spdlog::debug("Processing insets for layer {} of {}", layer_number, mesh.layers.size());
             processWalls(mesh, layer_number);
             guarded_progress++;
-        });
+        },
+        layer_cost);
 
     ProgressEstimatorLinear* skin_estimator = new ProgressEstimatorLinear(mesh_layer_count);
     mesh_inset_skin_progress_estimator->nextStage(skin_estimator);
@@ -536,7 +603,8 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(
     }
 
     guarded_progress.reset();
-    cura::parallel_for<size_t>(
+    cura::parallel_for_adaptive<size_t>(
+        "Skins and infill",
         0,
         mesh_layer_count,
         [&](size_t layer_number)
@@ -547,7 +615,8 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(
                 processSkinsAndInfill(mesh, layer_number, process_infill);
             }
             guarded_progress++;
-        });
+        },
+        layer_cost);
 }
 
 void FffPolygonGenerator::processInfillMesh(SliceDataStorage& storage, const size_t mesh_order_idx, const std::vector<size_t>& mesh_order)
@@ -815,6 +884,7 @@ void FffPolygonGenerator::removeEmptyFirstLayers(SliceDataStorage& storage, size
         storage.support.layer_nr_max_filled_layer -= n_empty_first_layers;
         std::vector<SupportLayer>& support_layers = storage.support.supportLayers;
         support_layers.erase(support_layers.begin(), support_layers.begin() + n_empty_first_layers);
+        storage.invalidateLayerOutlines(); // The layer numbers changed.
     }
 }
 
@@ -954,18 +1024,25 @@ void FffPolygonGenerator::processOozeShield(SliceDataStorage& storage)
 
     const coord_t ooze_shield_dist = mesh_group_settings.get<coord_t>("ooze_shield_dist");
 
-    for (int layer_nr = 0; layer_nr <= storage.max_print_height_second_to_last_extruder; layer_nr++)
-    {
-        constexpr bool around_support = true;
-        constexpr bool around_prime_tower = false;
-        storage.ooze_shield.push_back(storage.getLayerOutlines(layer_nr, around_support, around_prime_tower).offset(ooze_shield_dist, ClipperLib::jtRound).getOutsidePolygons());
-    }
+    const size_t shield_layer_count = std::max(0, storage.max_print_height_second_to_last_extruder + 1);
+    storage.ooze_shield.resize(shield_layer_count);
+    cura::parallel_for<size_t>(
+        0,
+        shield_layer_count,
+        [&](const size_t layer_nr)
+        {
+            constexpr bool around_support = true;
+            constexpr bool around_prime_tower = false;
+            storage.ooze_shield[layer_nr]
+                = storage.getLayerOutlines(layer_nr, around_support, around_prime_tower).offset(ooze_shield_dist, ClipperLib::jtRound).getOutsidePolygons();
+        });
 
     const AngleDegrees angle = mesh_group_settings.get<AngleDegrees>("ooze_shield_angle");
     if (angle <= 89)
     {
         const coord_t allowed_angle_offset
             = tan(mesh_group_settings.get<AngleRadians>("ooze_shield_angle")) * mesh_group_settings.get<coord_t>("layer_height"); // Allow for a 60deg angle in the oozeShield.
+        // Each layer depends on the result of the previous one, and an inset of a union is not the union of the insets, so this can't be split up.
         for (LayerIndex layer_nr = 1; layer_nr <= storage.max_print_height_second_to_last_extruder; layer_nr++)
         {
             storage.ooze_shield[layer_nr] = storage.ooze_shield[layer_nr].unionPolygons(storage.ooze_shield[layer_nr - 1].offset(-allowed_angle_offset));
@@ -977,28 +1054,30 @@ void FffPolygonGenerator::processOozeShield(SliceDataStorage& storage)
     }
 
     const double largest_printed_area = 1.0; // TODO: make var a parameter, and perhaps even a setting?
-    for (LayerIndex layer_nr = 0; layer_nr <= storage.max_print_height_second_to_last_extruder; layer_nr++)
-    {
-        storage.ooze_shield[layer_nr].removeSmallAreas(largest_printed_area);
-    }
+    coord_t max_line_width = 0;
     if (storage.prime_tower_)
-    {
-        coord_t max_line_width = 0;
-        { // compute max_line_width
-            const std::vector<bool> extruder_is_used = storage.getExtrudersUsed();
-            const auto& extruders = Application::getInstance().current_slice_->scene.extruders;
-            for (int extruder_nr = 0; extruder_nr < int(extruders.size()); extruder_nr++)
-            {
-                if (! extruder_is_used[extruder_nr])
-                    continue;
-                max_line_width = std::max(max_line_width, extruders[extruder_nr].settings_.get<coord_t>("skirt_brim_line_width"));
-            }
-        }
-        for (LayerIndex layer_nr = 0; layer_nr <= storage.max_print_height_second_to_last_extruder; layer_nr++)
+    { // compute max_line_width
+        const std::vector<bool> extruder_is_used = storage.getExtrudersUsed();
+        const auto& extruders = Application::getInstance().current_slice_->scene.extruders;
+        for (int extruder_nr = 0; extruder_nr < int(extruders.size()); extruder_nr++)
         {
-            storage.ooze_shield[layer_nr] = storage.ooze_shield[layer_nr].difference(storage.prime_tower_->getOccupiedOutline(layer_nr).offset(max_line_width / 2));
+            if (! extruder_is_used[extruder_nr])
+                continue;
+            max_line_width = std::max(max_line_width, extruders[extruder_nr].settings_.get<coord_t>("skirt_brim_line_width"));
         }
     }
+    cura::parallel_for<size_t>(
+        0,
+        shield_layer_count,
+        [&](const size_t layer_nr)
+        {
+            Shape& ooze_shield = storage.ooze_shield[layer_nr];
+            ooze_shield.removeSmallAreas(largest_printed_area);
+            if (storage.prime_tower_)
+            {
+                ooze_shield = std::move(ooze_shield).difference(storage.prime_tower_->getOccupiedOutline(layer_nr).offset(max_line_width / 2));
+            }
+        });
 }
 
 void FffPolygonGenerator::processDraftShield(SliceDataStorage& storage)
@@ -1011,15 +1090,26 @@ void FffPolygonGenerator::processDraftShield(SliceDataStorage& storage)
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const coord_t layer_height = mesh_group_settings.get<coord_t>("layer_height");
 
-    const LayerIndex layer_skip{ 500 / layer_height + 1 };
+    const size_t layer_skip = 500 / layer_height + 1;
 
-    Shape& draft_shield = storage.draft_protection_shield;
-    for (LayerIndex layer_nr = 0; layer_nr < storage.print_layer_count && layer_nr < draft_shield_layers; layer_nr += layer_skip)
+    // Get the outlines of the sampled layers concurrently, then unite them all at once.
+    const size_t sampled_layer_count = (std::min(storage.print_layer_count, draft_shield_layers) + layer_skip - 1) / layer_skip;
+    std::vector<Shape> sampled_outlines(sampled_layer_count);
+    cura::parallel_for<size_t>(
+        0,
+        sampled_layer_count,
+        [&](const size_t sample_idx)
+        {
+            constexpr bool around_support = true;
+            constexpr bool around_prime_tower = false;
+            sampled_outlines[sample_idx] = storage.getLayerOutlines(sample_idx * layer_skip, around_support, around_prime_tower);
+        });
+    Shape draft_shield;
+    for (Shape& outlines : sampled_outlines)
     {
-        constexpr bool around_support = true;
-        constexpr bool around_prime_tower = false;
-        draft_shield = draft_shield.unionPolygons(storage.getLayerOutlines(layer_nr, around_support, around_prime_tower));
+        draft_shield.push_back(std::move(outlines));
     }
+    draft_shield = draft_shield.unionPolygons();
 
     const coord_t draft_shield_dist = mesh_group_settings.get<coord_t>("draft_shield_dist");
     storage.draft_protection_shield = draft_shield.approxConvexHull(draft_shield_dist);
@@ -1087,113 +1177,112 @@ void FffPolygonGenerator::processFuzzyWalls(SliceMeshStorage& mesh)
     const coord_t avg_dist_between_points = mesh.settings.get<coord_t>("magic_fuzzy_skin_point_dist");
     const coord_t min_dist_between_points = avg_dist_between_points * 3 / 4; // hardcoded: the point distance may vary between 3/4 and 5/4 the supplied value
     const coord_t range_random_point_dist = avg_dist_between_points / 2;
-    unsigned int start_layer_nr
+    const size_t start_layer_nr
         = (mesh.settings.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::BRIM) ? 1 : 0; // don't make fuzzy skin on first layer if there's a brim
 
-    auto hole_area = Shape();
-    std::function<bool(const bool&, const ExtrusionJunction&)> accumulate_is_in_hole
-        = []([[maybe_unused]] const bool& prev_result, [[maybe_unused]] const ExtrusionJunction& junction)
-    {
-        return false;
-    };
-
-    for (LayerIndex layer_nr = start_layer_nr; layer_nr < mesh.layers.size(); layer_nr++)
-    {
-        SliceLayer& layer = mesh.layers[layer_nr];
-        for (SliceLayerPart& part : layer.parts)
+    cura::parallel_for<size_t>(
+        start_layer_nr,
+        mesh.layers.size(),
+        [&](const size_t layer_nr)
         {
-            std::vector<VariableWidthLines> result_paths;
-            for (auto& toolpath : part.wall_toolpaths)
+            // Seeded by the layer, so that the result doesn't depend on the order in which the layers are processed.
+            DeterministicRandom random(layer_nr);
+            SliceLayer& layer = mesh.layers[layer_nr];
+            for (SliceLayerPart& part : layer.parts)
             {
-                if (toolpath.front().inset_idx_ != 0)
-                {
-                    result_paths.push_back(toolpath);
-                    continue;
-                }
-
-                auto& result_lines = result_paths.emplace_back();
-
-                if (apply_outside_only)
-                {
-                    hole_area = part.print_outline.getOutsidePolygons().offset(-line_width);
-                    accumulate_is_in_hole = [&hole_area](const bool& prev_result, const ExtrusionJunction& junction)
-                    {
-                        return prev_result || hole_area.inside(junction.p_);
-                    };
-                }
-                for (auto& line : toolpath)
+                std::vector<VariableWidthLines> result_paths;
+                for (auto& toolpath : part.wall_toolpaths)
                 {
-                    if (apply_outside_only && std::accumulate(line.begin(), line.end(), false, accumulate_is_in_hole))
+                    if (toolpath.front().inset_idx_ != 0)
                     {
-                        result_lines.push_back(line);
+                        result_paths.push_back(toolpath);
                         continue;
                     }
 
-                    auto& result = result_lines.emplace_back(line.inset_idx_, line.is_odd_, line.is_closed_);
+                    auto& result_lines = result_paths.emplace_back();
 
-                    // generate points in between p0 and p1
-                    int64_t dist_left_over
-                        = (min_dist_between_points / 4) + rand() % (min_dist_between_points / 4); // the distance to be traversed on the line before making the first new point
-                    auto* p0 = &line.front();
-                    for (auto& p1 : line)
+                    Shape hole_area;
+                    if (apply_outside_only)
+                    {
+                        hole_area = part.print_outline.getOutsidePolygons().offset(-line_width);
+                    }
+                    const auto accumulate_is_in_hole = [&hole_area](const bool& prev_result, const ExtrusionJunction& junction)
+                    {
+                        return prev_result || hole_area.inside(junction.p_);
+                    };
+                    for (auto& line : toolpath)
                     {
-                        if (p0->p_ == p1.p_) // avoid seams
+                        if (apply_outside_only && std::accumulate(line.begin(), line.end(), false, accumulate_is_in_hole))
                         {
-                            result.emplace_back(p1.p_, p1.w_, p1.perimeter_index_);
+                            result_lines.push_back(line);
                             continue;
                         }
 
-                        // 'a' is the (next) new point between p0 and p1
-                        const Point2LL p0p1 = p1.p_ - p0->p_;
-                        const int64_t p0p1_size = vSize(p0p1);
-                        int64_t p0pa_dist = dist_left_over;
-                        if (p0pa_dist >= p0p1_size)
+                        auto& result = result_lines.emplace_back(line.inset_idx_, line.is_odd_, line.is_closed_);
+
+                        // generate points in between p0 and p1
+                        int64_t dist_left_over
+                            = (min_dist_between_points / 4) + random.below(min_dist_between_points / 4); // the distance to be traversed on the line before making the first new point
+                        auto* p0 = &line.front();
+                        for (auto& p1 : line)
                         {
-                            const Point2LL p = p1.p_ - (p0p1 / 2);
-                            const double width = (p1.w_ * vSize(p1.p_ - p) + p0->w_ * vSize(p0->p_ - p)) / p0p1_size;
-                            result.emplace_back(p, width, p1.perimeter_index_);
+                            if (p0->p_ == p1.p_) // avoid seams
+                            {
+                                result.emplace_back(p1.p_, p1.w_, p1.perimeter_index_);
+                                continue;
+                            }
+
+                            // 'a' is the (next) new point between p0 and p1
+                            const Point2LL p0p1 = p1.p_ - p0->p_;
+                            const int64_t p0p1_size = vSize(p0p1);
+                            int64_t p0pa_dist = dist_left_over;
+                            if (p0pa_dist >= p0p1_size)
+                            {
+                                const Point2LL p = p1.p_ - (p0p1 / 2);
+                                const double width = (p1.w_ * vSize(p1.p_ - p) + p0->w_ * vSize(p0->p_ - p)) / p0p1_size;
+                                result.emplace_back(p, width, p1.perimeter_index_);
+                            }
+                            for (; p0pa_dist < p0p1_size; p0pa_dist += min_dist_between_points + random.below(range_random_point_dist))
+                            {
+                                const coord_t r = random.below(fuzziness * 2) - fuzziness;
+                                const Point2LL perp_to_p0p1 = turn90CCW(p0p1);
+                                const Point2LL fuzz = normal(perp_to_p0p1, r);
+                                const Point2LL pa = p0->p_ + normal(p0p1, p0pa_dist);
+                                const double width = (p1.w_ * vSize(p1.p_ - pa) + p0->w_ * vSize(p0->p_ - pa)) / p0p1_size;
+                                result.emplace_back(pa + fuzz, width, p1.perimeter_index_);
+                            }
+                            // p0pa_dist > p0p1_size now because we broke out of the for-loop
+                            dist_left_over = p0pa_dist - p0p1_size;
+
+                            p0 = &p1;
                         }
-                        for (; p0pa_dist < p0p1_size; p0pa_dist += min_dist_between_points + rand() % range_random_point_dist)
+                        while (result.size() < 3)
                         {
-                            const int r = rand() % (fuzziness * 2) - fuzziness;
-                            const Point2LL perp_to_p0p1 = turn90CCW(p0p1);
-                            const Point2LL fuzz = normal(perp_to_p0p1, r);
-                            const Point2LL pa = p0->p_ + normal(p0p1, p0pa_dist);
-                            const double width = (p1.w_ * vSize(p1.p_ - pa) + p0->w_ * vSize(p0->p_ - pa)) / p0p1_size;
-                            result.emplace_back(pa + fuzz, width, p1.perimeter_index_);
+                            size_t point_idx = line.size() - 2;
+                            result.emplace_back(line[point_idx].p_, line[point_idx].w_, line[point_idx].perimeter_index_);
+                            if (point_idx == 0)
+                            {
+                                break;
+                            }
+                            point_idx--;
                         }
-                        // p0pa_dist > p0p1_size now because we broke out of the for-loop
-                        dist_left_over = p0pa_dist - p0p1_size;
-
-                        p0 = &p1;
-                    }
-                    while (result.size() < 3)
-                    {
-                        size_t point_idx = line.size() - 2;
-                        result.emplace_back(line[point_idx].p_, line[point_idx].w_, line[point_idx].perimeter_index_);
-                        if (point_idx == 0)
+                        if (result.size() < 3)
                         {
-                            break;
+                            result.clear();
+                            for (auto& p : line)
+                            {
+                                result.emplace_back(p.p_, p.w_, p.perimeter_index_);
+                            }
                         }
-                        point_idx--;
-                    }
-                    if (result.size() < 3)
-                    {
-                        result.clear();
-                        for (auto& p : line)
+                        if (line.back().p_ == line.front().p_) // avoid seams
                         {
-                            result.emplace_back(p.p_, p.w_, p.perimeter_index_);
+                            result.back().p_ = result.front().p_;
                         }
                     }
-                    if (line.back().p_ == line.front().p_) // avoid seams
-                    {
-                        result.back().p_ = result.front().p_;
-                    }
                 }
+                part.wall_toolpaths = result_paths;
             }
-            part.wall_toolpaths = result_paths;
-        }
-    }
+        });
 }
 
 
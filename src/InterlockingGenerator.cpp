@@ -5,16 +5,14 @@
 
 #include <algorithm> // max
 
-#include <range/v3/view/enumerate.hpp>
-#include <range/v3/view/iota.hpp>
-#include <range/v3/view/view.hpp>
-#include <range/v3/view/zip.hpp>
-
 #include "Application.h"
 #include "Slice.h"
 #include "geometry/PointMatrix.h"
 #include "settings/types/LayerIndex.h"
 #include "slicer.h"
+#include "utils/AABB.h"
+#include "utils/ThreadPool.h"
+#include "utils/VoxelGrid.h"
 #include "utils/VoxelUtils.h"
 #include "utils/polygonUtils.h"
 
@@ -90,7 +88,7 @@ std::pair<Shape, Shape> InterlockingGenerator::growBorderAreasPerpendicular(cons
     return { from_border_a, from_border_b };
 }
 
-void InterlockingGenerator::handleThinAreas(const std::unordered_set<GridPoint3>& has_all_meshes) const
+void InterlockingGenerator::handleThinAreas(const VoxelGrid& has_all_meshes) const
 {
     Settings& global_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     const coord_t boundary_avoidance = global_settings.get<int>("interlocking_boundary_avoidance");
@@ -104,69 +102,64 @@ void InterlockingGenerator::handleThinAreas(const std::unordered_set<GridPoint3>
     const coord_t expand = (max_beam_width * number_of_beams_expand) + rounding_errors;
     const coord_t close_gaps = std::min(mesh_a_.mesh->settings_.get<coord_t>("line_width"), mesh_b_.mesh->settings_.get<coord_t>("line_width")) / 4;
 
-    // Make an inclusionary polygon, to only actually handle thin areas near actual microstructures (so not in skin for example).
-    std::vector<Shape> near_interlock_per_layer;
-    near_interlock_per_layer.assign(std::min(mesh_a_.layers.size(), mesh_b_.layers.size()), Shape());
-    for (const auto& cell : has_all_meshes)
-    {
-        const Point3LL bottom_corner = vu_.toLowerCorner(cell);
-        for (coord_t layer_nr = bottom_corner.z_; layer_nr < bottom_corner.z_ + cell_size_.z_ && layer_nr < static_cast<coord_t>(near_interlock_per_layer.size()); ++layer_nr)
+    // Only alter layers when they are present in both meshes.
+    const size_t layer_count = std::min(mesh_a_.layers.size(), mesh_b_.layers.size());
+    cura::parallel_for<size_t>(
+        0,
+        layer_count,
+        [&](const size_t layer_nr)
         {
-            near_interlock_per_layer[static_cast<size_t>(layer_nr)].push_back(vu_.toPolygon(cell));
-        }
-    }
-    for (auto& near_interlock : near_interlock_per_layer)
-    {
-        near_interlock = near_interlock.offset(rounding_errors).offset(-rounding_errors).unionPolygons().offset(detect);
-        near_interlock.applyMatrix(rotation_.inverse());
-    }
-
-    // Only alter layers when they are present in both meshes, zip should take care if that.
-    for (auto [layer_nr, layer] : ranges::views::zip(mesh_a_.layers, mesh_b_.layers) | ranges::views::enumerate)
-    {
-        Shape& polys_a = std::get<0>(layer).polygons_;
-        Shape& polys_b = std::get<1>(layer).polygons_;
-
-        const auto [from_border_a, from_border_b] = growBorderAreasPerpendicular(polys_a, polys_b, detect);
-
-        // Get the areas of each mesh that are _not_ thin (large), by performing a morphological open.
-        const Shape large_a{ polys_a.offset(-detect).offset(detect) };
-        const Shape large_b{ polys_b.offset(-detect).offset(detect) };
-
-        // Derive the area that the thin areas need to expand into (so the added areas to the thin strips) from the information we already have.
-        const Shape thin_expansion_a{
-            large_b.intersection(polys_a.difference(large_a).offset(expand)).intersection(near_interlock_per_layer[layer_nr]).intersection(from_border_a).offset(rounding_errors)
-        };
-        const Shape thin_expansion_b{
-            large_a.intersection(polys_b.difference(large_b).offset(expand)).intersection(near_interlock_per_layer[layer_nr]).intersection(from_border_b).offset(rounding_errors)
-        };
-
-        // Expanded thin areas of the opposing polygon should 'eat into' the larger areas of the polygon,
-        // and conversely, add the expansions to their own thin areas.
-        polys_a = polys_a.unionPolygons(thin_expansion_a).difference(thin_expansion_b).offset(close_gaps).offset(-close_gaps);
-        polys_b = polys_b.unionPolygons(thin_expansion_b).difference(thin_expansion_a).offset(close_gaps).offset(-close_gaps);
-    }
+            // Make an inclusionary polygon, to only actually handle thin areas near actual microstructures (so not in skin for example).
+            Shape near_interlock;
+            has_all_meshes.forEachInLayer(
+                vu_.toGridCoord(static_cast<coord_t>(layer_nr), 2),
+                [&](const GridPoint3& cell)
+                {
+                    near_interlock.push_back(vu_.toPolygon(cell));
+                });
+            near_interlock = near_interlock.offset(rounding_errors).offset(-rounding_errors).unionPolygons().offset(detect);
+            near_interlock.applyMatrix(rotation_.inverse());
+
+            Shape& polys_a = mesh_a_.layers[layer_nr].polygons_;
+            Shape& polys_b = mesh_b_.layers[layer_nr].polygons_;
+
+            const auto [from_border_a, from_border_b] = growBorderAreasPerpendicular(polys_a, polys_b, detect);
+
+            // Get the areas of each mesh that are _not_ thin (large), by performing a morphological open.
+            const Shape large_a{ polys_a.offset(-detect).offset(detect) };
+            const Shape large_b{ polys_b.offset(-detect).offset(detect) };
+
+            // Derive the area that the thin areas need to expand into (so the added areas to the thin strips) from the information we already have.
+            const Shape thin_expansion_a{
+                large_b.intersection(polys_a.difference(large_a).offset(expand)).intersection(near_interlock).intersection(from_border_a).offset(rounding_errors)
+            };
+            const Shape thin_expansion_b{
+                large_a.intersection(polys_b.difference(large_b).offset(expand)).intersection(near_interlock).intersection(from_border_b).offset(rounding_errors)
+            };
+
+            // Expanded thin areas of the opposing polygon should 'eat into' the larger areas of the polygon,
+            // and conversely, add the expansions to their own thin areas.
+            polys_a = polys_a.unionPolygons(thin_expansion_a).difference(thin_expansion_b).offset(close_gaps).offset(-close_gaps);
+            polys_b = polys_b.unionPolygons(thin_expansion_b).difference(thin_expansion_a).offset(close_gaps).offset(-close_gaps);
+        });
 }
 
 void InterlockingGenerator::generateInterlockingStructure() const
 {
-    std::vector<std::unordered_set<GridPoint3>> voxels_per_mesh = getShellVoxels(interface_dilation_);
+    const std::vector<Shape> layer_regions = computeUnionedVolumeRegions();
+    const VoxelGrid empty_grid = createEmptyGrid(layer_regions);
 
-    std::unordered_set<GridPoint3>& has_any_mesh = voxels_per_mesh[0];
-    std::unordered_set<GridPoint3>& has_all_meshes = voxels_per_mesh[1];
-    has_any_mesh.merge(has_all_meshes); // perform union and intersection simultaneously. Cannibalizes voxels_per_mesh
+    std::vector<VoxelGrid> voxels_per_mesh = getShellVoxels(interface_dilation_, empty_grid);
 
-    const std::vector<Shape> layer_regions = computeUnionedVolumeRegions();
+    VoxelGrid& has_all_meshes = voxels_per_mesh[0];
+    has_all_meshes &= voxels_per_mesh[1];
 
     if (air_filtering_)
     {
-        std::unordered_set<GridPoint3> air_cells;
+        VoxelGrid air_cells = empty_grid;
         addBoundaryCells(layer_regions, air_dilation_, air_cells);
 
-        for (const GridPoint3& p : air_cells)
-        {
-            has_all_meshes.erase(p);
-        }
+        has_all_meshes -= air_cells;
 
         handleThinAreas(has_all_meshes);
     }
@@ -174,23 +167,26 @@ void InterlockingGenerator::generateInterlockingStructure() const
     applyMicrostructureToOutlines(has_all_meshes, layer_regions);
 }
 
-std::vector<std::unordered_set<GridPoint3>> InterlockingGenerator::getShellVoxels(const DilationKernel& kernel) const
+std::vector<VoxelGrid> InterlockingGenerator::getShellVoxels(const DilationKernel& kernel, const VoxelGrid& empty_grid) const
 {
-    std::vector<std::unordered_set<GridPoint3>> voxels_per_mesh(2);
+    std::vector<VoxelGrid> voxels_per_mesh(2, empty_grid);
 
     // mark all cells which contain some boundary
     for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
     {
         Slicer* mesh = (mesh_idx == 0) ? &mesh_a_ : &mesh_b_;
-        std::unordered_set<GridPoint3>& mesh_voxels = voxels_per_mesh[mesh_idx];
+        VoxelGrid& mesh_voxels = voxels_per_mesh[mesh_idx];
 
         std::vector<Shape> rotated_polygons_per_layer(mesh->layers.size());
-        for (size_t layer_nr = 0; layer_nr < mesh->layers.size(); layer_nr++)
-        {
-            SlicerLayer& layer = mesh->layers[layer_nr];
-            rotated_polygons_per_layer[layer_nr] = layer.polygons_;
-            rotated_polygons_per_layer[layer_nr].applyMatrix(rotation_);
-        }
+        cura::parallel_for<size_t>(
+            0,
+            mesh->layers.size(),
+            [&](const size_t layer_nr)
+            {
+                SlicerLayer& layer = mesh->layers[layer_nr];
+                rotated_polygons_per_layer[layer_nr] = layer.polygons_;
+                rotated_polygons_per_layer[layer_nr].applyMatrix(rotation_);
+            });
 
         addBoundaryCells(rotated_polygons_per_layer, kernel, mesh_voxels);
     }
@@ -198,26 +194,45 @@ std::vector<std::unordered_set<GridPoint3>> InterlockingGenerator::getShellVoxel
     return voxels_per_mesh;
 }
 
-void InterlockingGenerator::addBoundaryCells(const std::vector<Shape>& layers, const DilationKernel& kernel, std::unordered_set<GridPoint3>& cells) const
+void InterlockingGenerator::addBoundaryCells(const std::vector<Shape>& layers, const DilationKernel& kernel, VoxelGrid& cells) const
 {
-    auto voxel_emplacer = [&cells](GridPoint3 p)
-    {
-        cells.emplace(p);
-        return true;
-    };
+    // Neighboring cells share their storage in the grid, so each layer collects its cells separately before they are inserted.
+    std::vector<std::vector<GridPoint3>> cells_per_layer(layers.size());
+    cura::parallel_for<size_t>(
+        0,
+        layers.size(),
+        [&](const size_t layer_nr)
+        {
+            std::vector<GridPoint3>& layer_cells = cells_per_layer[layer_nr];
+            auto voxel_emplacer = [&layer_cells](GridPoint3 p)
+            {
+                if (layer_cells.empty() || layer_cells.back() != p) // consecutive line segments often start in the same cell
+                {
+                    layer_cells.emplace_back(p);
+                }
+                return true;
+            };
+
+            const coord_t z = static_cast<coord_t>(layer_nr);
+            vu_.walkPolygonsForDilation(layers[layer_nr], z, kernel, voxel_emplacer);
+            Shape skin = layers[layer_nr];
+            if (layer_nr > 0)
+            {
+                skin = skin.xorPolygons(layers[layer_nr - 1]);
+            }
+            skin = skin.offset(-cell_size_.x_ / 2).offset(cell_size_.x_ / 2); // remove superfluous small areas, which would anyway be included because of walkPolygons
+            vu_.walkAreasForDilation(skin, z, kernel, voxel_emplacer);
+        });
 
-    for (size_t layer_nr = 0; layer_nr < layers.size(); layer_nr++)
+    VoxelGrid boundary_cells(cells.min(), cells.max());
+    for (const std::vector<GridPoint3>& layer_cells : cells_per_layer)
     {
-        const coord_t z = static_cast<coord_t>(layer_nr);
-        vu_.walkDilatedPolygons(layers[layer_nr], z, kernel, voxel_emplacer);
-        Shape skin = layers[layer_nr];
-        if (layer_nr > 0)
+        for (const GridPoint3& p : layer_cells)
         {
-            skin = skin.xorPolygons(layers[layer_nr - 1]);
+            boundary_cells.insert(p);
         }
-        skin = skin.offset(-cell_size_.x_ / 2).offset(cell_size_.x_ / 2); // remove superfluous small areas, which would anyway be included because of walkPolygons
-        vu_.walkDilatedAreas(skin, z, kernel, voxel_emplacer);
     }
+    cells |= boundary_cells.dilate(kernel);
 }
 
 std::vector<Shape> InterlockingGenerator::computeUnionedVolumeRegions() const
@@ -225,24 +240,51 @@ std::vector<Shape> InterlockingGenerator::computeUnionedVolumeRegions() const
     const size_t max_layer_count = std::max(mesh_a_.layers.size(), mesh_b_.layers.size()) + 1; // introduce ghost layer on top for correct skin computation of topmost layer.
     std::vector<Shape> layer_regions(max_layer_count);
 
-    for (LayerIndex layer_nr = 0; layer_nr < max_layer_count; layer_nr++)
-    {
-        Shape& layer_region = layer_regions[static_cast<size_t>(layer_nr)];
-        for (Slicer* mesh : { &mesh_a_, &mesh_b_ })
+    cura::parallel_for<size_t>(
+        0,
+        max_layer_count,
+        [&](const size_t layer_nr)
         {
-            if (layer_nr >= mesh->layers.size())
+            Shape& layer_region = layer_regions[layer_nr];
+            for (Slicer* mesh : { &mesh_a_, &mesh_b_ })
             {
-                break;
+                if (layer_nr >= mesh->layers.size())
+                {
+                    break;
+                }
+                const SlicerLayer& layer = mesh->layers[layer_nr];
+                layer_region.push_back(layer.polygons_);
             }
-            const SlicerLayer& layer = mesh->layers[static_cast<size_t>(layer_nr)];
-            layer_region.push_back(layer.polygons_);
-        }
-        layer_region = layer_region.offset(ignored_gap_).offset(-ignored_gap_); // Morphological close to merge meshes into single volume
-        layer_region.applyMatrix(rotation_);
-    }
+            layer_region = layer_region.offset(ignored_gap_).offset(-ignored_gap_); // Morphological close to merge meshes into single volume
+            layer_region.applyMatrix(rotation_);
+        });
     return layer_regions;
 }
 
+VoxelGrid InterlockingGenerator::createEmptyGrid(const std::vector<Shape>& layer_regions) const
+{
+    AABB bounding_box;
+    for (const Shape& layer_region : layer_regions)
+    {
+        bounding_box.include(AABB(layer_region));
+    }
+    if (bounding_box.min_.X > bounding_box.max_.X)
+    {
+        return VoxelGrid(GridPoint3(0, 0, 0), GridPoint3(-1, -1, -1));
+    }
+
+    // The walks are offset by up to a cell to align them with the kernels, after which the kernels extend them further.
+    coord_t kernel_margin = 0;
+    for (const DilationKernel* kernel : { &interface_dilation_, &air_dilation_ })
+    {
+        kernel_margin = std::max({ kernel_margin, kernel->kernel_size_.x_, kernel->kernel_size_.y_, kernel->kernel_size_.z_ });
+    }
+    const GridPoint3 margin = GridPoint3(1, 1, 1) * (kernel_margin + 1);
+    const GridPoint3 min = vu_.toGridPoint(Point3LL(bounding_box.min_.X, bounding_box.min_.Y, 0)) - margin;
+    const GridPoint3 max = vu_.toGridPoint(Point3LL(bounding_box.max_.X, bounding_box.max_.Y, static_cast<coord_t>(layer_regions.size()))) + margin;
+    return VoxelGrid(min, max);
+}
+
 std::vector<std::vector<Shape>> InterlockingGenerator::generateMicrostructure() const
 {
     std::vector<std::vector<Shape>> cell_area_per_mesh_per_layer;
@@ -276,7 +318,7 @@ std::vector<std::vector<Shape>> InterlockingGenerator::generateMicrostructure()
     return cell_area_per_mesh_per_layer;
 }
 
-void InterlockingGenerator::applyMicrostructureToOutlines(const std::unordered_set<GridPoint3>& cells, const std::vector<Shape>& layer_regions) const
+void InterlockingGenerator::applyMicrostructureToOutlines(const VoxelGrid& cells, const std::vector<Shape>& layer_regions) const
 {
     std::vector<std::vector<Shape>> cell_area_per_mesh_per_layer = generateMicrostructure();
 
@@ -293,51 +335,53 @@ void InterlockingGenerator::applyMicrostructureToOutlines(const std::unordered_s
     structure_per_layer[1].resize(num_interlocking_layers);
 
     // Only compute cell structure for half the layers, because since our beams are two layers high, every odd layer of the structure will be the same as the layer below.
-    for (const GridPoint3& grid_loc : cells)
-    {
-        Point3LL bottom_corner = vu_.toLowerCorner(grid_loc);
-        for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
+    cura::parallel_for<size_t>(
+        0,
+        num_interlocking_layers,
+        [&](const size_t interlocking_layer_nr)
         {
-            for (LayerIndex layer_nr = bottom_corner.z_; layer_nr < bottom_corner.z_ + cell_size_.z_ && layer_nr < max_layer_count; layer_nr += beam_layer_count_)
+            const coord_t layer_nr = static_cast<coord_t>(interlocking_layer_nr) * beam_layer_count_;
+            const std::vector<Shape>& cell_area_per_mesh = cell_area_per_mesh_per_layer[interlocking_layer_nr % cell_area_per_mesh_per_layer.size()];
+            cells.forEachInLayer(
+                vu_.toGridCoord(layer_nr, 2),
+                [&](const GridPoint3& grid_loc)
+                {
+                    const Point3LL bottom_corner = vu_.toLowerCorner(grid_loc);
+                    for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
+                    {
+                        Shape areas_here = cell_area_per_mesh[mesh_idx];
+                        areas_here.translate(Point2LL(bottom_corner.x_, bottom_corner.y_));
+                        structure_per_layer[mesh_idx][interlocking_layer_nr].push_back(areas_here);
+                    }
+                });
+
+            for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
             {
-                Shape areas_here = cell_area_per_mesh_per_layer[static_cast<size_t>(layer_nr / beam_layer_count_) % cell_area_per_mesh_per_layer.size()][mesh_idx];
-                areas_here.translate(Point2LL(bottom_corner.x_, bottom_corner.y_));
-                structure_per_layer[mesh_idx][static_cast<size_t>(layer_nr / beam_layer_count_)].push_back(areas_here);
+                Shape& layer_structure = structure_per_layer[mesh_idx][interlocking_layer_nr];
+                layer_structure = layer_structure.unionPolygons();
+                layer_structure.applyMatrix(unapply_rotation);
             }
-        }
-    }
-
-    for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
-    {
-        for (size_t layer_nr = 0; layer_nr < structure_per_layer[mesh_idx].size(); layer_nr++)
-        {
-            Shape& layer_structure = structure_per_layer[mesh_idx][layer_nr];
-            layer_structure = layer_structure.unionPolygons();
-            layer_structure.applyMatrix(unapply_rotation);
-        }
-    }
+        });
 
     for (size_t mesh_idx = 0; mesh_idx < 2; mesh_idx++)
     {
         Slicer* mesh = (mesh_idx == 0) ? &mesh_a_ : &mesh_b_;
-        for (size_t layer_nr = 0; layer_nr < max_layer_count; layer_nr++)
-        {
-            if (layer_nr >= mesh->layers.size())
+        cura::parallel_for<size_t>(
+            0,
+            std::min(max_layer_count, mesh->layers.size()),
+            [&](const size_t layer_nr)
             {
-                break;
-            }
+                Shape layer_outlines = layer_regions[layer_nr];
+                layer_outlines.applyMatrix(unapply_rotation);
 
-            Shape layer_outlines = layer_regions[layer_nr];
-            layer_outlines.applyMatrix(unapply_rotation);
+                const Shape areas_here = structure_per_layer[mesh_idx][layer_nr / static_cast<size_t>(beam_layer_count_)].intersection(layer_outlines);
+                const Shape& areas_other = structure_per_layer[! mesh_idx][layer_nr / static_cast<size_t>(beam_layer_count_)];
 
-            const Shape areas_here = structure_per_layer[mesh_idx][layer_nr / static_cast<size_t>(beam_layer_count_)].intersection(layer_outlines);
-            const Shape& areas_other = structure_per_layer[! mesh_idx][layer_nr / static_cast<size_t>(beam_layer_count_)];
-
-            SlicerLayer& layer = mesh->layers[layer_nr];
-            layer.polygons_ = layer.polygons_
-                                  .difference(areas_other) // reduce layer areas inward with beams from other mesh
-                                  .unionPolygons(areas_here); // extend layer areas outward with newly added beams
-        }
+                SlicerLayer& layer = mesh->layers[layer_nr];
+                layer.polygons_ = layer.polygons_
+                                      .difference(areas_other) // reduce layer areas inward with beams from other mesh
+                                      .unionPolygons(areas_here); // extend layer areas outward with newly added beams
+            });
     }
 }
 
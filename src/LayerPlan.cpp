@@ -7,6 +7,7 @@
 #include <cstring>
 #include <numeric>
 #include <optional>
+#include <tuple>
 
 #include <range/v3/algorithm/max_element.hpp>
 #include <scripta/logger.h>
@@ -26,6 +27,7 @@
 #include "raft.h" // getTotalExtraLayers
 #include "settings/types/Ratio.h"
 #include "sliceDataStorage.h"
+#include "utils/MemoryUsage.h"
 #include "utils/Simplify.h"
 #include "utils/linearAlg2D.h"
 #include "utils/math.h"
@@ -204,6 +206,7 @@ Shape LayerPlan::computeCombBoundary(const CombBoundary boundary_type)
                 }
 
                 const CombingMode combing_mode = mesh.settings.get<CombingMode>("retraction_combing");
+                // The comb offsets are only needed once per part, so they aren't kept with the shared outline offsets of the part.
                 for (const SliceLayerPart& part : layer.parts)
                 {
                     if (combing_mode == CombingMode::ALL) // Add the increased outline offset (skin, infill and part of the inner walls)
@@ -737,7 +740,7 @@ void LayerPlan::addWallLine(
                         segment_flow,
                         width_factor,
                         spiralize,
-                        (overhang_mask_.empty() || (! overhang_mask_.inside(p0, true) && ! overhang_mask_.inside(p1, true))) ? speed_factor : overhang_speed_factor);
+                        (overhang_mask_.empty() || (! overhang_mask_index_->inside(p0, true) && ! overhang_mask_index_->inside(p1, true))) ? speed_factor : overhang_speed_factor);
                 }
 
                 distance_to_bridge_start -= len;
@@ -752,7 +755,7 @@ void LayerPlan::addWallLine(
                     segment_flow,
                     width_factor,
                     spiralize,
-                    (overhang_mask_.empty() || (! overhang_mask_.inside(p0, true) && ! overhang_mask_.inside(p1, true))) ? speed_factor : overhang_speed_factor);
+                    (overhang_mask_.empty() || (! overhang_mask_index_->inside(p0, true) && ! overhang_mask_index_->inside(p1, true))) ? speed_factor : overhang_speed_factor);
             }
             non_bridge_line_volume += vSize(cur_point - segment_end) * segment_flow * width_factor * speed_factor * default_config.getSpeed();
             cur_point = segment_end;
@@ -846,7 +849,7 @@ void LayerPlan::addWallLine(
             flow,
             width_factor,
             spiralize,
-            (overhang_mask_.empty() || (! overhang_mask_.inside(p0, true) && ! overhang_mask_.inside(p1, true))) ? 1.0_r : overhang_speed_factor);
+            (overhang_mask_.empty() || (! overhang_mask_index_->inside(p0, true) && ! overhang_mask_index_->inside(p1, true))) ? 1.0_r : overhang_speed_factor);
     }
     else
     {
@@ -924,7 +927,7 @@ void LayerPlan::addWallLine(
             // if we haven't yet reached p1, fill the gap with default_config line
             addNonBridgeLine(p1);
         }
-        else if (bridge_wall_mask_.inside(p0, true) && vSize(p0 - p1) >= min_bridge_line_len)
+        else if (bridge_wall_mask_index_->inside(p0, true) && vSize(p0 - p1) >= min_bridge_line_len)
         {
             // both p0 and p1 must be above air (the result will be ugly!)
             addExtrusionMove(p1, bridge_config, SpaceFillType::Polygons, flow, width_factor);
@@ -1077,7 +1080,7 @@ void LayerPlan::addWall(
                         line_polys.removeAt(nearest);
                     }
                 }
-                else if (! bridge_wall_mask_.inside(p0.p_, true))
+                else if (! bridge_wall_mask_index_->inside(p0.p_, true))
                 {
                     // none of the line is over air
                     distance_to_bridge_start += vSize(p1.p_ - p0.p_);
@@ -1982,6 +1985,7 @@ void LayerPlan::processFanSpeedAndMinimalLayerTime(Point2LL starting_position)
 
 void LayerPlan::writeGCode(GCodeExport& gcode)
 {
+    gcode.writePendingPrintTime(); // The estimate of the previous layer was calculated while this layer was waiting to be written.
     auto communication = Application::getInstance().communication_;
     communication->setLayerForSend(layer_nr_);
     communication->sendCurrentPosition(gcode.getPositionXY());
@@ -2595,9 +2599,28 @@ void LayerPlan::applyModifyPlugin()
             scripta::CellVDI{ "fan_speed", &GCodePath::getFanSpeed },
             scripta::CellVDI{ "is_travel_path", &GCodePath::isTravelPath },
             scripta::CellVDI{ "extrusion_mm3_per_mm", &GCodePath::getExtrusionMM3perMM });
+    }
 
-        extruder_plan.paths_ = slots::instance().modify<plugins::v0::SlotID::GCODE_PATHS_MODIFY>(extruder_plan.paths_, extruder_plan.extruder_nr_, layer_nr_);
+    // All extruder plans of the layer are sent at once, so that the layer costs a single round trip to the plugin.
+    std::vector<std::vector<GCodePath>> paths_per_extruder_plan;
+    paths_per_extruder_plan.reserve(extruder_plans_.size());
+    for (auto& extruder_plan : extruder_plans_)
+    {
+        paths_per_extruder_plan.push_back(std::move(extruder_plan.paths_));
+    }
+    slots::instance().modifyBatch<plugins::v0::SlotID::GCODE_PATHS_MODIFY>(
+        paths_per_extruder_plan,
+        [this](const size_t plan_idx)
+        {
+            return std::make_tuple(extruder_plans_[plan_idx].extruder_nr_, layer_nr_);
+        });
+    for (size_t plan_idx = 0; plan_idx < extruder_plans_.size(); plan_idx++)
+    {
+        extruder_plans_[plan_idx].paths_ = std::move(paths_per_extruder_plan[plan_idx]);
+    }
 
+    for (auto& extruder_plan : extruder_plans_)
+    {
         scripta::log(
             "extruder_plan_1",
             extruder_plan.paths_,
@@ -2644,6 +2667,29 @@ LayerIndex LayerPlan::getLayerNr() const
     return layer_nr_;
 }
 
+size_t LayerPlan::memoryUsage() const
+{
+    size_t bytes = extruder_plans_.capacity() * sizeof(ExtruderPlan) + cura::memoryUsage(comb_boundary_minimum_) + cura::memoryUsage(comb_boundary_preferred_)
+                 + cura::memoryUsage(bridge_wall_mask_) + cura::memoryUsage(overhang_mask_) + cura::memoryUsage(seam_overhang_mask_) + cura::memoryUsage(roofing_mask_);
+    if (bridge_wall_mask_index_)
+    {
+        bytes += bridge_wall_mask_index_->memoryUsage();
+    }
+    if (overhang_mask_index_)
+    {
+        bytes += overhang_mask_index_->memoryUsage();
+    }
+    for (const ExtruderPlan& extruder_plan : extruder_plans_)
+    {
+        bytes += extruder_plan.paths_.capacity() * sizeof(GCodePath) + extruder_plan.inserts_.size() * (sizeof(NozzleTempInsert) + 2 * sizeof(void*));
+        for (const GCodePath& path : extruder_plan.paths_)
+        {
+            bytes += path.points.capacity() * sizeof(Point2LL);
+        }
+    }
+    return bytes;
+}
+
 Point2LL LayerPlan::getLastPlannedPositionOrStartingPosition() const
 {
     return last_planned_position_.value_or(layer_start_pos_per_extruder_[getExtruder()]);
@@ -2672,11 +2718,13 @@ size_t LayerPlan::getExtruder() const
 void LayerPlan::setBridgeWallMask(const Shape& polys)
 {
     bridge_wall_mask_ = polys;
+    bridge_wall_mask_index_.emplace(polys);
 }
 
 void LayerPlan::setOverhangMask(const Shape& polys)
 {
     overhang_mask_ = polys;
+    overhang_mask_index_.emplace(polys);
 }
 
 void LayerPlan::setSeamOverhangMask(const Shape& polys)
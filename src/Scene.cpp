@@ -8,6 +8,7 @@
 #include "Application.h"
 #include "FffProcessor.h" //To start a slice.
 #include "communication/Communication.h" //To flush g-code and layer view when we're done.
+#include "plugins/slots.h"
 #include "progress/Progress.h"
 #include "sliceDataStorage.h"
 
@@ -91,12 +92,14 @@ void Scene::processMeshGroup(MeshGroup& mesh_group)
         return;
     }
 
+    storage.memoryUsage().log("Slice data");
     Progress::messageProgressStage(Progress::Stage::EXPORT, &fff_processor->time_keeper);
     fff_processor->gcode_writer.writeGCode(storage, fff_processor->time_keeper);
 
     Progress::messageProgress(Progress::Stage::FINISH, 1, 1); // 100% on this meshgroup
     Application::getInstance().communication_->flushGCode();
     Application::getInstance().communication_->sendOptimizedLayerData();
+    slots::instance().logStatistics();
     spdlog::info("Total time elapsed {:03.3f}s\n", time_keeper_total.restart());
 }
 
@@ -9,6 +9,7 @@
 #endif
 
 #include "ExtruderTrain.h"
+#include "infill.h"
 
 namespace cura
 {
@@ -26,6 +27,7 @@ void Slice::compute()
         sentry_set_tag("cura.machine_name", scene.settings.get<std::string>("machine_name").c_str());
     }
 #endif
+    Infill::clearPluginResults(); // The plugin or its settings may have changed since the previous slice.
 
     for (std::vector<MeshGroup>::iterator mesh_group = scene.mesh_groups.begin(); mesh_group != scene.mesh_groups.end(); mesh_group++)
     {
@@ -564,6 +564,40 @@ coord_t TreeModelVolumes::getRadiusNextCeil(coord_t radius, bool min_xy_dist) co
     return ceilRadius(radius, min_xy_dist) - (min_xy_dist ? 0 : current_min_xy_dist_delta_);
 }
 
+void TreeModelVolumes::memoryUsage(MemoryReport& report) const
+{
+    size_t outline_bytes = cura::memoryUsage(anti_overhang_);
+    for (const auto& [settings, outlines] : layer_outlines_)
+    {
+        outline_bytes += cura::memoryUsage(outlines);
+    }
+    report.add("tree support outlines", outline_bytes);
+
+    const auto add_cache = [&report](const std::string& name, const auto& cache, std::mutex& critical_section)
+    {
+        std::lock_guard<std::mutex> critical_section_lock(critical_section);
+        size_t bytes = cache.bucket_count() * sizeof(void*);
+        for (const auto& [key, area] : cache)
+        {
+            bytes += sizeof(key) + sizeof(area) + 2 * sizeof(void*) + cura::memoryUsage(area); // Every node also holds a pointer to the next one and the hash.
+        }
+        report.add("tree support " + name + " cache", bytes);
+    };
+    add_cache("collision", collision_cache_, *critical_collision_cache_);
+    add_cache("hole-free collision", collision_cache_holefree_, *critical_collision_cache_holefree_);
+    add_cache("accumulated placeables", accumulated_placeables_cache_radius_0_, *critical_accumulated_placeables_cache_radius_0_);
+    add_cache("collision avoidance", avoidance_cache_collision_, *critical_avoidance_cache_collision_);
+    add_cache("avoidance", avoidance_cache_, *critical_avoidance_cache_);
+    add_cache("slow avoidance", avoidance_cache_slow_, *critical_avoidance_cache_slow_);
+    add_cache("avoidance to model", avoidance_cache_to_model_, *critical_avoidance_cache_to_model_);
+    add_cache("slow avoidance to model", avoidance_cache_to_model_slow_, *critical_avoidance_cache_to_model_slow_);
+    add_cache("placeable areas", placeable_areas_cache_, *critical_placeable_areas_cache_);
+    add_cache("hole-free avoidance", avoidance_cache_hole_, *critical_avoidance_cache_holefree_);
+    add_cache("hole-free avoidance to model", avoidance_cache_hole_to_model_, *critical_avoidance_cache_holefree_to_model_);
+    add_cache("wall restrictions", wall_restrictions_cache_, *critical_wall_restrictions_cache_);
+    add_cache("minimum wall restrictions", wall_restrictions_cache_min_, *critical_wall_restrictions_cache_min_);
+}
+
 bool TreeModelVolumes::checkSettingsEquality(const Settings& me, const Settings& other) const
 {
     return TreeSupportSettings(me) == TreeSupportSettings(other);
@@ -182,6 +182,9 @@ void TreeSupport::generateSupportAreas(SliceDataStorage& storage)
         drawAreas(move_bounds, storage);
 
         const auto t_draw = std::chrono::high_resolution_clock::now();
+        MemoryReport volumes_memory;
+        volumes_.memoryUsage(volumes_memory);
+        volumes_memory.log("Tree support caches");
         const auto dur_pre_gen = 0.001 * std::chrono::duration_cast<std::chrono::microseconds>(t_precalc - t_start).count();
         const auto dur_gen = 0.001 * std::chrono::duration_cast<std::chrono::microseconds>(t_gen - t_precalc).count();
         const auto dur_path = 0.001 * std::chrono::duration_cast<std::chrono::microseconds>(t_path - t_gen).count();
@@ -1724,12 +1727,21 @@ void TreeSupport::generateBranchAreas(
                         vertex = Point2LL(matrix[0] * vertex.X + matrix[1] * vertex.Y, matrix[2] * vertex.X + matrix[3] * vertex.Y);
                         circle.push_back(center_position + vertex);
                     }
-                    poly.push_back(circle.offset(0));
+                    // The matrix is positive definite, so the ellipse is as convex and counter-clockwise as the circle it's made from.
+                    poly.push_back(std::move(circle));
                 }
 
-                poly = poly.unionPolygons()
-                           .offset(std::min(static_cast<coord_t>(FUDGE_LENGTH), config.support_line_width / 4))
-                           .difference(volumes_.getCollision(0, linear_data[idx].first, parent_uses_min || elem->use_min_xy_dist_));
+                const coord_t fudge_offset = std::min(static_cast<coord_t>(FUDGE_LENGTH), config.support_line_width / 4);
+                if (poly.size() == 1)
+                {
+                    // A single ellipse doesn't need to be merged with anything, and being convex it can be offset directly.
+                    poly = poly.front().offsetConvex(fudge_offset);
+                }
+                else
+                {
+                    poly = poly.unionPolygons().offset(fudge_offset);
+                }
+                poly = poly.difference(volumes_.getCollision(0, linear_data[idx].first, parent_uses_min || elem->use_min_xy_dist_));
                 // ^^^ There seem to be some rounding errors, causing a branch to be a tiny bit further away from the model that it has to be. This can cause the tip to be slightly
                 // further away front the overhang (x/y wise) than optimal.
                 //     This fixes it, and for every other part, 0.05mm will not be noticed.
@@ -2230,9 +2242,7 @@ void TreeSupport::finalizeInterfaceAndSupportAreas(
                     // One sample at 0 layers below, another at config.support_bottom_layers. In-between samples at 1-layer distance from each other.
                     const size_t sample_layer
                         = static_cast<size_t>(std::max(0, (static_cast<int>(layer_idx) - static_cast<int>(layers_below)) - static_cast<int>(config.z_distance_bottom_layers)));
-                    constexpr bool no_support = false;
-                    constexpr bool no_prime_tower = false;
-                    floor_layer.push_back(layer_outset.intersection(storage.getLayerOutlines(sample_layer, no_support, no_prime_tower)));
+                    floor_layer.push_back(layer_outset.intersection(*storage.getModelOutlines(sample_layer)));
                     if (layers_below < config.support_bottom_layers)
                     {
                         layers_below = std::min(layers_below + 1UL, config.support_bottom_layers);
@@ -86,6 +86,7 @@ void WallsComputation::generateWalls(SliceLayerPart* part, SectionType section_t
     }
 
     part->outline = SingleShape{ Simplify(settings_).polygon(part->outline) };
+    part->clearOutlineOffsets();
     part->print_outline = part->outline;
 }
 
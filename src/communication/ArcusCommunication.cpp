@@ -355,19 +355,41 @@ void ArcusCommunication::beginGCode()
 
 void ArcusCommunication::flushGCode()
 {
-    std::string gcode_output_stream = private_data->gcode_output_stream.str();
-    auto message_str = slots::instance().modify<plugins::v0::SlotID::POSTPROCESS_MODIFY>(gcode_output_stream);
+    std::vector<std::string> blocks = private_data->gcode_output_buffer.take();
+    if (blocks.empty())
+    {
+        return;
+    }
+    std::string gcode;
+    if (blocks.size() == 1)
+    {
+        gcode = std::move(blocks.front()); // The block itself is moved along to the message, without copying it.
+    }
+    else
+    {
+        // The front-end expects the g-code of a flush in one message, so larger layers are joined once. Their blocks are then written to again.
+        size_t size = 0;
+        for (const std::string& block : blocks)
+        {
+            size += block.size();
+        }
+        gcode.reserve(size);
+        for (const std::string& block : blocks)
+        {
+            gcode += block;
+        }
+        private_data->gcode_output_buffer.recycle(std::move(blocks));
+    }
+    std::string message_str = slots::instance().modify<plugins::v0::SlotID::POSTPROCESS_MODIFY>(std::move(gcode));
     if (message_str.size() == 0)
     {
         return;
     }
-    std::shared_ptr<proto::GCodeLayer> message = std::make_shared<proto::GCodeLayer>();
-    message->set_data(message_str);
+    private_data->waitForGCodeCapacity(message_str.capacity());
+    std::shared_ptr<proto::GCodeLayer> message = private_data->createGCodeMessage(std::move(message_str));
 
     // Send the g-code to the front-end! Yay!
     private_data->socket->sendMessage(message);
-
-    private_data->gcode_output_stream.str("");
 }
 
 bool ArcusCommunication::isSequential() const
@@ -389,8 +411,7 @@ void ArcusCommunication::sendCurrentPosition(const Point2LL& position)
 void ArcusCommunication::sendGCodePrefix(const std::string& prefix) const
 {
     std::shared_ptr<proto::GCodePrefix> message = std::make_shared<proto::GCodePrefix>();
-    std::string message_str = prefix;
-    message->set_data(slots::instance().modify<plugins::v0::SlotID::POSTPROCESS_MODIFY>(message_str));
+    message->set_data(slots::instance().modify<plugins::v0::SlotID::POSTPROCESS_MODIFY>(std::string(prefix)));
     private_data->socket->sendMessage(message);
 }
 
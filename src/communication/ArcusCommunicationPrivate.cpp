@@ -5,6 +5,9 @@
 
 #include "communication/ArcusCommunicationPrivate.h"
 
+#include <chrono> //To time out waiting for the socket to send g-code.
+
+#include <Arcus/Socket.h> //To see whether the socket is still sending.
 #include <spdlog/spdlog.h>
 
 #include "Application.h"
@@ -20,12 +23,47 @@ namespace cura
 ArcusCommunication::Private::Private()
     : socket(nullptr)
     , object_count(0)
+    , gcode_output_stream(&gcode_output_buffer)
+    , gcode_in_flight(std::make_shared<GCodeInFlight>())
     , last_sent_progress(-1)
     , slice_count(0)
     , millisecUntilNextTry(100)
 {
 }
 
+void ArcusCommunication::Private::waitForGCodeCapacity(const size_t bytes)
+{
+    std::unique_lock lock(gcode_in_flight->mutex);
+    // Sent messages wake us up right away. The timeout is only there to notice when the socket got disconnected with messages still queued.
+    while (gcode_in_flight->bytes != 0 && gcode_in_flight->bytes + bytes > max_gcode_bytes_in_flight && socket->getState() == Arcus::SocketState::Connected)
+    {
+        gcode_in_flight->sent.wait_for(lock, std::chrono::milliseconds(millisecUntilNextTry));
+    }
+}
+
+std::shared_ptr<proto::GCodeLayer> ArcusCommunication::Private::createGCodeMessage(std::string&& gcode)
+{
+    const size_t bytes = gcode.capacity();
+    {
+        std::lock_guard lock(gcode_in_flight->mutex);
+        gcode_in_flight->bytes += bytes;
+    }
+    // The socket releases its reference to a message once it has been sent, so that's when the message gets deleted.
+    std::shared_ptr<proto::GCodeLayer> message(
+        new proto::GCodeLayer,
+        [in_flight = gcode_in_flight, bytes](proto::GCodeLayer* sent_message)
+        {
+            delete sent_message;
+            {
+                std::lock_guard lock(in_flight->mutex);
+                in_flight->bytes -= bytes;
+            }
+            in_flight->sent.notify_all();
+        });
+    message->set_data(std::move(gcode));
+    return message;
+}
+
 std::shared_ptr<proto::LayerOptimized> ArcusCommunication::Private::getOptimizedLayerById(LayerIndex::value_type layer_nr)
 {
     layer_nr += optimized_layers.current_layer_offset;
@@ -28,6 +28,7 @@
 #include "FffProcessor.h" //To start a slice and get time estimates.
 #include "MeshGroup.h"
 #include "Slice.h"
+#include "utils/DefinitionBundle.h"
 #include "utils/Matrix4x3D.h" //For the mesh_rotation_matrix setting.
 #include "utils/format/filesystem_path.h"
 #include "utils/views/split_paths.h"
@@ -148,6 +149,7 @@ void CommandLine::sliceNext()
 
     bool force_read_parent = false;
     bool force_read_nondefault = false;
+    std::optional<std::filesystem::path> bundle_filename; // If set, only compile the loaded definitions into a bundle instead of slicing.
 
     for (size_t argument_index = 2; argument_index < arguments_.size(); argument_index++)
     {
@@ -192,6 +194,16 @@ void CommandLine::sliceNext()
                     force_read_parent = false;
                     force_read_nondefault = false;
                 }
+                else if (argument.starts_with("--compile-definitions") || argument.starts_with("--compile_definitions"))
+                {
+                    argument_index++;
+                    if (argument_index >= arguments_.size())
+                    {
+                        spdlog::error("Missing bundle file with --compile-definitions argument.");
+                        exit(1);
+                    }
+                    bundle_filename = arguments_[argument_index];
+                }
                 else if (argument.starts_with("--progress_cb") || argument.starts_with("--slice_info_cb") || argument.starts_with("--gcode_header_cb"))
                 {
                     // Unused in command line slicing, but used in EmscriptenCommunication.
@@ -245,11 +257,24 @@ void CommandLine::sliceNext()
                         exit(1);
                     }
                     argument = arguments_[argument_index];
+                    const size_t given_definition_count = given_definitions_.size();
                     if (loadJSON(std::filesystem::path{ argument }, *last_settings, force_read_parent, force_read_nondefault) != 0)
                     {
                         spdlog::error("Failed to load JSON file: {}", argument);
                         exit(1);
                     }
+                    // Remember the definition for a bundle compiled from it, unless it was a bundle which brought its own definitions.
+                    if (given_definitions_.size() == given_definition_count)
+                    {
+                        if (last_settings == &slice->scene.settings)
+                        {
+                            given_definitions_.emplace_back(0, std::filesystem::absolute(argument).string());
+                        }
+                        else if (last_settings == &last_extruder->settings_)
+                        {
+                            given_definitions_.emplace_back(1 + last_extruder->extruder_nr_, std::filesystem::absolute(argument).string());
+                        }
+                    }
 
                     // If this was the global stack, create extruders for the machine_extruder_count setting.
                     if (last_settings == &slice->scene.settings)
@@ -483,6 +508,17 @@ void CommandLine::sliceNext()
 
     arguments_.clear(); // We've processed all arguments now.
 
+    if (bundle_filename.has_value())
+    {
+        if (! writeDefinitionBundle(*bundle_filename))
+        {
+            spdlog::error("Failed to write definition bundle: {}", *bundle_filename);
+            exit(1);
+        }
+        spdlog::info("Compiled definitions into {} in {:3}s", *bundle_filename, FffProcessor::getInstance()->time_keeper.restart());
+        return;
+    }
+
 #ifndef DEBUG
     try
     {
@@ -518,6 +554,13 @@ int CommandLine::loadJSON(const std::filesystem::path& json_filename, Settings&
     }
 
     std::vector<char> read_buffer(std::istreambuf_iterator<char>(file), {});
+    const std::string_view contents(read_buffer.data(), read_buffer.size());
+    if (DefinitionBundle::isBundle(contents))
+    {
+        return loadDefinitionBundle(contents, settings);
+    }
+    definitions_hash_ = DefinitionBundle::hashSource(contents, definitions_hash_);
+    definition_files_.push_back(std::filesystem::absolute(json_filename).string());
     rapidjson::MemoryStream memory_stream(read_buffer.data(), read_buffer.size());
 
     rapidjson::Document json_document;
@@ -532,6 +575,108 @@ int CommandLine::loadJSON(const std::filesystem::path& json_filename, Settings&
     return loadJSON(json_document, search_directories_, settings, force_read_parent, force_read_nondefault);
 }
 
+int CommandLine::loadDefinitionBundle(const std::string_view bundle_data, Settings& settings)
+{
+    const std::optional<DefinitionBundle> bundle = DefinitionBundle::deserialize(bundle_data);
+    if (! bundle.has_value())
+    {
+        spdlog::error("Corrupt or unsupported definition bundle.");
+        return 2;
+    }
+
+    // Hash the definition files the same way as when they were compiled, to see whether they changed since.
+    uint64_t source_hash = 0;
+    uint64_t definitions_hash = definitions_hash_;
+    for (const std::string& source_file : bundle->source_files)
+    {
+        std::ifstream file(source_file, std::ios::binary);
+        if (! file)
+        {
+            spdlog::warn("Definition file {} of the definition bundle can't be opened, loading the definition files instead.", source_file);
+            return loadDefinitionBundleSources(*bundle, settings);
+        }
+        const std::vector<char> source_buffer(std::istreambuf_iterator<char>(file), {});
+        const std::string_view source_contents(source_buffer.data(), source_buffer.size());
+        source_hash = DefinitionBundle::hashSource(source_contents, source_hash);
+        definitions_hash = DefinitionBundle::hashSource(source_contents, definitions_hash);
+    }
+    if (source_hash != bundle->source_hash)
+    {
+        spdlog::warn("The definition files changed since the definition bundle was compiled, loading the definition files instead.");
+        return loadDefinitionBundleSources(*bundle, settings);
+    }
+    definitions_hash_ = definitions_hash;
+    definition_files_.insert(definition_files_.end(), bundle->source_files.begin(), bundle->source_files.end());
+    given_definitions_.insert(given_definitions_.end(), bundle->definitions.begin(), bundle->definitions.end());
+
+    for (const auto& [key, value] : bundle->global_settings)
+    {
+        settings.add(key, value);
+    }
+    Scene& scene = Application::getInstance().current_slice_->scene;
+    for (size_t extruder_nr = 0; extruder_nr < bundle->extruder_settings.size(); extruder_nr++)
+    {
+        while (scene.extruders.size() <= extruder_nr)
+        {
+            scene.extruders.emplace_back(scene.extruders.size(), &scene.settings);
+        }
+        for (const auto& [key, value] : bundle->extruder_settings[extruder_nr])
+        {
+            scene.extruders[extruder_nr].settings_.add(key, value);
+        }
+    }
+    spdlog::debug("Loaded definition bundle with source hash {:016x}", bundle->source_hash);
+    return 0;
+}
+
+int CommandLine::loadDefinitionBundleSources(const DefinitionBundle& bundle, Settings& settings)
+{
+    given_definitions_.insert(given_definitions_.end(), bundle.definitions.begin(), bundle.definitions.end());
+    Scene& scene = Application::getInstance().current_slice_->scene;
+    for (const auto& [stack_idx, definition_file] : bundle.definitions)
+    {
+        if (stack_idx == 0)
+        {
+            if (const auto error_code = loadJSON(std::filesystem::path{ definition_file }, settings); error_code != 0)
+            {
+                return error_code;
+            }
+            continue;
+        }
+        const size_t extruder_nr = stack_idx - 1;
+        while (scene.extruders.size() <= extruder_nr)
+        {
+            scene.extruders.emplace_back(scene.extruders.size(), &scene.settings);
+        }
+        if (const auto error_code = loadJSON(std::filesystem::path{ definition_file }, scene.extruders[extruder_nr].settings_); error_code != 0)
+        {
+            return error_code;
+        }
+        scene.extruders[extruder_nr].settings_.add("extruder_nr", std::to_string(extruder_nr));
+    }
+    return 0;
+}
+
+bool CommandLine::writeDefinitionBundle(const std::filesystem::path& bundle_filename) const
+{
+    const Scene& scene = Application::getInstance().current_slice_->scene;
+    DefinitionBundle bundle;
+    bundle.source_hash = definitions_hash_;
+    bundle.source_files = definition_files_;
+    bundle.definitions = given_definitions_;
+    bundle.global_settings.assign(scene.settings.getLocalSettings().begin(), scene.settings.getLocalSettings().end());
+    for (const ExtruderTrain& extruder : scene.extruders)
+    {
+        const setting_map& extruder_settings = extruder.settings_.getLocalSettings();
+        bundle.extruder_settings.emplace_back(extruder_settings.begin(), extruder_settings.end());
+    }
+
+    std::ofstream file(bundle_filename, std::ios::binary);
+    const std::string data = bundle.serialize();
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
 int CommandLine::loadJSON(
     const rapidjson::Document& document,
     const std::vector<std::filesystem::path>& search_directories,
@@ -20,6 +20,7 @@
 #include "settings/types/LayerIndex.h"
 #include "sliceDataStorage.h"
 #include "utils/Date.h"
+#include "utils/ThreadPool.h"
 #include "utils/string.h" // MMtoStream, PrecisionedDouble
 
 namespace cura
@@ -75,6 +76,15 @@ GCodeExport::~GCodeExport()
 {
 }
 
+bool GCodeExport::isBinaryGCodeSelected() const
+{
+    const Scene& scene = Application::getInstance().current_slice_->scene;
+    const Settings& mesh_group_settings = scene.current_mesh_group->settings;
+    // Only the command line writes its g-code to a file directly, the front-end expects plain text.
+    return (scene.settings.has("machine_gcode_binary") || mesh_group_settings.has("machine_gcode_binary")) && mesh_group_settings.get<bool>("machine_gcode_binary")
+        && Application::getInstance().communication_->isSequential();
+}
+
 void GCodeExport::preSetup(const size_t start_extruder)
 {
     current_extruder_ = start_extruder;
@@ -82,6 +92,15 @@ void GCodeExport::preSetup(const size_t start_extruder)
     const Scene& scene = Application::getInstance().current_slice_->scene;
     std::vector<MeshGroup>::iterator mesh_group = scene.current_mesh_group;
     setFlavor(mesh_group->settings.get<EGCodeFlavor>("machine_gcode_flavor"));
+
+    if (isBinaryGCodeSelected() && ! binary_encoder_)
+    {
+        binary_target_stream_ = output_stream_;
+        binary_encoder_ = std::make_unique<BinaryGCodeEncoder>(*output_stream_);
+        binary_encoder_->holdGCode(); // The metadata has to precede the g-code, but the print time and material usage are only known at the end.
+        binary_stream_ = std::make_unique<std::ostream>(binary_encoder_.get());
+        setOutputStream(binary_stream_.get());
+    }
     use_extruder_offset_to_offset_coords_ = mesh_group->settings.get<bool>("machine_use_extruder_offset_to_offset_coords");
     const size_t extruder_count = Application::getInstance().current_slice_->scene.extruders.size();
     ppr_enable_ = mesh_group->settings.get<bool>("ppr_enable");
@@ -345,8 +364,35 @@ void GCodeExport::setLayerNr(const LayerIndex& layer_nr)
     layer_nr_ = layer_nr;
 }
 
+void GCodeExport::finishBinaryOutput(const std::string& header)
+{
+    if (! binary_encoder_)
+    {
+        return;
+    }
+    bgcode::Metadata printer_metadata;
+    bgcode::Metadata print_metadata;
+    for (auto& [key, value] : bgcode::parseHeaderComments(header))
+    {
+        // The print time and material usage describe the print itself, the rest of the header describes the printer it's sliced for.
+        const bool describes_print = key == "TIME" || key == "PRINT.TIME" || key.starts_with("MATERIAL") || key == "Filament used" || key.ends_with(".MATERIAL.VOLUME_USED");
+        (describes_print ? print_metadata : printer_metadata).emplace_back(std::move(key), std::move(value));
+    }
+    binary_encoder_->writeMetadata(bgcode::BlockType::PRINTER_METADATA, printer_metadata);
+    binary_encoder_->writeMetadata(bgcode::BlockType::PRINT_METADATA, print_metadata);
+    binary_encoder_->writeMetadata(bgcode::BlockType::SLICER_METADATA, { { "generator", "Cura_SteamEngine " CURA_ENGINE_VERSION } });
+    binary_stream_->flush(); // Encodes the last block.
+    binary_encoder_->releaseGCode();
+    setOutputStream(binary_target_stream_);
+}
+
 void GCodeExport::setOutputStream(std::ostream* stream)
 {
+    if (stream != binary_stream_.get())
+    {
+        binary_stream_.reset();
+        binary_encoder_.reset();
+    }
     output_stream_ = stream;
     *output_stream_ << std::fixed;
 }
@@ -514,6 +560,7 @@ double GCodeExport::getTotalFilamentUsed(size_t extruder_nr)
 
 std::vector<Duration> GCodeExport::getTotalPrintTimePerFeature()
 {
+    writePendingPrintTime();
     return total_print_times_;
 }
 
@@ -540,17 +587,58 @@ void GCodeExport::resetTotalPrintTimeAndFilament()
         extruder_attr_[e].waited_for_temperature_ = false;
     }
     current_e_value_ = 0.0;
+    if (pending_print_time_estimate_)
+    {
+        // The estimate may still be used by a worker, so wait for it rather than dropping it halfway.
+        pending_print_time_estimate_->run();
+        pending_print_time_estimate_->result.wait();
+        pending_print_time_estimate_.reset();
+    }
     estimate_calculator_.reset();
 }
 
 void GCodeExport::updateTotalPrintTime()
 {
-    std::vector<Duration> estimates = estimate_calculator_.calculate();
+    writePendingPrintTime();
+
+    auto job = std::make_shared<PrintTimeEstimateJob>();
+    job->task = std::packaged_task<std::vector<Duration>()>(
+        [calculator = estimate_calculator_.takeRecorded()]()
+        {
+            return calculator.calculate();
+        });
+    job->result = job->task.get_future();
+    pending_print_time_estimate_ = job;
+
+    ThreadPool* const thread_pool = Application::getInstance().thread_pool_;
+    if (thread_pool != nullptr && thread_pool->thread_count() > 0)
+    {
+        ThreadPool::lock_t lock = thread_pool->get_lock();
+        thread_pool->push(
+            lock,
+            [job](ThreadPool::lock_t& th_lock)
+            {
+                th_lock.unlock();
+                job->run();
+                th_lock.lock();
+            });
+    }
+}
+
+void GCodeExport::writePendingPrintTime()
+{
+    if (! pending_print_time_estimate_)
+    {
+        return;
+    }
+    const std::shared_ptr<PrintTimeEstimateJob> job = std::move(pending_print_time_estimate_);
+    pending_print_time_estimate_.reset();
+    job->run();
+    const std::vector<Duration> estimates = job->result.get();
     for (size_t i = 0; i < estimates.size(); i++)
     {
         total_print_times_[i] += estimates[i];
     }
-    estimate_calculator_.reset();
     writeTimeComment(getSumTotalPrintTimes());
 }
 
@@ -676,8 +764,12 @@ bool GCodeExport::initializeExtruderTrains(const SliceDataStorage& storage, cons
     if (Application::getInstance().communication_->isSequential()) // If we must output the g-code sequentially, we must already place the g-code header here even if we don't know
                                                                    // the exact time/material usages yet.
     {
-        std::string prefix = getFileHeader(storage.getExtrudersUsed());
-        writeCode(prefix.c_str());
+        // Binary g-code holds the header in metadata blocks instead, which are written by finishBinaryOutput once the final values are known.
+        if (! binary_encoder_)
+        {
+            std::string prefix = getFileHeader(storage.getExtrudersUsed());
+            writeCode(prefix.c_str());
+        }
     }
 
     writeComment("Generated with Cura_SteamEngine " CURA_ENGINE_VERSION);
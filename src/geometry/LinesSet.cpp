@@ -182,12 +182,7 @@ Shape LinesSet<Polygon>::offset(coord_t distance, ClipperLib::JoinType join_type
     {
         return { getLines() };
     }
-    ClipperLib::Paths ret;
-    ClipperLib::ClipperOffset clipper(miter_limit, 10.0);
-    Shape(getLines()).unionPolygons().addPaths(clipper, join_type, ClipperLib::etClosedPolygon);
-    clipper.MiterLimit = miter_limit;
-    clipper.Execute(ret, static_cast<double>(distance));
-    return Shape{ std::move(ret) };
+    return Shape(getLines()).offset(distance, join_type, miter_limit);
 }
 
 template<>
@@ -3,10 +3,12 @@
 
 #include "geometry/Polygon.h"
 
+#include <cmath>
 #include <cstddef>
 #include <numbers>
 
 #include "geometry/Point3Matrix.h"
+#include "geometry/PolygonBooleanBackend.h"
 #include "geometry/Shape.h"
 #include "utils/ListPolyIt.h"
 #include "utils/linearAlg2D.h"
@@ -16,12 +18,7 @@ namespace cura
 
 Shape Polygon::intersection(const Polygon& other) const
 {
-    ClipperLib::Paths ret_paths;
-    ClipperLib::Clipper clipper(clipper_init);
-    clipper.AddPath(getPoints(), ClipperLib::ptSubject, true);
-    clipper.AddPath(other.getPoints(), ClipperLib::ptClip, true);
-    clipper.Execute(ClipperLib::ctIntersection, ret_paths);
-    return Shape{ std::move(ret_paths) };
+    return PolygonBooleanBackend::get().clip(ClipperLib::ctIntersection, std::span(this, 1), std::span(&other, 1), ClipperLib::pftEvenOdd);
 }
 
 void Polygon::smooth2(int remove_length, Polygon& result) const
@@ -588,12 +585,89 @@ Shape Polygon::offset(int distance, ClipperLib::JoinType join_type, double miter
     {
         return Shape({ *this });
     }
-    ClipperLib::Paths ret;
-    ClipperLib::ClipperOffset clipper(miter_limit, 10.0);
-    clipper.AddPath(getPoints(), join_type, ClipperLib::etClosedPolygon);
-    clipper.MiterLimit = miter_limit;
-    clipper.Execute(ret, distance);
-    return Shape{ std::move(ret) };
+    return PolygonBooleanBackend::get().offset(std::span(this, 1), distance, join_type, miter_limit);
+}
+
+Shape Polygon::offsetConvex(coord_t distance, double miter_limit) const
+{
+    if (distance <= 0)
+    {
+        return offset(distance, ClipperLib::jtMiter, miter_limit);
+    }
+
+    // Clipper drops repeated vertices before offsetting, so do the same.
+    ClipperLib::Path vertices;
+    vertices.reserve(size());
+    for (const Point2LL& point : *this)
+    {
+        if (vertices.empty() || point != vertices.back())
+        {
+            vertices.push_back(point);
+        }
+    }
+    while (vertices.size() > 1 && vertices.back() == vertices.front())
+    {
+        vertices.pop_back();
+    }
+    const size_t vertex_count = vertices.size();
+    if (vertex_count < 3)
+    {
+        return offset(distance, ClipperLib::jtMiter, miter_limit);
+    }
+
+    // Strictly convex and counter-clockwise: every corner turns left and the corners turn one full circle together. Collinear vertices would
+    // be removed by Clipper, so leave those to it too.
+    std::vector<std::pair<double, double>> normals(vertex_count);
+    double total_turn = 0;
+    for (size_t vertex_idx = 0; vertex_idx < vertex_count; vertex_idx++)
+    {
+        const Point2LL& previous = vertices[(vertex_idx + vertex_count - 1) % vertex_count];
+        const Point2LL& current = vertices[vertex_idx];
+        const Point2LL& next = vertices[(vertex_idx + 1) % vertex_count];
+        const Point2LL edge_in = current - previous;
+        const Point2LL edge_out = next - current;
+        const double cross = static_cast<double>(edge_in.X) * edge_out.Y - static_cast<double>(edge_in.Y) * edge_out.X;
+        if (cross <= 0)
+        {
+            return offset(distance, ClipperLib::jtMiter, miter_limit);
+        }
+        total_turn += std::atan2(cross, static_cast<double>(edge_in.X) * edge_out.X + static_cast<double>(edge_in.Y) * edge_out.Y);
+
+        // The outward unit normal of the edge that starts at this vertex, calculated like ClipperLib::GetUnitNormal.
+        const double inverse_length = 1.0 / std::sqrt(static_cast<double>(edge_out.X) * edge_out.X + static_cast<double>(edge_out.Y) * edge_out.Y);
+        normals[vertex_idx] = { edge_out.Y * inverse_length, -edge_out.X * inverse_length };
+    }
+    if (total_turn > 3 * std::numbers::pi)
+    {
+        return offset(distance, ClipperLib::jtMiter, miter_limit);
+    }
+
+    // The same corner calculations as ClipperLib::ClipperOffset::OffsetPoint, for convex corners.
+    const double min_miter_cosine = miter_limit > 2 ? 2 / (miter_limit * miter_limit) : 0.5;
+    const double delta = static_cast<double>(distance);
+    ClipperLib::Path result;
+    result.reserve(vertex_count);
+    for (size_t vertex_idx = 0; vertex_idx < vertex_count; vertex_idx++)
+    {
+        const Point2LL& vertex = vertices[vertex_idx];
+        const auto& [normal_in_x, normal_in_y] = normals[(vertex_idx + vertex_count - 1) % vertex_count];
+        const auto& [normal_out_x, normal_out_y] = normals[vertex_idx];
+        const double sine = normal_in_x * normal_out_y - normal_out_x * normal_in_y;
+        const double cosine = normal_in_x * normal_out_x + normal_in_y * normal_out_y;
+        if (sine * delta < 1.0 && cosine > 0)
+        {
+            result.emplace_back(std::llround(vertex.X + normal_in_x * delta), std::llround(vertex.Y + normal_in_y * delta));
+            continue;
+        }
+        const double miter_cosine = 1 + cosine;
+        if (miter_cosine < min_miter_cosine)
+        {
+            return offset(distance, ClipperLib::jtMiter, miter_limit);
+        }
+        const double miter_length = delta / miter_cosine;
+        result.emplace_back(std::llround(vertex.X + (normal_in_x + normal_out_x) * miter_length), std::llround(vertex.Y + (normal_in_y + normal_out_y) * miter_length));
+    }
+    return Shape({ Polygon(std::move(result), false) });
 }
 
 } // namespace cura
@@ -0,0 +1,284 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "geometry/PolygonBooleanBackend.h"
+
+#include <string>
+
+#ifdef ENABLE_CLIPPER2
+#include <clipper2/clipper.h>
+#endif
+#include <spdlog/details/os.h>
+#include <spdlog/spdlog.h>
+
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+#include "geometry/SingleShape.h"
+
+namespace cura
+{
+
+namespace
+{
+
+class ClipperBackend : public PolygonBooleanBackend
+{
+public:
+    std::string_view name() const override
+    {
+        return "clipper";
+    }
+
+    Shape clip(ClipperLib::ClipType clip_type, std::span<const Polygon> subject, std::span<const Polygon> clip_shape, ClipperLib::PolyFillType fill_type)
+        const override
+    {
+        ClipperLib::Paths ret;
+        ClipperLib::Clipper clipper(clipper_init);
+        for (const Polygon& polygon : subject)
+        {
+            clipper.AddPath(polygon.getPoints(), ClipperLib::ptSubject, true);
+        }
+        for (const Polygon& polygon : clip_shape)
+        {
+            clipper.AddPath(polygon.getPoints(), clip_type == ClipperLib::ctUnion ? ClipperLib::ptSubject : ClipperLib::ptClip, true);
+        }
+        clipper.Execute(clip_type, ret, fill_type, fill_type);
+        return Shape{ std::move(ret) };
+    }
+
+    Shape offset(std::span<const Polygon> polygons, coord_t distance, ClipperLib::JoinType join_type, double miter_limit) const override
+    {
+        ClipperLib::Paths ret;
+        ClipperLib::ClipperOffset clipper(miter_limit, 10.0);
+        for (const Polygon& polygon : polygons)
+        {
+            clipper.AddPath(polygon.getPoints(), join_type, ClipperLib::etClosedPolygon);
+        }
+        clipper.MiterLimit = miter_limit;
+        clipper.Execute(ret, static_cast<double>(distance));
+        return Shape{ std::move(ret) };
+    }
+
+    std::vector<SingleShape> splitIntoParts(const Shape& shape, ClipperLib::PolyFillType fill_type) const override
+    {
+        std::vector<SingleShape> ret;
+        ClipperLib::Clipper clipper(clipper_init);
+        ClipperLib::PolyTree result_poly_tree;
+        shape.addPaths(clipper, ClipperLib::ptSubject);
+        clipper.Execute(ClipperLib::ctUnion, result_poly_tree, fill_type, fill_type);
+        processPolyTreeNode(result_poly_tree, ret);
+        return ret;
+    }
+
+private:
+    static void processPolyTreeNode(ClipperLib::PolyNode& node, std::vector<SingleShape>& ret)
+    {
+        for (ClipperLib::PolyNode* child : node.Childs)
+        {
+            SingleShape part;
+            part.emplace_back(std::move(child->Contour));
+            for (ClipperLib::PolyNode* hole : child->Childs)
+            {
+                part.emplace_back(std::move(hole->Contour));
+                processPolyTreeNode(*hole, ret);
+            }
+            ret.push_back(std::move(part));
+        }
+    }
+};
+
+#ifdef ENABLE_CLIPPER2
+class Clipper2Backend : public PolygonBooleanBackend
+{
+public:
+    std::string_view name() const override
+    {
+        return "clipper2";
+    }
+
+    Shape clip(ClipperLib::ClipType clip_type, std::span<const Polygon> subject, std::span<const Polygon> clip_shape, ClipperLib::PolyFillType fill_type)
+        const override
+    {
+        Clipper2Lib::Clipper64 clipper;
+        clipper.PreserveCollinear(false); // Like Clipper 6, which removes collinear vertices.
+        clipper.AddSubject(toPaths(subject));
+        if (clip_type == ClipperLib::ctUnion)
+        {
+            clipper.AddSubject(toPaths(clip_shape));
+        }
+        else
+        {
+            clipper.AddClip(toPaths(clip_shape));
+        }
+        Clipper2Lib::Paths64 ret;
+        clipper.Execute(toClipType(clip_type), toFillRule(fill_type), ret);
+        return toShape(ret);
+    }
+
+    Shape offset(std::span<const Polygon> polygons, coord_t distance, ClipperLib::JoinType join_type, double miter_limit) const override
+    {
+        Clipper2Lib::ClipperOffset clipper(miter_limit, 10.0);
+        clipper.AddPaths(toPaths(polygons), toJoinType(join_type), Clipper2Lib::EndType::Polygon);
+        Clipper2Lib::Paths64 ret;
+        clipper.Execute(static_cast<double>(distance), ret);
+        return toShape(ret);
+    }
+
+    std::vector<SingleShape> splitIntoParts(const Shape& shape, ClipperLib::PolyFillType fill_type) const override
+    {
+        std::vector<SingleShape> ret;
+        Clipper2Lib::Clipper64 clipper;
+        clipper.PreserveCollinear(false);
+        clipper.AddSubject(toPaths(shape.getLines()));
+        Clipper2Lib::PolyTree64 result_poly_tree;
+        clipper.Execute(Clipper2Lib::ClipType::Union, toFillRule(fill_type), result_poly_tree);
+        processPolyTreeNode(result_poly_tree, ret);
+        return ret;
+    }
+
+private:
+    static Clipper2Lib::Paths64 toPaths(std::span<const Polygon> polygons)
+    {
+        Clipper2Lib::Paths64 paths;
+        paths.reserve(polygons.size());
+        for (const Polygon& polygon : polygons)
+        {
+            Clipper2Lib::Path64& path = paths.emplace_back();
+            path.reserve(polygon.size());
+            for (const Point2LL& point : polygon)
+            {
+                path.emplace_back(point.X, point.Y);
+            }
+        }
+        return paths;
+    }
+
+    static ClipperLib::Path toPath(const Clipper2Lib::Path64& path)
+    {
+        ClipperLib::Path ret;
+        ret.reserve(path.size());
+        for (const Clipper2Lib::Point64& point : path)
+        {
+            ret.emplace_back(point.x, point.y);
+        }
+        return ret;
+    }
+
+    static Shape toShape(const Clipper2Lib::Paths64& paths)
+    {
+        Shape ret;
+        ret.reserve(paths.size());
+        for (const Clipper2Lib::Path64& path : paths)
+        {
+            ret.emplace_back(toPath(path), Shape::clipper_explicitely_closed_);
+        }
+        return ret;
+    }
+
+    static void processPolyTreeNode(const Clipper2Lib::PolyPath64& node, std::vector<SingleShape>& ret)
+    {
+        for (size_t child_idx = 0; child_idx < node.Count(); child_idx++)
+        {
+            const Clipper2Lib::PolyPath64& child = *node.Child(child_idx);
+            SingleShape part;
+            part.emplace_back(toPath(child.Polygon()), Shape::clipper_explicitely_closed_);
+            for (size_t hole_idx = 0; hole_idx < child.Count(); hole_idx++)
+            {
+                const Clipper2Lib::PolyPath64& hole = *child.Child(hole_idx);
+                part.emplace_back(toPath(hole.Polygon()), Shape::clipper_explicitely_closed_);
+                processPolyTreeNode(hole, ret);
+            }
+            ret.push_back(std::move(part));
+        }
+    }
+
+    static Clipper2Lib::ClipType toClipType(const ClipperLib::ClipType clip_type)
+    {
+        switch (clip_type)
+        {
+        case ClipperLib::ctIntersection:
+            return Clipper2Lib::ClipType::Intersection;
+        case ClipperLib::ctUnion:
+            return Clipper2Lib::ClipType::Union;
+        case ClipperLib::ctDifference:
+            return Clipper2Lib::ClipType::Difference;
+        case ClipperLib::ctXor:
+            return Clipper2Lib::ClipType::Xor;
+        }
+        return Clipper2Lib::ClipType::Union;
+    }
+
+    static Clipper2Lib::FillRule toFillRule(const ClipperLib::PolyFillType fill_type)
+    {
+        switch (fill_type)
+        {
+        case ClipperLib::pftEvenOdd:
+            return Clipper2Lib::FillRule::EvenOdd;
+        case ClipperLib::pftNonZero:
+            return Clipper2Lib::FillRule::NonZero;
+        case ClipperLib::pftPositive:
+            return Clipper2Lib::FillRule::Positive;
+        case ClipperLib::pftNegative:
+            return Clipper2Lib::FillRule::Negative;
+        }
+        return Clipper2Lib::FillRule::NonZero;
+    }
+
+    static Clipper2Lib::JoinType toJoinType(const ClipperLib::JoinType join_type)
+    {
+        switch (join_type)
+        {
+        case ClipperLib::jtSquare:
+            return Clipper2Lib::JoinType::Square;
+        case ClipperLib::jtRound:
+            return Clipper2Lib::JoinType::Round;
+        case ClipperLib::jtMiter:
+            return Clipper2Lib::JoinType::Miter;
+        }
+        return Clipper2Lib::JoinType::Miter;
+    }
+};
+#endif
+
+const PolygonBooleanBackend& selectBackend()
+{
+    constexpr std::string_view default_backend = "clipper";
+    const std::string requested = spdlog::details::os::getenv("CURAENGINE_POLYGON_BACKEND");
+    if (! requested.empty())
+    {
+        if (const PolygonBooleanBackend* backend = PolygonBooleanBackend::find(requested))
+        {
+            spdlog::info("Using polygon backend '{}'", backend->name());
+            return *backend;
+        }
+        spdlog::warn("Polygon backend '{}' is not available, using '{}' instead", requested, default_backend);
+    }
+    return *PolygonBooleanBackend::find(default_backend);
+}
+
+} // namespace
+
+const PolygonBooleanBackend& PolygonBooleanBackend::get()
+{
+    static const PolygonBooleanBackend& backend = selectBackend();
+    return backend;
+}
+
+const PolygonBooleanBackend* PolygonBooleanBackend::find(std::string_view name)
+{
+    static const ClipperBackend clipper_backend;
+    if (name == clipper_backend.name())
+    {
+        return &clipper_backend;
+    }
+#ifdef ENABLE_CLIPPER2
+    static const Clipper2Backend clipper2_backend;
+    if (name == clipper2_backend.name())
+    {
+        return &clipper2_backend;
+    }
+#endif
+    return nullptr;
+}
+
+} // namespace cura
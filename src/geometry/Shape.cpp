@@ -8,6 +8,7 @@
 #include <mapbox/geometry/wagyu/wagyu.hpp>
 #include <numeric>
 #include <unordered_set>
+#include <utility>
 
 #ifdef BUILD_TESTS
 #include <boost/geometry/geometries/point_xy.hpp>
@@ -29,6 +30,7 @@
 #include "geometry/OpenPolyline.h"
 #include "geometry/PartsView.h"
 #include "geometry/Polygon.h"
+#include "geometry/PolygonBooleanBackend.h"
 #include "geometry/SingleShape.h"
 #include "settings/types/Ratio.h"
 #include "utils/OpenPolylineStitcher.h"
@@ -37,6 +39,34 @@
 namespace cura
 {
 
+#if defined(BUILD_TESTS) || defined(BUILD_BENCHMARKS)
+std::atomic<size_t> Shape::copy_count_{ 0 };
+
+Shape::Shape(const Shape& other)
+    : LinesSet<Polygon>(other)
+{
+    if (! other.empty())
+    {
+        copy_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+Shape& Shape::operator=(const Shape& other)
+{
+    LinesSet<Polygon>::operator=(other);
+    if (! other.empty())
+    {
+        copy_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+size_t Shape::getCopyCount()
+{
+    return copy_count_.load(std::memory_order_relaxed);
+}
+#endif
+
 Shape::Shape(ClipperLib::Paths&& paths, bool explicitely_closed)
 {
     emplace_back(std::move(paths), explicitely_closed);
@@ -139,7 +169,7 @@ void Shape::makeConvex()
     setLines({ convexified });
 }
 
-Shape Shape::difference(const Shape& other) const
+Shape Shape::difference(const Shape& other) const&
 {
     if (empty())
     {
@@ -149,12 +179,16 @@ Shape Shape::difference(const Shape& other) const
     {
         return *this;
     }
-    ClipperLib::Paths ret;
-    ClipperLib::Clipper clipper(clipper_init);
-    addPaths(clipper, ClipperLib::ptSubject);
-    other.addPaths(clipper, ClipperLib::ptClip);
-    clipper.Execute(ClipperLib::ctDifference, ret);
-    return Shape(std::move(ret));
+    return PolygonBooleanBackend::get().clip(ClipperLib::ctDifference, getLines(), other.getLines(), ClipperLib::pftEvenOdd);
+}
+
+Shape Shape::difference(const Shape& other) &&
+{
+    if (other.empty())
+    {
+        return std::move(*this);
+    }
+    return std::as_const(*this).difference(other);
 }
 
 Shape Shape::difference(const Polygon& other) const
@@ -167,12 +201,7 @@ Shape Shape::difference(const Polygon& other) const
     {
         return *this;
     }
-    ClipperLib::Paths ret;
-    ClipperLib::Clipper clipper(clipper_init);
-    addPaths(clipper, ClipperLib::ptSubject);
-    addPath(clipper, other, ClipperLib::ptClip);
-    clipper.Execute(ClipperLib::ctDifference, ret);
-    return Shape(std::move(ret));
+    return PolygonBooleanBackend::get().clip(ClipperLib::ctDifference, getLines(), std::span(&other, 1), ClipperLib::pftEvenOdd);
 }
 
 Shape Shape::unionPolygons(const Shape& other, ClipperLib::PolyFillType fill_type) const
@@ -182,12 +211,7 @@ Shape Shape::unionPolygons(const Shape& other, ClipperLib::PolyFillType fill_typ
         return {};
     }
     // No further early outs, as shapes should be able to be 'unioned' with themselves, which will resolve certain issues like self-overlapping polygons.
-    ClipperLib::Paths ret;
-    ClipperLib::Clipper clipper(clipper_init);
-    addPaths(clipper, ClipperLib::ptSubject);
-    other.addPaths(clipper, ClipperLib::ptSubject);
-    clipper.Execute(ClipperLib::ctUnion, ret, fill_type, fill_type);
-    return Shape{ std::move(ret) };
+    return PolygonBooleanBackend::get().clip(ClipperLib::ctUnion, getLines(), other.getLines(), fill_type);
 }
 
 Shape Shape::unionPolygons(const Polygon& polygon, ClipperLib::PolyFillType fill_type) const
@@ -197,12 +221,7 @@ Shape Shape::unionPolygons(const Polygon& polygon, ClipperLib::PolyFillType fill
         return {};
     }
     // No further early outs, as unioning even with another empty polygon has some beneficial side-effects, such as removing self-overlapping polygons.
-    ClipperLib::Paths ret;
-    ClipperLib::Clipper clipper(clipper_init);
-    addPaths(clipper, ClipperLib::ptSubject);
-    addPath(clipper, polygon, ClipperLib::ptSubject);
-    clipper.Execute(ClipperLib::ctUnion, ret, fill_type, fill_type);
-    return Shape{ std::move(ret) };
+    return PolygonBooleanBackend::get().clip(ClipperLib::ctUnion, getLines(), std::span(&polygon, 1), fill_type);
 }
 
 Shape Shape::unionPolygons() const
@@ -216,15 +235,10 @@ Shape Shape::intersection(const Shape& other) const
     {
         return {};
     }
-    ClipperLib::Paths ret;
-    ClipperLib::Clipper clipper(clipper_init);
-    addPaths(clipper, ClipperLib::ptSubject);
-    other.addPaths(clipper, ClipperLib::ptClip);
-    clipper.Execute(ClipperLib::ctIntersection, ret);
-    return Shape{ std::move(ret) };
+    return PolygonBooleanBackend::get().clip(ClipperLib::ctIntersection, getLines(), other.getLines(), ClipperLib::pftEvenOdd);
 }
 
-Shape Shape::offset(coord_t distance, ClipperLib::JoinType join_type, double miter_limit) const
+Shape Shape::offset(coord_t distance, ClipperLib::JoinType join_type, double miter_limit) const&
 {
     if (empty())
     {
@@ -235,12 +249,16 @@ Shape Shape::offset(coord_t distance, ClipperLib::JoinType join_type, double mit
         return *this;
     }
 
-    ClipperLib::Paths ret;
-    ClipperLib::ClipperOffset clipper(miter_limit, 10.0);
-    unionPolygons().addPaths(clipper, join_type, ClipperLib::etClosedPolygon);
-    clipper.MiterLimit = miter_limit;
-    clipper.Execute(ret, static_cast<double>(distance));
-    return Shape{ std::move(ret) };
+    return PolygonBooleanBackend::get().offset(unionPolygons().getLines(), distance, join_type, miter_limit);
+}
+
+Shape Shape::offset(coord_t distance, ClipperLib::JoinType join_type, double miter_limit) &&
+{
+    if (distance == 0)
+    {
+        return std::move(*this);
+    }
+    return std::as_const(*this).offset(distance, join_type, miter_limit);
 }
 
 bool Shape::inside(const Point2LL& p, bool border_result) const
@@ -376,12 +394,7 @@ Shape Shape::xorPolygons(const Shape& other, ClipperLib::PolyFillType pft) const
     {
         return *this;
     }
-    ClipperLib::Paths ret;
-    ClipperLib::Clipper clipper(clipper_init);
-    addPaths(clipper, ClipperLib::ptSubject);
-    other.addPaths(clipper, ClipperLib::ptClip);
-    clipper.Execute(ClipperLib::ctXor, ret, pft);
-    return Shape{ std::move(ret) };
+    return PolygonBooleanBackend::get().clip(ClipperLib::ctXor, getLines(), other.getLines(), pft);
 }
 
 Shape Shape::execute(ClipperLib::PolyFillType pft) const
@@ -441,7 +454,7 @@ Shape Shape::offsetMulti(const std::vector<coord_t>& offset_dists) const
     return Shape(std::move(ret));
 }
 
-Shape Shape::getOutsidePolygons() const
+Shape Shape::getOutsidePolygons() const&
 {
     if (empty())
     {
@@ -466,6 +479,15 @@ Shape Shape::getOutsidePolygons() const
     return ret;
 }
 
+Shape Shape::getOutsidePolygons() &&
+{
+    if (size() == 1)
+    {
+        return std::move(*this);
+    }
+    return std::as_const(*this).getOutsidePolygons();
+}
+
 void Shape::removeEmptyHolesProcessPolyTreeNode(const ClipperLib::PolyNode& node, const bool remove_holes, Shape& ret) const
 {
     for (size_t outer_poly_idx = 0; outer_poly_idx < static_cast<size_t>(node.ChildCount()); outer_poly_idx++)
@@ -714,37 +736,7 @@ double Shape::area() const
 
 std::vector<SingleShape> Shape::splitIntoParts(bool union_all) const
 {
-    std::vector<SingleShape> ret;
-    ClipperLib::Clipper clipper(clipper_init);
-    ClipperLib::PolyTree result_poly_tree;
-    addPaths(clipper, ClipperLib::ptSubject);
-    if (union_all)
-    {
-        clipper.Execute(ClipperLib::ctUnion, result_poly_tree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
-    }
-    else
-    {
-        clipper.Execute(ClipperLib::ctUnion, result_poly_tree);
-    }
-
-    splitIntoPartsProcessPolyTreeNode(&result_poly_tree, ret);
-    return ret;
-}
-
-void Shape::splitIntoPartsProcessPolyTreeNode(ClipperLib::PolyNode* node, std::vector<SingleShape>& ret) const
-{
-    for (size_t n = 0; n < static_cast<size_t>(node->ChildCount()); n++)
-    {
-        ClipperLib::PolyNode* child = node->Childs[n];
-        SingleShape part;
-        part.emplace_back(std::move(child->Contour));
-        for (size_t i = 0; i < static_cast<size_t>(child->ChildCount()); i++)
-        {
-            part.emplace_back(std::move(child->Childs[i]->Contour));
-            splitIntoPartsProcessPolyTreeNode(child->Childs[i], ret);
-        }
-        ret.push_back(std::move(part));
-    }
+    return PolygonBooleanBackend::get().splitIntoParts(*this, union_all ? ClipperLib::pftNonZero : ClipperLib::pftEvenOdd);
 }
 
 std::vector<Shape> Shape::sortByNesting() const
@@ -6,8 +6,12 @@
 #include <algorithm> //For std::sort.
 #include <functional>
 #include <numbers>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 
+#include <boost/functional/hash.hpp>
 #include <scripta/logger.h>
 #include <spdlog/spdlog.h>
 
@@ -26,6 +30,7 @@
 #include "sliceDataStorage.h"
 #include "utils/OpenPolylineStitcher.h"
 #include "utils/PolygonConnector.h"
+#include "utils/ResultCache.h"
 #include "utils/Simplify.h"
 #include "utils/UnionFind.h"
 #include "utils/linearAlg2D.h"
@@ -55,6 +60,113 @@ static inline int computeScanSegmentIdx(int x, int line_width)
 namespace cura
 {
 
+#ifdef ENABLE_PLUGINS
+namespace
+{
+
+/*!
+ * The settings that are sent to the plugin, sorted by key so that equal settings compare equal.
+ */
+using PluginSettings = std::vector<std::pair<std::string, std::string>>;
+
+/*!
+ * Identifies a result of the infill generate plugin: the plugin, what is sent to it and the area to fill.
+ */
+struct PluginInfillKey
+{
+    std::string plugin;
+    std::string pattern;
+    PluginSettings settings;
+    size_t settings_hash; //!< Hash of \ref settings, to quickly tell different settings apart
+    Shape contour;
+
+    bool operator==(const PluginInfillKey& other) const
+    {
+        return plugin == other.plugin && pattern == other.pattern && settings_hash == other.settings_hash && settings == other.settings
+            && std::equal(
+                   contour.begin(),
+                   contour.end(),
+                   other.contour.begin(),
+                   other.contour.end(),
+                   [](const Polygon& polygon, const Polygon& other_polygon)
+                   {
+                       return polygon.getPoints() == other_polygon.getPoints();
+                   });
+    }
+};
+
+struct PluginInfillKeyHash
+{
+    size_t operator()(const PluginInfillKey& key) const
+    {
+        size_t hash = key.settings_hash;
+        boost::hash_combine(hash, key.plugin);
+        boost::hash_combine(hash, key.pattern);
+        for (const Polygon& polygon : key.contour)
+        {
+            boost::hash_combine(hash, polygon.size());
+            for (const Point2LL& point : polygon)
+            {
+                boost::hash_combine(hash, point.X);
+                boost::hash_combine(hash, point.Y);
+            }
+        }
+        return hash;
+    }
+};
+
+using PluginInfillResult = std::tuple<std::vector<VariableWidthLines>, Shape, OpenLinesSet>;
+
+/*!
+ * Get all settings that are sent to the plugin, in a fixed order.
+ */
+PluginSettings getPluginSettings(const Settings& settings)
+{
+    const std::unordered_map<std::string, std::string> flattened = settings.getFlattendSettings();
+    PluginSettings result(flattened.begin(), flattened.end());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+size_t estimateMemoryUsage(const PluginInfillKey& key, const PluginInfillResult& result)
+{
+    const auto& [toolpaths, polygons, lines] = result;
+    size_t junction_count = 0;
+    for (const VariableWidthLines& inset : toolpaths)
+    {
+        for (const ExtrusionLine& line : inset)
+        {
+            junction_count += line.junctions_.size();
+        }
+    }
+    size_t settings_size = 0;
+    for (const auto& [setting_key, value] : key.settings)
+    {
+        settings_size += sizeof(PluginSettings::value_type) + setting_key.size() + value.size();
+    }
+    return settings_size + junction_count * sizeof(ExtrusionJunction) + (key.contour.pointCount() + polygons.pointCount() + lines.pointCount()) * sizeof(Point2LL);
+}
+
+/*!
+ * The results of the infill generate plugin, shared by all layers and parts so that a repeated area is only sent to the plugin once.
+ */
+ResultCache<PluginInfillKey, PluginInfillResult, PluginInfillKeyHash>& pluginInfillCache()
+{
+    constexpr size_t max_bytes = 256 * 1024 * 1024;
+    static ResultCache<PluginInfillKey, PluginInfillResult, PluginInfillKeyHash> cache(max_bytes);
+    return cache;
+}
+
+} // namespace
+#endif // ENABLE_PLUGINS
+
+void Infill::clearPluginResults()
+{
+#ifdef ENABLE_PLUGINS
+    pluginInfillCache().clear();
+#endif // ENABLE_PLUGINS
+}
+
 Shape Infill::generateWallToolPaths(
     std::vector<VariableWidthLines>& toolpaths,
     const Shape& outer_contour,
@@ -87,7 +199,7 @@ void Infill::generate(
     int layer_idx,
     SectionType section_type,
     const std::shared_ptr<SierpinskiFillProvider>& cross_fill_provider,
-    const std::shared_ptr<LightningLayer>& lightning_trees,
+    const std::shared_ptr<const LightningLayer>& lightning_trees,
     const SliceMeshStorage* mesh,
     const Shape& prevent_small_exposed_to_air)
 {
@@ -255,7 +367,7 @@ void Infill::_generate(
     OpenLinesSet& result_lines,
     const Settings& settings,
     const std::shared_ptr<SierpinskiFillProvider>& cross_fill_provider,
-    const std::shared_ptr<LightningLayer>& lightning_trees,
+    const std::shared_ptr<const LightningLayer>& lightning_trees,
     const SliceMeshStorage* mesh)
 {
     if (inner_contour_.empty())
@@ -319,10 +431,22 @@ void Infill::_generate(
     case EFillMethod::PLUGIN:
     {
 #ifdef ENABLE_PLUGINS // FIXME: I don't like this conditional block outside of the plugin scope.
-        auto [toolpaths_, generated_result_polygons_, generated_result_lines_] = slots::instance().generate<plugins::v0::SlotID::INFILL_GENERATE>(
-            inner_contour_,
-            mesh ? mesh->settings.get<std::string>("infill_pattern") : settings.get<std::string>("infill_pattern"),
-            mesh ? mesh->settings : settings);
+        const Settings& plugin_settings = mesh ? mesh->settings : settings;
+        PluginSettings sent_settings = getPluginSettings(plugin_settings);
+        const size_t settings_hash = boost::hash_range(sent_settings.begin(), sent_settings.end());
+        PluginInfillKey key{ slots::instance().get<plugins::v0::SlotID::INFILL_GENERATE>().getPluginIdentity(),
+                             plugin_settings.get<std::string>("infill_pattern"),
+                             std::move(sent_settings),
+                             settings_hash,
+                             inner_contour_ };
+        std::optional<PluginInfillResult> cached_result = pluginInfillCache().get(key);
+        if (! cached_result)
+        {
+            cached_result = slots::instance().generate<plugins::v0::SlotID::INFILL_GENERATE>(inner_contour_, key.pattern, plugin_settings);
+            const size_t memory_usage = estimateMemoryUsage(key, *cached_result);
+            pluginInfillCache().put(key, *cached_result, memory_usage);
+        }
+        auto& [toolpaths_, generated_result_polygons_, generated_result_lines_] = *cached_result;
         toolpaths.insert(toolpaths.end(), toolpaths_.begin(), toolpaths_.end());
         result_polygons.push_back(generated_result_polygons_);
         result_lines.push_back(generated_result_lines_);
@@ -425,7 +549,7 @@ void Infill::generateGyroidInfill(OpenLinesSet& result_lines, Shape& result_poly
     OpenPolylineStitcher::stitch(line_segments, result_lines, result_polygons, infill_line_width_);
 }
 
-void Infill::generateLightningInfill(const std::shared_ptr<LightningLayer>& trees, OpenLinesSet& result_lines)
+void Infill::generateLightningInfill(const std::shared_ptr<const LightningLayer>& trees, OpenLinesSet& result_lines)
 {
     // Don't need to support areas smaller than line width, as they are always within radius:
     if (std::abs(inner_contour_.area()) < infill_line_width_ || ! trees)
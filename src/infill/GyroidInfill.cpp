@@ -9,6 +9,7 @@
 #include "geometry/Polygon.h"
 #include "geometry/Shape.h"
 #include "utils/AABB.h"
+#include "utils/ShapeInsideIndex.h"
 #include "utils/linearAlg2D.h"
 
 namespace cura
@@ -28,6 +29,7 @@ void GyroidInfill::generateTotalGyroidInfill(OpenLinesSet& result_lines, bool zi
     // kudos to the author of the Slic3r implementation equation code, the equation code here is based on that
 
     const AABB aabb(in_outline);
+    const ShapeInsideIndex outline_index(in_outline); // Every point of the gyroid lines within the bounding box is tested against the outline.
 
     int pitch = line_distance * 2.41; // this produces similar density to the "line" infill pattern
     int num_steps = 4;
@@ -78,7 +80,7 @@ void GyroidInfill::generateTotalGyroidInfill(OpenLinesSet& result_lines, bool zi
                 for (unsigned i = 0; i < num_coords; ++i)
                 {
                     Point2LL current(x + ((num_columns & 1) ? odd_line_coords[i] : even_line_coords[i]) / 2 + pitch, y + (coord_t)(i * step));
-                    bool current_inside = in_outline.inside(current, true);
+                    bool current_inside = outline_index.inside(current, true);
                     if (! is_first_point)
                     {
                         if (last_inside && current_inside)
@@ -170,7 +172,7 @@ void GyroidInfill::generateTotalGyroidInfill(OpenLinesSet& result_lines, bool zi
                 for (unsigned i = 0; i < num_coords; ++i)
                 {
                     Point2LL current(x + (coord_t)(i * step), y + ((num_rows & 1) ? odd_line_coords[i] : even_line_coords[i]) / 2);
-                    bool current_inside = in_outline.inside(current, true);
+                    bool current_inside = outline_index.inside(current, true);
                     if (! is_first_point)
                     {
                         if (last_inside && current_inside)
@@ -20,11 +20,11 @@ coord_t LightningLayer::getWeightedDistance(const Point2LL& boundary_loc, const
     return vSize(boundary_loc - unsupported_location);
 }
 
-Point2LL GroundingLocation::p() const
+Point2LL GroundingLocation::p(const LightningTreeForest& forest) const
 {
-    if (tree_node != nullptr)
+    if (tree_node != no_lightning_node)
     {
-        return tree_node->getLocation();
+        return forest.getLocation(tree_node);
     }
     else
     {
@@ -33,15 +33,15 @@ Point2LL GroundingLocation::p() const
     }
 }
 
-void LightningLayer::fillLocator(SparseLightningTreeNodeGrid& tree_node_locator)
+void LightningLayer::fillLocator(SparseLightningTreeNodeGrid& tree_node_locator) const
 {
-    std::function<void(LightningTreeNodeSPtr)> add_node_to_locator_func = [&tree_node_locator](LightningTreeNodeSPtr node)
+    const auto add_node_to_locator_func = [this, &tree_node_locator](const LightningNodeIdx node)
     {
-        tree_node_locator.insert(node->getLocation(), node);
+        tree_node_locator.insert(forest.getLocation(node), node);
     };
-    for (auto& tree : tree_roots)
+    for (const LightningNodeIdx tree : tree_roots)
     {
-        tree->visitNodes(add_node_to_locator_func);
+        forest.visitNodes(tree, add_node_to_locator_func);
     }
 }
 
@@ -65,17 +65,17 @@ void LightningLayer::generateNewTrees(
         GroundingLocation grounding_loc
             = getBestGroundingLocation(unsupported_location, current_outlines, outlines_locator, supporting_radius, wall_supporting_radius, tree_node_locator);
 
-        LightningTreeNodeSPtr new_parent;
-        LightningTreeNodeSPtr new_child;
+        LightningNodeIdx new_parent = no_lightning_node;
+        LightningNodeIdx new_child = no_lightning_node;
         attach(unsupported_location, grounding_loc, new_child, new_parent);
-        tree_node_locator.insert(new_child->getLocation(), new_child);
-        if (new_parent)
+        tree_node_locator.insert(forest.getLocation(new_child), new_child);
+        if (new_parent != no_lightning_node)
         {
-            tree_node_locator.insert(new_parent->getLocation(), new_parent);
+            tree_node_locator.insert(forest.getLocation(new_parent), new_parent);
         }
 
         // update distance field
-        distance_field.update(grounding_loc.p(), unsupported_location);
+        distance_field.update(grounding_loc.p(forest), unsupported_location);
     }
 }
 
@@ -86,7 +86,7 @@ GroundingLocation LightningLayer::getBestGroundingLocation(
     const coord_t supporting_radius,
     const coord_t wall_supporting_radius,
     const SparseLightningTreeNodeGrid& tree_node_locator,
-    const LightningTreeNodeSPtr& exclude_tree)
+    const LightningNodeIdx exclude_tree)
 {
     ClosestPointPolygon cpp = PolygonUtils::findClosest(unsupported_location, current_outlines);
     Point2LL node_location = cpp.p();
@@ -94,18 +94,17 @@ GroundingLocation LightningLayer::getBestGroundingLocation(
 
     PolygonsPointIndex dummy;
 
-    LightningTreeNodeSPtr sub_tree{ nullptr };
+    LightningNodeIdx sub_tree = no_lightning_node;
     coord_t current_dist = getWeightedDistance(node_location, unsupported_location);
     if (current_dist >= wall_supporting_radius) // Only reconnect tree roots to other trees if they are not already close to the outlines.
     {
         auto candidate_trees = tree_node_locator.getNearbyVals(unsupported_location, std::min(current_dist, within_dist));
-        for (auto& candidate_wptr : candidate_trees)
+        for (const LightningNodeIdx candidate_sub_tree : candidate_trees)
         {
-            auto candidate_sub_tree = candidate_wptr.lock();
-            if ((candidate_sub_tree && candidate_sub_tree != exclude_tree) && ! (exclude_tree && exclude_tree->hasOffspring(candidate_sub_tree))
-                && ! PolygonUtils::polygonCollidesWithLineSegment(unsupported_location, candidate_sub_tree->getLocation(), outline_locator, &dummy))
+            if (candidate_sub_tree != exclude_tree && ! (exclude_tree != no_lightning_node && forest.hasOffspring(exclude_tree, candidate_sub_tree))
+                && ! PolygonUtils::polygonCollidesWithLineSegment(unsupported_location, forest.getLocation(candidate_sub_tree), outline_locator, &dummy))
             {
-                const coord_t candidate_dist = candidate_sub_tree->getWeightedDistance(unsupported_location, supporting_radius);
+                const coord_t candidate_dist = forest.getWeightedDistance(candidate_sub_tree, unsupported_location, supporting_radius);
                 if (candidate_dist < current_dist)
                 {
                     current_dist = candidate_dist;
@@ -115,9 +114,9 @@ GroundingLocation LightningLayer::getBestGroundingLocation(
         }
     }
 
-    if (! sub_tree)
+    if (sub_tree == no_lightning_node)
     {
-        return GroundingLocation{ nullptr, cpp };
+        return GroundingLocation{ no_lightning_node, cpp };
     }
     else
     {
@@ -125,25 +124,26 @@ GroundingLocation LightningLayer::getBestGroundingLocation(
     }
 }
 
-bool LightningLayer::attach(const Point2LL& unsupported_location, const GroundingLocation& grounding_loc, LightningTreeNodeSPtr& new_child, LightningTreeNodeSPtr& new_root)
+bool LightningLayer::attach(const Point2LL& unsupported_location, const GroundingLocation& grounding_loc, LightningNodeIdx& new_child, LightningNodeIdx& new_root)
 {
     // Update trees & distance fields.
     if (grounding_loc.boundary_location)
     {
-        new_root = LightningTreeNode::create(grounding_loc.p(), std::make_optional(grounding_loc.p()));
-        new_child = new_root->addChild(unsupported_location);
+        const Point2LL ground = grounding_loc.p(forest);
+        new_root = forest.createNode(ground, std::make_optional(ground));
+        new_child = forest.addChild(new_root, unsupported_location);
         tree_roots.push_back(new_root);
         return true;
     }
     else
     {
-        new_child = grounding_loc.tree_node->addChild(unsupported_location);
+        new_child = forest.addChild(grounding_loc.tree_node, unsupported_location);
         return false;
     }
 }
 
 void LightningLayer::reconnectRoots(
-    std::vector<LightningTreeNodeSPtr>& to_be_reconnected_tree_roots,
+    const std::vector<LightningNodeIdx>& to_be_reconnected_tree_roots,
     const Shape& current_outlines,
     const LocToLineGrid& outline_locator,
     const coord_t supporting_radius,
@@ -155,24 +155,25 @@ void LightningLayer::reconnectRoots(
     fillLocator(tree_node_locator);
 
     const coord_t within_max_dist = outline_locator.getCellSize() * 2;
-    for (auto root_ptr : to_be_reconnected_tree_roots)
+    for (const LightningNodeIdx root : to_be_reconnected_tree_roots)
     {
-        auto old_root_it = std::find(tree_roots.begin(), tree_roots.end(), root_ptr);
+        auto old_root_it = std::find(tree_roots.begin(), tree_roots.end(), root);
+        const Point2LL root_location = forest.getLocation(root);
 
-        if (root_ptr->getLastGroundingLocation())
+        if (forest.getLastGroundingLocation(root))
         {
-            const Point2LL& ground_loc = root_ptr->getLastGroundingLocation().value();
-            if (ground_loc != root_ptr->getLocation())
+            const Point2LL ground_loc = forest.getLastGroundingLocation(root).value();
+            if (ground_loc != root_location)
             {
                 Point2LL new_root_pt;
-                if (PolygonUtils::lineSegmentPolygonsIntersection(root_ptr->getLocation(), ground_loc, current_outlines, outline_locator, new_root_pt, within_max_dist))
+                if (PolygonUtils::lineSegmentPolygonsIntersection(root_location, ground_loc, current_outlines, outline_locator, new_root_pt, within_max_dist))
                 {
-                    auto new_root = LightningTreeNode::create(new_root_pt, new_root_pt);
-                    root_ptr->addChild(new_root);
-                    new_root->reroot();
+                    const LightningNodeIdx new_root = forest.createNode(new_root_pt, new_root_pt);
+                    forest.addChild(root, new_root);
+                    forest.reroot(new_root);
 
-                    tree_node_locator.insert(new_root->getLocation(), new_root);
-                    *old_root_it = std::move(new_root); // replace old root with new root
+                    tree_node_locator.insert(new_root_pt, new_root);
+                    *old_root_it = new_root; // replace old root with new root
                     continue;
                 }
             }
@@ -181,37 +182,38 @@ void LightningLayer::reconnectRoots(
         const coord_t tree_connecting_ignore_width
             = wall_supporting_radius - tree_connecting_ignore_offset; // Ideally, the boundary size in which the valence rule is ignored would be configurable.
         GroundingLocation ground
-            = getBestGroundingLocation(root_ptr->getLocation(), current_outlines, outline_locator, supporting_radius, tree_connecting_ignore_width, tree_node_locator, root_ptr);
+            = getBestGroundingLocation(root_location, current_outlines, outline_locator, supporting_radius, tree_connecting_ignore_width, tree_node_locator, root);
         if (ground.boundary_location)
         {
-            if (ground.boundary_location.value().p() == root_ptr->getLocation())
+            if (ground.boundary_location.value().p() == root_location)
             {
                 continue; // Already on the boundary.
             }
 
-            auto new_root = LightningTreeNode::create(ground.p(), ground.p());
-            auto attach_ptr = root_ptr->closestNode(new_root->getLocation());
-            attach_ptr->reroot();
+            const Point2LL new_root_pt = ground.p(forest);
+            const LightningNodeIdx new_root = forest.createNode(new_root_pt, new_root_pt);
+            const LightningNodeIdx attach_node = forest.closestNode(root, new_root_pt);
+            forest.reroot(attach_node);
 
-            new_root->addChild(attach_ptr);
-            tree_node_locator.insert(new_root->getLocation(), new_root);
+            forest.addChild(new_root, attach_node);
+            tree_node_locator.insert(new_root_pt, new_root);
 
-            *old_root_it = std::move(new_root); // replace old root with new root
+            *old_root_it = new_root; // replace old root with new root
         }
         else
         {
-            assert(ground.tree_node);
-            assert(ground.tree_node != root_ptr);
-            assert(! root_ptr->hasOffspring(ground.tree_node));
-            assert(! ground.tree_node->hasOffspring(root_ptr));
+            assert(ground.tree_node != no_lightning_node);
+            assert(ground.tree_node != root);
+            assert(! forest.hasOffspring(root, ground.tree_node));
+            assert(! forest.hasOffspring(ground.tree_node, root));
 
-            auto attach_ptr = root_ptr->closestNode(ground.tree_node->getLocation());
-            attach_ptr->reroot();
+            const LightningNodeIdx attach_node = forest.closestNode(root, forest.getLocation(ground.tree_node));
+            forest.reroot(attach_node);
 
-            ground.tree_node->addChild(attach_ptr);
+            forest.addChild(ground.tree_node, attach_node);
 
             // remove old root
-            *old_root_it = std::move(tree_roots.back());
+            *old_root_it = tree_roots.back();
             tree_roots.pop_back();
         }
     }
@@ -226,9 +228,9 @@ OpenLinesSet LightningLayer::convertToLines(const Shape& limit_to_outline, const
         return result_lines;
     }
 
-    for (const LightningTreeNodeSPtr& tree : tree_roots)
+    for (const LightningNodeIdx tree : tree_roots)
     {
-        tree->convertToPolylines(result_lines, line_width);
+        forest.convertToPolylines(tree, result_lines, line_width);
     }
     result_lines = limit_to_outline.intersection(result_lines);
 
@@ -8,158 +8,232 @@
 
 using namespace cura;
 
-using LightningTreeNodeSPtr = std::shared_ptr<LightningTreeNode>;
+void LightningTreeForest::reserve(const size_t node_count)
+{
+    nodes_.reserve(node_count);
+}
+
+size_t LightningTreeForest::size() const
+{
+    return nodes_.size();
+}
 
-coord_t LightningTreeNode::getWeightedDistance(const Point2LL& unsupported_location, const coord_t& supporting_radius) const
+LightningNodeIdx LightningTreeForest::createNode(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location /*= std::nullopt*/)
+{
+    LightningTreeNode& node = nodes_.emplace_back();
+    node.p = p;
+    node.last_grounding_location = last_grounding_location;
+    return static_cast<LightningNodeIdx>(nodes_.size() - 1);
+}
+
+coord_t LightningTreeForest::getWeightedDistance(const LightningNodeIdx node, const Point2LL& unsupported_location, const coord_t& supporting_radius) const
 {
     constexpr coord_t min_valence_for_boost = 0;
     constexpr coord_t max_valence_for_boost = 4;
     constexpr coord_t valence_boost_multiplier = 4;
 
-    const size_t valence = (! is_root_) + children_.size();
+    const LightningTreeNode& here = nodes_[node];
+    const size_t valence = (! here.isRoot()) + here.child_count;
     const coord_t valence_boost = (min_valence_for_boost < valence && valence < max_valence_for_boost) ? valence_boost_multiplier * supporting_radius : 0;
-    const coord_t dist_here = vSize(getLocation() - unsupported_location);
+    const coord_t dist_here = vSize(here.p - unsupported_location);
     return dist_here - valence_boost;
 }
 
-bool LightningTreeNode::hasOffspring(const LightningTreeNodeSPtr& to_be_checked) const
+bool LightningTreeForest::hasOffspring(const LightningNodeIdx node, const LightningNodeIdx to_be_checked) const
 {
-    if (to_be_checked == shared_from_this())
+    if (to_be_checked == node)
     {
         return true;
     }
-    for (auto& child_ptr : children_)
+    for (LightningNodeIdx child = nodes_[node].first_child; child != no_lightning_node; child = nodes_[child].next_sibling)
     {
-        if (child_ptr->hasOffspring(to_be_checked))
+        if (hasOffspring(child, to_be_checked))
             return true;
     }
     return false;
 }
 
-const Point2LL& LightningTreeNode::getLocation() const
+const Point2LL& LightningTreeForest::getLocation(const LightningNodeIdx node) const
 {
-    return p_;
+    return nodes_[node].p;
 }
 
-void LightningTreeNode::setLocation(const Point2LL& loc)
+void LightningTreeForest::setLocation(const LightningNodeIdx node, const Point2LL& loc)
 {
-    p_ = loc;
+    nodes_[node].p = loc;
 }
 
-LightningTreeNodeSPtr LightningTreeNode::addChild(const Point2LL& child_loc)
+bool LightningTreeForest::isRoot(const LightningNodeIdx node) const
 {
-    assert(p_ != child_loc);
-    LightningTreeNodeSPtr child = LightningTreeNode::create(child_loc);
-    return addChild(child);
+    return nodes_[node].isRoot();
 }
 
-LightningTreeNodeSPtr LightningTreeNode::addChild(LightningTreeNodeSPtr& new_child)
+const std::optional<Point2LL>& LightningTreeForest::getLastGroundingLocation(const LightningNodeIdx node) const
 {
-    assert(new_child != shared_from_this());
+    return nodes_[node].last_grounding_location;
+}
+
+LightningNodeIdx LightningTreeForest::addChild(const LightningNodeIdx parent, const Point2LL& child_loc)
+{
+    assert(nodes_[parent].p != child_loc);
+    const LightningNodeIdx child = createNode(child_loc);
+    return addChild(parent, child);
+}
+
+LightningNodeIdx LightningTreeForest::addChild(const LightningNodeIdx parent, const LightningNodeIdx new_child)
+{
+    assert(new_child != parent);
+    assert(nodes_[new_child].isRoot() && "only roots can be attached to another tree");
     // assert(p != new_child->p); // NOTE: No problem for now. Issue to solve later. Maybe even afetr final. Low prio.
-    children_.push_back(new_child);
-    new_child->parent_ = shared_from_this();
-    new_child->is_root_ = false;
+    linkChild(parent, new_child);
     return new_child;
 }
 
-void LightningTreeNode::propagateToNextLayer(
-    std::vector<LightningTreeNodeSPtr>& next_trees,
-    const Shape& next_outlines,
-    const LocToLineGrid& outline_locator,
-    const coord_t prune_distance,
-    const coord_t smooth_magnitude,
-    const coord_t max_remove_colinear_dist) const
+void LightningTreeForest::linkChild(const LightningNodeIdx parent, const LightningNodeIdx child)
 {
-    auto tree_below = deepCopy();
-
-    tree_below->prune(prune_distance);
-    tree_below->straighten(smooth_magnitude, max_remove_colinear_dist);
-    if (tree_below->realign(next_outlines, outline_locator, next_trees))
+    LightningTreeNode& parent_node = nodes_[parent];
+    LightningTreeNode& child_node = nodes_[child];
+    child_node.parent = parent;
+    child_node.prev_sibling = parent_node.last_child;
+    child_node.next_sibling = no_lightning_node;
+    if (parent_node.last_child != no_lightning_node)
     {
-        next_trees.push_back(tree_below);
+        nodes_[parent_node.last_child].next_sibling = child;
     }
+    else
+    {
+        parent_node.first_child = child;
+    }
+    parent_node.last_child = child;
+    parent_node.child_count++;
 }
 
-// NOTE: Depth-first, as currently implemented.
-//       Skips the root (because that has no root itself), but all initial nodes will have the root point anyway.
-void LightningTreeNode::visitBranches(const std::function<void(const Point2LL&, const Point2LL&)>& visitor) const
+void LightningTreeForest::unlinkChild(const LightningNodeIdx child)
 {
-    for (const auto& node : children_)
+    LightningTreeNode& child_node = nodes_[child];
+    assert(! child_node.isRoot());
+    LightningTreeNode& parent_node = nodes_[child_node.parent];
+    if (child_node.prev_sibling != no_lightning_node)
     {
-        assert(node->parent_.lock() == shared_from_this());
-        visitor(p_, node->p_);
-        node->visitBranches(visitor);
+        nodes_[child_node.prev_sibling].next_sibling = child_node.next_sibling;
     }
+    else
+    {
+        parent_node.first_child = child_node.next_sibling;
+    }
+    if (child_node.next_sibling != no_lightning_node)
+    {
+        nodes_[child_node.next_sibling].prev_sibling = child_node.prev_sibling;
+    }
+    else
+    {
+        parent_node.last_child = child_node.prev_sibling;
+    }
+    parent_node.child_count--;
+    child_node.parent = no_lightning_node;
+    child_node.prev_sibling = no_lightning_node;
+    child_node.next_sibling = no_lightning_node;
 }
 
-// NOTE: Depth-first, as currently implemented.
-void LightningTreeNode::visitNodes(const std::function<void(LightningTreeNodeSPtr)>& visitor)
+void LightningTreeForest::replaceChild(const LightningNodeIdx node, const LightningNodeIdx replacement)
 {
-    visitor(shared_from_this());
-    for (const auto& node : children_)
+    LightningTreeNode& old_node = nodes_[node];
+    LightningTreeNode& new_node = nodes_[replacement];
+    assert(! old_node.isRoot());
+    LightningTreeNode& parent_node = nodes_[old_node.parent];
+
+    new_node.parent = old_node.parent;
+    new_node.prev_sibling = old_node.prev_sibling;
+    new_node.next_sibling = old_node.next_sibling;
+    if (old_node.prev_sibling != no_lightning_node)
     {
-        assert(node->parent_.lock() == shared_from_this());
-        node->visitNodes(visitor);
+        nodes_[old_node.prev_sibling].next_sibling = replacement;
+    }
+    else
+    {
+        parent_node.first_child = replacement;
+    }
+    if (old_node.next_sibling != no_lightning_node)
+    {
+        nodes_[old_node.next_sibling].prev_sibling = replacement;
+    }
+    else
+    {
+        parent_node.last_child = replacement;
     }
-}
 
-LightningTreeNode::LightningTreeNode(const Point2LL& p, const std::optional<Point2LL>& last_grounding_location /*= std::nullopt*/)
-    : is_root_(true)
-    , p_(p)
-    , last_grounding_location_(last_grounding_location)
-{
+    old_node = LightningTreeNode{ old_node.p };
 }
 
-LightningTreeNodeSPtr LightningTreeNode::deepCopy() const
+LightningNodeIdx LightningTreeForest::copyTree(const LightningTreeForest& source, const LightningNodeIdx source_root)
 {
-    LightningTreeNodeSPtr local_root = LightningTreeNode::create(p_);
-    local_root->is_root_ = is_root_;
-    if (is_root_)
+    assert(&source != this && "trees are copied between the forests of different layers");
+    const LightningTreeNode& source_root_node = source.nodes_[source_root];
+    assert(source_root_node.isRoot());
+    const LightningNodeIdx local_root = createNode(source_root_node.p, source_root_node.last_grounding_location.value_or(source_root_node.p));
+
+    // Nodes are copied one sibling list at a time, so the children of each node end up next to each other in the new forest.
+    std::vector<std::pair<LightningNodeIdx, LightningNodeIdx>> to_copy{ { source_root, local_root } }; // Pairs of the source node and its copy.
+    while (! to_copy.empty())
     {
-        local_root->last_grounding_location_ = last_grounding_location_.value_or(p_);
-    }
-    local_root->children_.reserve(children_.size());
-    for (const auto& node : children_)
-    {
-        LightningTreeNodeSPtr child = node->deepCopy();
-        child->parent_ = local_root;
-        local_root->children_.push_back(child);
+        const auto [source_node, local_node] = to_copy.back();
+        to_copy.pop_back();
+        for (LightningNodeIdx source_child = source.nodes_[source_node].first_child; source_child != no_lightning_node; source_child = source.nodes_[source_child].next_sibling)
+        {
+            const LightningNodeIdx local_child = createNode(source.nodes_[source_child].p);
+            linkChild(local_node, local_child);
+            to_copy.emplace_back(source_child, local_child);
+        }
     }
     return local_root;
 }
 
-void LightningTreeNode::reroot(LightningTreeNodeSPtr new_parent /*= nullptr*/)
+void LightningTreeForest::propagateToNextLayer(
+    const LightningNodeIdx root,
+    LightningTreeForest& next_forest,
+    std::vector<LightningNodeIdx>& next_trees,
+    const Shape& next_outlines,
+    const LocToLineGrid& outline_locator,
+    const coord_t prune_distance,
+    const coord_t smooth_magnitude,
+    const coord_t max_remove_colinear_dist) const
 {
-    if (! is_root_)
+    const LightningNodeIdx tree_below = next_forest.copyTree(*this, root);
+
+    next_forest.prune(tree_below, prune_distance);
+    next_forest.straighten(tree_below, smooth_magnitude, max_remove_colinear_dist);
+    if (next_forest.realign(tree_below, next_outlines, outline_locator, next_trees))
     {
-        auto old_parent = parent_.lock();
-        old_parent->reroot(shared_from_this());
-        children_.push_back(old_parent);
+        next_trees.push_back(tree_below);
     }
+}
 
-    if (new_parent)
+void LightningTreeForest::reroot(const LightningNodeIdx node, const LightningNodeIdx new_parent /*= no_lightning_node*/)
+{
+    if (! nodes_[node].isRoot())
     {
-        children_.erase(std::remove(children_.begin(), children_.end(), new_parent), children_.end());
-        is_root_ = false;
-        parent_ = new_parent;
+        const LightningNodeIdx old_parent = nodes_[node].parent;
+        reroot(old_parent, node);
+        linkChild(node, old_parent);
     }
-    else
+
+    if (new_parent != no_lightning_node)
     {
-        is_root_ = true;
-        parent_.reset();
+        // The new parent is still one of the children of this node; remove it there. The caller links this node into the new parent.
+        assert(nodes_[new_parent].parent == node);
+        unlinkChild(new_parent);
     }
 }
 
-LightningTreeNodeSPtr LightningTreeNode::closestNode(const Point2LL& loc)
+LightningNodeIdx LightningTreeForest::closestNode(const LightningNodeIdx node, const Point2LL& loc) const
 {
-    LightningTreeNodeSPtr result = shared_from_this();
-    coord_t closest_dist2 = vSize2(p_ - loc);
+    LightningNodeIdx result = node;
+    coord_t closest_dist2 = vSize2(nodes_[node].p - loc);
 
-    for (const auto& child : children_)
+    for (LightningNodeIdx child = nodes_[node].first_child; child != no_lightning_node; child = nodes_[child].next_sibling)
     {
-        LightningTreeNodeSPtr candidate_node = child->closestNode(loc);
-        const coord_t child_dist2 = vSize2(candidate_node->p_ - loc);
+        const LightningNodeIdx candidate_node = closestNode(child, loc);
+        const coord_t child_dist2 = vSize2(nodes_[candidate_node].p - loc);
         if (child_dist2 < closest_dist2)
         {
             closest_dist2 = child_dist2;
@@ -170,109 +244,107 @@ LightningTreeNodeSPtr LightningTreeNode::closestNode(const Point2LL& loc)
     return result;
 }
 
-bool LightningTreeNode::realign(const Shape& outlines, const LocToLineGrid& outline_locator, std::vector<LightningTreeNodeSPtr>& rerooted_parts)
+bool LightningTreeForest::realign(const LightningNodeIdx node, const Shape& outlines, const LocToLineGrid& outline_locator, std::vector<LightningNodeIdx>& rerooted_parts)
 {
     if (outlines.empty())
     {
         return false;
     }
 
-    if (outlines.inside(p_, true))
+    const Point2LL p = nodes_[node].p;
+    if (outlines.inside(p, true))
     {
         // Only keep children that have an unbroken connection to here, realign will put the rest in rerooted parts due to recursion:
         Point2LL coll;
         bool reground_me = false;
-        const auto remove_unconnected_func{
-            [&](const LightningTreeNodeSPtr& child)
+        for (LightningNodeIdx child = nodes_[node].first_child; child != no_lightning_node;)
+        {
+            const LightningNodeIdx next_child = nodes_[child].next_sibling;
+            bool connect_branch = realign(child, outlines, outline_locator, rerooted_parts);
+            if (connect_branch && PolygonUtils::lineSegmentPolygonsIntersection(nodes_[child].p, p, outlines, outline_locator, coll, outline_locator.getCellSize() * 2))
+            {
+                nodes_[child].last_grounding_location.reset();
+                rerooted_parts.push_back(child);
+
+                reground_me = true;
+                connect_branch = false;
+            }
+            if (! connect_branch)
             {
-                bool connect_branch = child->realign(outlines, outline_locator, rerooted_parts);
-                if (connect_branch && PolygonUtils::lineSegmentPolygonsIntersection(child->p_, p_, outlines, outline_locator, coll, outline_locator.getCellSize() * 2))
-                {
-                    child->last_grounding_location_.reset();
-                    child->parent_.reset();
-                    child->is_root_ = true;
-                    rerooted_parts.push_back(child);
-
-                    reground_me = true;
-                    connect_branch = false;
-                }
-                return ! connect_branch;
+                unlinkChild(child);
             }
-        };
-        children_.erase(std::remove_if(children_.begin(), children_.end(), remove_unconnected_func), children_.end());
+            child = next_child;
+        }
         if (reground_me)
         {
-            last_grounding_location_.reset();
+            nodes_[node].last_grounding_location.reset();
         }
         return true;
     }
 
     // 'Lift' any decendants out of this tree:
-    for (auto& child : children_)
+    for (LightningNodeIdx child = nodes_[node].first_child; child != no_lightning_node;)
     {
-        if (child->realign(outlines, outline_locator, rerooted_parts))
+        const LightningNodeIdx next_child = nodes_[child].next_sibling;
+        if (realign(child, outlines, outline_locator, rerooted_parts))
         {
-            child->last_grounding_location_ = p_;
-            child->parent_.reset();
-            child->is_root_ = true;
+            nodes_[child].last_grounding_location = p;
             rerooted_parts.push_back(child);
         }
+        unlinkChild(child);
+        child = next_child;
     }
-    children_.clear();
 
     return false;
 }
 
-void LightningTreeNode::straighten(const coord_t magnitude, const coord_t max_remove_colinear_dist)
+void LightningTreeForest::straighten(const LightningNodeIdx root, const coord_t magnitude, const coord_t max_remove_colinear_dist)
 {
-    straighten(magnitude, p_, 0, max_remove_colinear_dist * max_remove_colinear_dist);
+    straighten(root, magnitude, nodes_[root].p, 0, max_remove_colinear_dist * max_remove_colinear_dist);
 }
 
-LightningTreeNode::RectilinearJunction
-    LightningTreeNode::straighten(const coord_t magnitude, const Point2LL& junction_above, const coord_t accumulated_dist, const coord_t max_remove_colinear_dist2)
+LightningTreeForest::RectilinearJunction LightningTreeForest::straighten(
+    const LightningNodeIdx node,
+    const coord_t magnitude,
+    const Point2LL& junction_above,
+    const coord_t accumulated_dist,
+    const coord_t max_remove_colinear_dist2)
 {
     constexpr coord_t junction_magnitude_factor_numerator = 3;
     constexpr coord_t junction_magnitude_factor_denominator = 4;
 
     const coord_t junction_magnitude = magnitude * junction_magnitude_factor_numerator / junction_magnitude_factor_denominator;
-    if (children_.size() == 1)
+    if (nodes_[node].child_count == 1)
     {
-        auto child_p = children_.front();
-        coord_t child_dist = vSize(p_ - child_p->p_);
-        RectilinearJunction junction_below = child_p->straighten(magnitude, junction_above, accumulated_dist + child_dist, max_remove_colinear_dist2);
+        LightningNodeIdx child = nodes_[node].first_child;
+        coord_t child_dist = vSize(nodes_[node].p - nodes_[child].p);
+        RectilinearJunction junction_below = straighten(child, magnitude, junction_above, accumulated_dist + child_dist, max_remove_colinear_dist2);
         coord_t total_dist_to_junction_below = junction_below.total_recti_dist;
         Point2LL a = junction_above;
         Point2LL b = junction_below.junction_loc;
+        Point2LL& p = nodes_[node].p;
         if (a != b) // should always be true!
         {
             Point2LL ab = b - a;
             Point2LL destination = a + ab * accumulated_dist / std::max(coord_t(1), total_dist_to_junction_below);
-            if (shorterThen(destination - p_, magnitude))
+            if (shorterThen(destination - p, magnitude))
             {
-                p_ = destination;
+                p = destination;
             }
             else
             {
-                p_ = p_ + normal(destination - p_, magnitude);
+                p = p + normal(destination - p, magnitude);
             }
         }
         { // remove nodes on linear segments
             constexpr coord_t close_enough = 10;
 
-            child_p = children_.front(); // recursive call to straighten might have removed the child
-            const LightningTreeNodeSPtr& parent_node = parent_.lock();
-            if (parent_node && vSize2(child_p->p_ - parent_node->p_) < max_remove_colinear_dist2
-                && LinearAlg2D::getDist2FromLineSegment(parent_node->p_, p_, child_p->p_) < close_enough)
+            child = nodes_[node].first_child; // recursive call to straighten might have removed the child
+            const LightningNodeIdx parent = nodes_[node].parent;
+            if (parent != no_lightning_node && vSize2(nodes_[child].p - nodes_[parent].p) < max_remove_colinear_dist2
+                && LinearAlg2D::getDist2FromLineSegment(nodes_[parent].p, nodes_[node].p, nodes_[child].p) < close_enough)
             {
-                child_p->parent_ = parent_;
-                for (auto& sibling : parent_node->children_)
-                { // find this node among siblings
-                    if (sibling == shared_from_this())
-                    {
-                        sibling = child_p; // replace this node by child
-                        break;
-                    }
-                }
+                replaceChild(node, child); // replace this node by child
             }
         }
         return junction_below;
@@ -280,34 +352,37 @@ LightningTreeNode::RectilinearJunction
     else
     {
         constexpr coord_t weight = 1000;
-        Point2LL junction_moving_dir = normal(junction_above - p_, weight);
+        const Point2LL p = nodes_[node].p;
+        Point2LL junction_moving_dir = normal(junction_above - p, weight);
         bool prevent_junction_moving = false;
-        for (auto& child_p : children_)
+        for (LightningNodeIdx child = nodes_[node].first_child; child != no_lightning_node;)
         {
-            const coord_t child_dist = vSize(p_ - child_p->p_);
-            RectilinearJunction below = child_p->straighten(magnitude, p_, child_dist, max_remove_colinear_dist2);
+            const LightningNodeIdx next_child = nodes_[child].next_sibling; // The child may be replaced by its own child while straightening.
+            const coord_t child_dist = vSize(p - nodes_[child].p);
+            RectilinearJunction below = straighten(child, magnitude, p, child_dist, max_remove_colinear_dist2);
 
-            junction_moving_dir += normal(below.junction_loc - p_, weight);
+            junction_moving_dir += normal(below.junction_loc - p, weight);
             if (below.total_recti_dist < magnitude) // TODO: make configurable?
             {
                 prevent_junction_moving = true; // prevent flipflopping in branches due to straightening and junctoin moving clashing
             }
+            child = next_child;
         }
-        if (junction_moving_dir != Point2LL(0, 0) && ! children_.empty() && ! is_root_ && ! prevent_junction_moving)
+        if (junction_moving_dir != Point2LL(0, 0) && nodes_[node].child_count > 0 && ! nodes_[node].isRoot() && ! prevent_junction_moving)
         {
             coord_t junction_moving_dir_len = vSize(junction_moving_dir);
             if (junction_moving_dir_len > junction_magnitude)
             {
                 junction_moving_dir = junction_moving_dir * junction_magnitude / junction_moving_dir_len;
             }
-            p_ += junction_moving_dir;
+            nodes_[node].p += junction_moving_dir;
         }
-        return RectilinearJunction{ accumulated_dist, p_ };
+        return RectilinearJunction{ accumulated_dist, nodes_[node].p };
     }
 }
 
 // Prune the tree from the extremeties (leaf-nodes) until the pruning distance is reached.
-coord_t LightningTreeNode::prune(const coord_t& pruning_distance)
+coord_t LightningTreeForest::prune(const LightningNodeIdx node, const coord_t& pruning_distance)
 {
     if (pruning_distance <= 0)
     {
@@ -315,78 +390,79 @@ coord_t LightningTreeNode::prune(const coord_t& pruning_distance)
     }
 
     coord_t max_distance_pruned = 0;
-    for (auto child_it = children_.begin(); child_it != children_.end();)
+    for (LightningNodeIdx child = nodes_[node].first_child; child != no_lightning_node;)
     {
-        auto& child = *child_it;
-        coord_t dist_pruned_child = child->prune(pruning_distance);
+        const LightningNodeIdx next_child = nodes_[child].next_sibling;
+        coord_t dist_pruned_child = prune(child, pruning_distance);
         if (dist_pruned_child >= pruning_distance)
         { // pruning is finished for child; dont modify further
             max_distance_pruned = std::max(max_distance_pruned, dist_pruned_child);
-            ++child_it;
         }
         else
         {
-            const Point2LL a = getLocation();
-            const Point2LL b = child->getLocation();
+            const Point2LL a = getLocation(node);
+            const Point2LL b = getLocation(child);
             const Point2LL ba = a - b;
             const coord_t ab_len = vSize(ba);
             if (dist_pruned_child + ab_len <= pruning_distance)
             { // we're still in the process of pruning
-                assert(child->children_.empty() && "when pruning away a node all it's children must already have been pruned away");
+                assert(nodes_[child].child_count == 0 && "when pruning away a node all it's children must already have been pruned away");
                 max_distance_pruned = std::max(max_distance_pruned, dist_pruned_child + ab_len);
-                child_it = children_.erase(child_it);
+                unlinkChild(child);
             }
             else
             { // pruning stops in between this node and the child
                 const Point2LL n = b + normal(ba, pruning_distance - dist_pruned_child);
                 assert(std::abs(vSize(n - b) + dist_pruned_child - pruning_distance) < 10 && "total pruned distance must be equal to the pruning_distance");
                 max_distance_pruned = std::max(max_distance_pruned, pruning_distance);
-                child->setLocation(n);
-                ++child_it;
+                setLocation(child, n);
             }
         }
+        child = next_child;
     }
 
     return max_distance_pruned;
 }
 
-const std::optional<Point2LL>& LightningTreeNode::getLastGroundingLocation() const
-{
-    return last_grounding_location_;
-}
-
-void LightningTreeNode::convertToPolylines(OpenLinesSet& output, const coord_t line_width) const
+void LightningTreeForest::convertToPolylines(const LightningNodeIdx root, OpenLinesSet& output, const coord_t line_width) const
 {
     OpenLinesSet result;
     result.emplace_back();
-    convertToPolylines(0, result);
+    convertToPolylines(root, 0, result);
     removeJunctionOverlap(result, line_width);
     output.push_back(result);
 }
 
-void LightningTreeNode::convertToPolylines(size_t long_line_idx, OpenLinesSet& output) const
+void LightningTreeForest::convertToPolylines(const LightningNodeIdx node, size_t long_line_idx, OpenLinesSet& output) const
 {
-    if (children_.empty())
+    const LightningTreeNode& here = nodes_[node];
+    if (here.child_count == 0)
     {
-        output[long_line_idx].push_back(p_);
+        output[long_line_idx].push_back(here.p);
         return;
     }
-    size_t first_child_idx = rand() % children_.size();
-    children_[first_child_idx]->convertToPolylines(long_line_idx, output);
-    output[long_line_idx].push_back(p_);
+    size_t first_child_idx = rand() % here.child_count;
+    LightningNodeIdx first_child = here.first_child;
+    for (size_t skip = 0; skip < first_child_idx; skip++)
+    {
+        first_child = nodes_[first_child].next_sibling;
+    }
+    convertToPolylines(first_child, long_line_idx, output);
+    output[long_line_idx].push_back(here.p);
 
-    for (size_t idx_offset = 1; idx_offset < children_.size(); idx_offset++)
+    // Continue with the remaining children in order, wrapping around to the first child.
+    LightningNodeIdx child = first_child;
+    for (size_t idx_offset = 1; idx_offset < here.child_count; idx_offset++)
     {
-        size_t child_idx = (first_child_idx + idx_offset) % children_.size();
-        const LightningTreeNode& child = *children_[child_idx];
+        child = nodes_[child].next_sibling != no_lightning_node ? nodes_[child].next_sibling : here.first_child;
         output.emplace_back();
         size_t child_line_idx = output.size() - 1;
-        child.convertToPolylines(child_line_idx, output);
-        output[child_line_idx].push_back(p_);
+        convertToPolylines(child, child_line_idx, output);
+        output[child_line_idx].push_back(here.p);
     }
 }
 
-void LightningTreeNode::removeJunctionOverlap(OpenLinesSet& result_lines, const coord_t line_width) const
+void LightningTreeForest::removeJunctionOverlap(OpenLinesSet& result_lines, const coord_t line_width)
 {
     const coord_t reduction = line_width / 2; // TODO make configurable?
     for (auto poly_it = result_lines.begin(); poly_it != result_lines.end();)
@@ -3,13 +3,19 @@
 
 #include "infill/SubDivCube.h"
 
+#include <array>
 #include <functional>
 
+#include "Application.h"
 #include "geometry/OpenPolyline.h"
 #include "geometry/Polygon.h"
 #include "geometry/Shape.h"
 #include "settings/types/Angle.h" //For the infill angle.
 #include "sliceDataStorage.h"
+#include "utils/AABB.h"
+#include "utils/ShapeInsideIndex.h"
+#include "utils/ThreadPool.h"
+#include "utils/linearAlg2D.h"
 #include "utils/math.h"
 #include "utils/polygonUtils.h"
 
@@ -21,6 +27,25 @@
 namespace cura
 {
 
+struct SubDivCube::MeshInfillAreas
+{
+    /*!
+     * The infill area of a single layer.
+     */
+    struct Layer
+    {
+        Shape area; //!< The infill areas of all parts on the layer.
+        AABB bounding_box; //!< Bounding box of the area, to quickly reject points that are far away from it.
+        size_t point_count = 0; //!< The number of line segments in the area.
+        std::unique_ptr<LocToLineGrid> locator; //!< Finds the line segments of the area near a point.
+        std::unique_ptr<ShapeInsideIndex> inside_index; //!< Tells whether a point is inside the area, without testing every line segment.
+    };
+
+    coord_t layer_height;
+    coord_t locator_cell_size;
+    std::vector<Layer> layers;
+};
+
 std::vector<SubDivCube::CubeProperties> SubDivCube::cube_properties_per_recursion_step_;
 coord_t SubDivCube::radius_addition_ = 0;
 Point3Matrix SubDivCube::rotation_matrix_;
@@ -83,7 +108,59 @@ void SubDivCube::precomputeOctree(SliceMeshStorage& mesh, const Point2LL& infill
 
     rotation_matrix_ = infill_angle_mat.compose(tilt);
 
-    mesh.base_subdiv_cube = std::make_shared<SubDivCube>(mesh, center, curr_recursion_depth - 1);
+    // Every cube probes the infill areas of the layers it spans many times, so prepare those once for all of them.
+    MeshInfillAreas infill_areas;
+    infill_areas.layer_height = mesh.settings.get<coord_t>("layer_height");
+    infill_areas.locator_cell_size = std::max(infill_line_distance, coord_t(1));
+    infill_areas.layers.resize(mesh.layers.size());
+    cura::parallel_for<size_t>(
+        0,
+        mesh.layers.size(),
+        [&](const size_t layer_nr)
+        {
+            MeshInfillAreas::Layer& layer = infill_areas.layers[layer_nr];
+            for (const SliceLayerPart& part : mesh.layers[layer_nr].parts)
+            {
+                layer.area.push_back(part.infill_area);
+            }
+            layer.point_count = layer.area.pointCount();
+            if (layer.point_count == 0)
+            {
+                return;
+            }
+            layer.bounding_box = AABB(layer.area);
+            layer.locator = PolygonUtils::createLocToLineGrid(layer.area, infill_areas.locator_cell_size);
+            layer.inside_index = std::make_unique<ShapeInsideIndex>(layer.area);
+        });
+
+    mesh.base_subdiv_cube = std::make_shared<SubDivCube>(center, curr_recursion_depth - 1);
+
+    // Build the top of the octree breadth-first, until there are enough independent sub-trees to keep all threads busy. Then build those sub-trees in parallel.
+    constexpr size_t subtrees_per_thread = 8;
+    const size_t min_subtree_count = (Application::getInstance().thread_pool_->thread_count() + 1) * subtrees_per_thread;
+    std::vector<SubDivCube*> subtrees{ mesh.base_subdiv_cube.get() };
+    while (! subtrees.empty() && subtrees.size() < min_subtree_count)
+    {
+        std::vector<SubDivCube*> next_subtrees;
+        for (SubDivCube* cube : subtrees)
+        {
+            cube->subdivide(infill_areas, false);
+            for (const std::shared_ptr<SubDivCube>& child : cube->children_)
+            {
+                if (child != nullptr)
+                {
+                    next_subtrees.push_back(child.get());
+                }
+            }
+        }
+        subtrees = std::move(next_subtrees);
+    }
+    cura::parallel_for(
+        subtrees,
+        [&infill_areas](auto cube_it)
+        {
+            (*cube_it)->subdivide(infill_areas, true);
+        });
 }
 
 void SubDivCube::generateSubdivisionLines(const coord_t z, OpenLinesSet& result)
@@ -148,9 +225,13 @@ void SubDivCube::generateSubdivisionLines(const coord_t z, OpenLinesSet (&direct
     }
 }
 
-SubDivCube::SubDivCube(SliceMeshStorage& mesh, Point3LL& center, size_t depth)
+SubDivCube::SubDivCube(const Point3LL& center, size_t depth)
     : depth_(depth)
     , center_(center)
+{
+}
+
+void SubDivCube::subdivide(const MeshInfillAreas& infill_areas, const bool recursive)
 {
     if (depth_ == 0) // lowest layer, no need for subdivision, exit.
     {
@@ -161,40 +242,44 @@ SubDivCube::SubDivCube(SliceMeshStorage& mesh, Point3LL& center, size_t depth)
         return;
     }
 
-    CubeProperties cube_properties = cube_properties_per_recursion_step_[depth];
-    Point3LL child_center;
+    const CubeProperties& cube_properties = cube_properties_per_recursion_step_[depth_];
     coord_t radius = double(cube_properties.height) / 4.0 + radius_addition_;
 
     int child_nr = 0;
-    std::vector<Point3LL> rel_child_centers;
-    rel_child_centers.emplace_back(1, 1, 1); // top
-    rel_child_centers.emplace_back(-1, 1, 1); // top three
-    rel_child_centers.emplace_back(1, -1, 1);
-    rel_child_centers.emplace_back(1, 1, -1);
-    rel_child_centers.emplace_back(-1, -1, -1); // bottom
-    rel_child_centers.emplace_back(1, -1, -1); // bottom three
-    rel_child_centers.emplace_back(-1, 1, -1);
-    rel_child_centers.emplace_back(-1, -1, 1);
-    for (Point3LL rel_child_center : rel_child_centers)
+    static const std::array<Point3LL, 8> rel_child_centers{
+        Point3LL(1, 1, 1), // top
+        Point3LL(-1, 1, 1), // top three
+        Point3LL(1, -1, 1),
+        Point3LL(1, 1, -1),
+        Point3LL(-1, -1, -1), // bottom
+        Point3LL(1, -1, -1), // bottom three
+        Point3LL(-1, 1, -1),
+        Point3LL(-1, -1, 1),
+    };
+    for (const Point3LL& rel_child_center : rel_child_centers)
     {
-        child_center = center + rotation_matrix_.apply(rel_child_center * int32_t(cube_properties.side_length / 4));
-        if (isValidSubdivision(mesh, child_center, radius))
+        const Point3LL child_center = center_ + rotation_matrix_.apply(rel_child_center * int32_t(cube_properties.side_length / 4));
+        if (isValidSubdivision(infill_areas, child_center, radius))
         {
-            children_[child_nr] = std::make_shared<SubDivCube>(mesh, child_center, depth - 1);
+            children_[child_nr] = std::make_shared<SubDivCube>(child_center, depth_ - 1);
+            if (recursive)
+            {
+                children_[child_nr]->subdivide(infill_areas, true);
+            }
             child_nr++;
         }
     }
 }
 
-bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3LL& center, coord_t radius)
+bool SubDivCube::isValidSubdivision(const MeshInfillAreas& infill_areas, const Point3LL& center, coord_t radius)
 {
-    coord_t distance2 = 0;
     coord_t sphere_slice_radius2; //!< squared radius of bounding sphere slice on target layer
     bool inside_somewhere = false;
     bool outside_somewhere = false;
     int inside;
+    bool is_close;
     Ratio part_dist; // what percentage of the radius the target layer is away from the center along the z axis. 0 - 1
-    const coord_t layer_height = mesh.settings.get<coord_t>("layer_height");
+    const coord_t layer_height = infill_areas.layer_height;
     int bottom_layer = (center.z_ - radius) / layer_height;
     int top_layer = (center.z_ + radius) / layer_height;
     for (int test_layer = bottom_layer; test_layer <= top_layer; test_layer += 3) // steps of three. Low-hanging speed gain.
@@ -203,7 +288,7 @@ bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3LL& center, co
         sphere_slice_radius2 = radius * radius * (1.0 - (part_dist * part_dist));
         Point2LL loc(center.x_, center.y_);
 
-        inside = distanceFromPointToMesh(mesh, test_layer, loc, &distance2);
+        inside = distanceFromPointToMesh(infill_areas, test_layer, loc, sphere_slice_radius2, is_close);
         if (inside == 1)
         {
             inside_somewhere = true;
@@ -216,7 +301,7 @@ bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3LL& center, co
         {
             return true;
         }
-        if ((inside != 2) && distance2 < sphere_slice_radius2)
+        if ((inside != 2) && is_close)
         {
             return true;
         }
@@ -224,24 +309,49 @@ bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3LL& center, co
     return false;
 }
 
-coord_t SubDivCube::distanceFromPointToMesh(SliceMeshStorage& mesh, const LayerIndex layer_nr, Point2LL& location, coord_t* distance2)
+int SubDivCube::distanceFromPointToMesh(const MeshInfillAreas& infill_areas, const LayerIndex layer_nr, const Point2LL& location, const coord_t max_distance2, bool& is_close)
 {
-    if (layer_nr < 0 || (unsigned int)layer_nr >= mesh.layers.size()) //!< this layer is outside of valid range
+    is_close = false;
+    if (layer_nr < 0 || (unsigned int)layer_nr >= infill_areas.layers.size()) //!< this layer is outside of valid range
     {
         return 2;
-        *distance2 = 0;
     }
-    Shape collide;
-    for (const SliceLayerPart& part : mesh.layers[layer_nr].parts)
+    const MeshInfillAreas::Layer& layer = infill_areas.layers[layer_nr];
+    if (layer.point_count == 0)
+    {
+        return 0; // Outside, and there is no border to be close to.
+    }
+
+    const bool inside = layer.bounding_box.contains(location) && layer.inside_index->inside(location);
+
+    // The border can't be any closer than the bounding box when outside of it.
+    if (max_distance2 > 0 && layer.bounding_box.distanceSquared(location) < max_distance2)
     {
-        collide.push_back(part.infill_area);
+        const coord_t max_distance = std::sqrt(max_distance2);
+        const coord_t cell_size = infill_areas.locator_cell_size;
+        const size_t query_cell_count = square(2 * max_distance / cell_size + 2);
+        if (query_cell_count < layer.point_count)
+        {
+            // Only look at the line segments near the location, and stop at the first one that is close enough.
+            layer.locator->processNearby(
+                location,
+                max_distance,
+                [&](const PolygonsPointIndex& segment)
+                {
+                    const Point2LL a = segment.p();
+                    const Point2LL b = segment.next().p();
+                    is_close = LinearAlg2D::getDist2FromLineSegment(a, location, b) < max_distance2;
+                    return ! is_close;
+                });
+        }
+        else
+        {
+            // Searching the grid would visit more cells than there are line segments. Just look at all of them.
+            const ClosestPointPolygon border_point = PolygonUtils::findClosest(location, layer.area);
+            is_close = border_point.isValid() && vSize2(border_point.location_ - location) < max_distance2;
+        }
     }
 
-    Point2LL centerpoint = location;
-    bool inside = collide.inside(centerpoint);
-    ClosestPointPolygon border_point = PolygonUtils::moveInside2(collide, centerpoint);
-    Point2LL diff = border_point.location_ - location;
-    *distance2 = vSize2(diff);
     if (inside)
     {
         return 1;
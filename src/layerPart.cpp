@@ -72,13 +72,17 @@ void createLayerWithParts(const Settings& settings, SliceLayer& storageLayer, Sl
         {
             continue;
         }
-        storageLayer.parts.back().outline = part;
+        storageLayer.parts.back().outline = std::move(part);
         storageLayer.parts.back().boundaryBox.calculate(storageLayer.parts.back().outline);
         if (storageLayer.parts.back().outline.empty())
         {
             storageLayer.parts.pop_back();
         }
     }
+
+    // The sliced polygons have been turned into parts, so they are no longer needed.
+    layer->polygons_ = Shape();
+    layer->open_polylines_ = OpenLinesSet();
 }
 
 void createLayerParts(SliceMeshStorage& mesh, Slicer* slicer)
@@ -86,14 +90,23 @@ void createLayerParts(SliceMeshStorage& mesh, Slicer* slicer)
     const auto total_layers = slicer->layers.size();
     assert(mesh.layers.size() == total_layers);
 
-    cura::parallel_for<size_t>(
+    cura::parallel_for_adaptive<size_t>(
+        "Layer parts",
         0,
         total_layers,
         [slicer, &mesh](size_t layer_nr)
         {
             SliceLayer& layer_storage = mesh.layers[layer_nr];
             SlicerLayer& slice_layer = slicer->layers[layer_nr];
+            if (slice_layer.polygons_.empty() && slice_layer.open_polylines_.empty())
+            {
+                return; // Most layers are empty for meshes that are much lower than the highest mesh.
+            }
             createLayerWithParts(mesh.settings, layer_storage, &slice_layer);
+        },
+        [slicer](const size_t layer_nr)
+        {
+            return slicer->layers[layer_nr].polygons_.pointCount() + slicer->layers[layer_nr].open_polylines_.pointCount();
         });
 
     for (LayerIndex layer_nr = total_layers - 1; layer_nr >= 0; layer_nr--)
@@ -58,15 +58,16 @@ void Mesh::addFace(Point3LL& v0, Point3LL& v1, Point3LL& v2)
 
 void Mesh::clear()
 {
-    faces_.clear();
-    vertices_.clear();
-    vertex_hash_map_.clear();
+    // Swap with empty containers, since clearing them would keep their memory allocated.
+    std::vector<MeshFace>().swap(faces_);
+    std::vector<MeshVertex>().swap(vertices_);
+    std::unordered_map<uint32_t, std::vector<uint32_t>>().swap(vertex_hash_map_);
 }
 
 void Mesh::finish()
 {
     // Finish up the mesh, clear the vertex_hash_map, as it's no longer needed from this point on and uses quite a bit of memory.
-    vertex_hash_map_.clear();
+    std::unordered_map<uint32_t, std::vector<uint32_t>>().swap(vertex_hash_map_);
 
     // For each face, store which other face is connected with it.
     for (unsigned int i = 0; i < faces_.size(); i++)
@@ -11,6 +11,7 @@
 
 #include "Application.h" //To get the communication channel to send progress through.
 #include "communication/Communication.h" //To send progress through the communication channel.
+#include "utils/MemoryUsage.h"
 #include "utils/gettime.h"
 
 namespace cura
@@ -49,7 +50,11 @@ void Progress::messageProgressStage(Progress::Stage stage, TimeKeeper* time_keep
     {
         if (static_cast<int>(stage) > 0)
         {
-            spdlog::info("Progress: {} accomplished in {:03.3f}s", names.at(static_cast<size_t>(stage) - 1), time_keeper->restart());
+            spdlog::info(
+                "Progress: {} accomplished in {:03.3f}s, peak memory {:.1f} MiB",
+                names.at(static_cast<size_t>(stage) - 1),
+                time_keeper->restart(),
+                getPeakResidentMemory() / (1024.0 * 1024.0));
         }
         else
         {
@@ -824,6 +824,11 @@ bool Settings::has(const std::string& key) const
     return settings.find(key) != settings.end();
 }
 
+const std::unordered_map<std::string, std::string>& Settings::getLocalSettings() const
+{
+    return settings;
+}
+
 void Settings::setParent(Settings* new_parent)
 {
     parent = new_parent;
@@ -3,8 +3,11 @@
 
 #include "sliceDataStorage.h"
 
+#include <cassert>
+#include <limits>
 #include <numbers>
 
+#include <range/v3/view/enumerate.hpp>
 #include <spdlog/spdlog.h>
 
 #include "Application.h" //To get settings.
@@ -68,6 +71,173 @@ bool SliceLayerPart::hasWallAtInsetIndex(size_t inset_idx) const
     return false;
 }
 
+std::shared_ptr<const Shape> SliceLayerPart::getOutlineOffset(const coord_t distance, const ClipperLib::JoinType join_type) const
+{
+    const auto key = std::make_pair(distance, join_type);
+    {
+        std::lock_guard<std::mutex> lock(outline_offsets_.mutex);
+        const auto cached = outline_offsets_.offsets.find(key);
+        if (cached != outline_offsets_.offsets.end())
+        {
+            return cached->second;
+        }
+    }
+
+    // Compute the offset without holding the lock, so that other offsets of this part can be computed at the same time.
+    auto offset = std::make_shared<const Shape>(outline.offset(distance, join_type));
+    constexpr size_t max_offset_points_per_outline_point = 4;
+    const size_t offset_point_count = offset->pointCount();
+
+    std::lock_guard<std::mutex> lock(outline_offsets_.mutex);
+    const auto cached = outline_offsets_.offsets.find(key);
+    if (cached != outline_offsets_.offsets.end())
+    {
+        return cached->second; // Another thread computed it in the meanwhile.
+    }
+    if (outline_offsets_.point_count + offset_point_count <= max_offset_points_per_outline_point * outline.pointCount())
+    {
+        outline_offsets_.offsets.emplace(key, offset);
+        outline_offsets_.point_count += offset_point_count;
+    }
+    return offset;
+}
+
+void SliceLayerPart::clearOutlineOffsets()
+{
+    std::lock_guard<std::mutex> lock(outline_offsets_.mutex);
+    outline_offsets_.offsets.clear();
+    outline_offsets_.point_count = 0;
+}
+
+size_t SliceLayerPart::memoryUsage() const
+{
+    size_t bytes = cura::memoryUsage(outline) + cura::memoryUsage(print_outline) + cura::memoryUsage(spiral_wall) + cura::memoryUsage(inner_area)
+                 + cura::memoryUsage(wall_toolpaths) + cura::memoryUsage(infill_wall_toolpaths) + cura::memoryUsage(infill_area)
+                 + cura::memoryUsage(infill_area_per_combine_per_density);
+    {
+        std::lock_guard<std::mutex> lock(outline_offsets_.mutex);
+        for (const auto& [key, offset] : outline_offsets_.offsets)
+        {
+            bytes += cura::memoryUsage(*offset);
+        }
+    }
+    if (infill_area_own)
+    {
+        bytes += cura::memoryUsage(*infill_area_own);
+    }
+    bytes += skin_parts.capacity() * sizeof(SkinPart);
+    for (const SkinPart& skin_part : skin_parts)
+    {
+        bytes += cura::memoryUsage(skin_part.outline) + cura::memoryUsage(skin_part.skin_fill) + cura::memoryUsage(skin_part.roofing_fill)
+               + cura::memoryUsage(skin_part.top_most_surface_fill) + cura::memoryUsage(skin_part.bottom_most_surface_fill);
+    }
+    return bytes;
+}
+
+size_t SliceLayer::memoryUsage() const
+{
+    size_t bytes = parts.capacity() * sizeof(SliceLayerPart) + cura::memoryUsage(open_polylines) + cura::memoryUsage(top_surface.areas) + cura::memoryUsage(bottom_surface);
+    for (const SliceLayerPart& part : parts)
+    {
+        bytes += part.memoryUsage();
+    }
+    if (compact_geometry_)
+    {
+        bytes += compact_geometry_->arena.memoryUsage() + compact_geometry_->handles.capacity() * sizeof(CompactShapeArena::Handle);
+    }
+    return bytes;
+}
+
+size_t SliceLayer::outlineVertexCount() const
+{
+    size_t vertex_count = 0;
+    for (const SliceLayerPart& part : parts)
+    {
+        vertex_count += part.outline.pointCount();
+    }
+    return vertex_count;
+}
+
+void SliceLayer::releaseExportData()
+{
+    for (SliceLayerPart& part : parts)
+    {
+        // Assign new objects rather than clearing them, to actually free the memory.
+        part.spiral_wall = Shape();
+        part.inner_area = Shape();
+        part.skin_parts = std::vector<SkinPart>();
+        part.wall_toolpaths = std::vector<VariableWidthLines>();
+        part.infill_wall_toolpaths = std::vector<VariableWidthLines>();
+        part.infill_area = Shape();
+        part.infill_area_own.reset();
+        part.infill_area_per_combine_per_density = std::vector<std::vector<Shape>>();
+    }
+    open_polylines = OpenLinesSet();
+    top_surface.areas = Shape();
+    bottom_surface = Shape();
+    compact_geometry_.reset();
+}
+
+void SliceLayer::compact()
+{
+    if (compact_geometry_)
+    {
+        return;
+    }
+    CompactGeometry& compact_geometry = compact_geometry_.emplace();
+    forEachCompactShape(
+        [&compact_geometry](Shape& shape)
+        {
+            compact_geometry.handles.push_back(compact_geometry.arena.add(shape));
+            shape = Shape(); // Assign a new shape rather than clearing it, to actually free the memory.
+        });
+    compact_geometry.arena.shrinkToFit();
+    compact_geometry.handles.shrink_to_fit();
+}
+
+void SliceLayer::expand()
+{
+    if (! compact_geometry_)
+    {
+        return;
+    }
+    auto handle = compact_geometry_->handles.cbegin();
+    forEachCompactShape(
+        [this, &handle](Shape& shape)
+        {
+            shape = compact_geometry_->arena.get(*handle);
+            ++handle;
+        });
+    assert(handle == compact_geometry_->handles.cend());
+    compact_geometry_.reset();
+}
+
+bool SliceLayer::isCompact() const
+{
+    return compact_geometry_.has_value();
+}
+
+void SliceLayer::forEachCompactShape(const std::function<void(Shape&)>& function)
+{
+    for (SliceLayerPart& part : parts)
+    {
+        function(part.inner_area);
+        for (std::vector<Shape>& infill_area_per_combine : part.infill_area_per_combine_per_density)
+        {
+            for (Shape& infill_area : infill_area_per_combine)
+            {
+                function(infill_area);
+            }
+        }
+        for (SkinPart& skin_part : part.skin_parts)
+        {
+            // The skin and roofing fill are not stored compactly, since they are checked to find the extruders used on a layer.
+            function(skin_part.top_most_surface_fill);
+            function(skin_part.bottom_most_surface_fill);
+        }
+    }
+}
+
 SliceLayer::~SliceLayer()
 {
 }
@@ -246,6 +416,19 @@ Point2LL SliceMeshStorage::getZSeamHint() const
     return pos;
 }
 
+void SliceMeshStorage::memoryUsage(MemoryReport& report) const
+{
+    size_t layers_bytes = layers.capacity() * sizeof(SliceLayer);
+    for (const auto& [layer_idx, layer] : layers | ranges::views::enumerate)
+    {
+        const size_t layer_bytes = layer.memoryUsage();
+        layers_bytes += layer_bytes;
+        report.addToLayer(layer_idx, layer_bytes);
+    }
+    report.add(fmt::format("mesh '{}' layers", mesh_name), layers_bytes);
+    report.add(fmt::format("mesh '{}' overhang areas", mesh_name), cura::memoryUsage(overhang_areas) + cura::memoryUsage(full_overhang_areas) + cura::memoryUsage(overhang_points));
+}
+
 std::vector<RetractionAndWipeConfig> SliceDataStorage::initializeRetractionAndWipeConfigs()
 {
     std::vector<RetractionAndWipeConfig> ret;
@@ -343,20 +526,7 @@ Shape SliceDataStorage::getLayerOutlines(
         Shape total;
         if (include_models && layer_nr >= 0)
         {
-            for (const std::shared_ptr<SliceMeshStorage>& mesh : meshes)
-            {
-                if (mesh->settings.get<bool>("infill_mesh") || mesh->settings.get<bool>("anti_overhang_mesh")
-                    || (extruder_nr != -1 && extruder_nr != int(mesh->settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_)))
-                {
-                    continue;
-                }
-                const SliceLayer& layer = mesh->layers[layer_nr];
-                layer.getOutlines(total, external_polys_only);
-                if (mesh->settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL)
-                {
-                    total = total.unionPolygons(layer.open_polylines.offset(MM2INT(0.1)));
-                }
-            }
+            total = *getModelOutlines(layer_nr, external_polys_only, extruder_nr);
         }
         if (include_support && (extruder_nr == -1 || extruder_nr == int(mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr").extruder_nr_)))
         {
@@ -383,6 +553,56 @@ Shape SliceDataStorage::getLayerOutlines(
     }
 }
 
+std::shared_ptr<const Shape> SliceDataStorage::getModelOutlines(const LayerIndex layer_nr, const bool external_polys_only, const int extruder_nr) const
+{
+    assert(layer_nr >= 0);
+    const auto key = std::make_tuple(layer_nr, external_polys_only, extruder_nr);
+    {
+        std::lock_guard<std::mutex> lock(model_outlines_mutex_);
+        const auto cached = model_outlines_.find(key);
+        if (cached != model_outlines_.end())
+        {
+            return cached->second;
+        }
+    }
+
+    // Compute the outlines without holding the lock, so that other layers can be computed at the same time.
+    auto total = std::make_shared<Shape>();
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : meshes)
+    {
+        if (mesh->settings.get<bool>("infill_mesh") || mesh->settings.get<bool>("anti_overhang_mesh")
+            || (extruder_nr != -1 && extruder_nr != int(mesh->settings.get<ExtruderTrain&>("wall_0_extruder_nr").extruder_nr_)))
+        {
+            continue;
+        }
+        const SliceLayer& layer = mesh->layers[layer_nr];
+        layer.getOutlines(*total, external_polys_only);
+        if (mesh->settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL)
+        {
+            *total = total->unionPolygons(layer.open_polylines.offset(MM2INT(0.1)));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(model_outlines_mutex_);
+    return model_outlines_.try_emplace(key, std::move(total)).first->second; // If another thread was first, use its (equal) outlines.
+}
+
+void SliceDataStorage::invalidateLayerOutlines()
+{
+    std::lock_guard<std::mutex> lock(model_outlines_mutex_);
+    model_outlines_.clear();
+}
+
+void SliceDataStorage::releaseLayerOutlines(const LayerIndex layer_nr)
+{
+    std::lock_guard<std::mutex> lock(model_outlines_mutex_);
+    auto outlines = model_outlines_.lower_bound(std::make_tuple(layer_nr, false, std::numeric_limits<int>::min()));
+    while (outlines != model_outlines_.end() && std::get<0>(outlines->first) == layer_nr)
+    {
+        outlines = model_outlines_.erase(outlines);
+    }
+}
+
 AABB3D SliceDataStorage::getModelBoundingBox() const
 {
     AABB3D bounding_box;
@@ -393,6 +613,44 @@ AABB3D SliceDataStorage::getModelBoundingBox() const
     return bounding_box;
 }
 
+MemoryReport SliceDataStorage::memoryUsage() const
+{
+    MemoryReport report;
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : meshes)
+    {
+        mesh->memoryUsage(report);
+    }
+
+    size_t support_bytes = support.supportLayers.capacity() * sizeof(SupportLayer);
+    for (const auto& [layer_idx, support_layer] : support.supportLayers | ranges::views::enumerate)
+    {
+        const size_t layer_bytes = support_layer.memoryUsage();
+        support_bytes += layer_bytes;
+        report.addToLayer(layer_idx, layer_bytes);
+    }
+    report.add("support layers", support_bytes);
+
+    size_t skirt_brim_bytes = cura::memoryUsage(support_brim);
+    for (const std::vector<MixedLinesSet>& skirt_brim_of_extruder : skirt_brim)
+    {
+        skirt_brim_bytes += cura::memoryUsage(skirt_brim_of_extruder);
+    }
+    report.add("skirt and brim", skirt_brim_bytes);
+    report.add("raft outlines", cura::memoryUsage(raft_base_outline) + cura::memoryUsage(raft_interface_outline) + cura::memoryUsage(raft_surface_outline));
+    report.add("shields", cura::memoryUsage(ooze_shield) + cura::memoryUsage(draft_protection_shield));
+
+    size_t model_outlines_bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(model_outlines_mutex_);
+        for (const auto& [key, outlines] : model_outlines_)
+        {
+            model_outlines_bytes += sizeof(Shape) + cura::memoryUsage(*outlines);
+        }
+    }
+    report.add("model outlines", model_outlines_bytes);
+    return report;
+}
+
 std::vector<bool> SliceDataStorage::getExtrudersUsed() const
 {
     std::vector<bool> ret;
@@ -812,4 +1070,15 @@ void SupportLayer::fillInfillParts(
     }
 }
 
+size_t SupportLayer::memoryUsage() const
+{
+    size_t bytes = support_infill_parts.capacity() * sizeof(SupportInfillPart) + cura::memoryUsage(support_bottom) + cura::memoryUsage(support_roof)
+                 + cura::memoryUsage(support_fractional_roof) + cura::memoryUsage(support_mesh_drop_down) + cura::memoryUsage(support_mesh) + cura::memoryUsage(anti_overhang);
+    for (const SupportInfillPart& part : support_infill_parts)
+    {
+        bytes += cura::memoryUsage(part.outline_) + cura::memoryUsage(part.infill_area_per_combine_per_density_) + cura::memoryUsage(part.wall_toolpaths_);
+    }
+    return bytes;
+}
+
 } // namespace cura
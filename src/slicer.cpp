@@ -5,6 +5,7 @@
 
 #include <algorithm> // remove_if
 #include <cstdio>
+#include <limits>
 #include <numbers>
 
 #include <scripta/logger.h>
@@ -43,6 +44,7 @@ void SlicerLayer::makeBasicPolygonLoops(OpenLinesSet& open_polylines)
     }
     // Clear the segmentList to save memory, it is no longer needed after this point.
     segments_.clear();
+    segment_face_indices_.clear();
 }
 
 void SlicerLayer::makeBasicPolygonLoop(OpenLinesSet& open_polylines, const size_t start_segment_idx)
@@ -68,12 +70,11 @@ void SlicerLayer::makeBasicPolygonLoop(OpenLinesSet& open_polylines, const size_
 
 int SlicerLayer::tryFaceNextSegmentIdx(const SlicerSegment& segment, const int face_idx, const size_t start_segment_idx) const
 {
-    decltype(face_idx_to_segment_idx_.begin()) it;
-    auto it_end = face_idx_to_segment_idx_.end();
-    it = face_idx_to_segment_idx_.find(face_idx);
-    if (it != it_end)
+    // Each face generates at most one segment per layer, so a binary search finds it.
+    const auto it = std::lower_bound(segment_face_indices_.begin(), segment_face_indices_.end(), face_idx);
+    if (it != segment_face_indices_.end() && *it == face_idx)
     {
-        const int segment_idx = (*it).second;
+        const int segment_idx = static_cast<int>(std::distance(segment_face_indices_.begin(), it));
         Point2LL p1 = segments_[segment_idx].start;
         Point2LL diff = segment.end - p1;
         if (shorterThen(diff, largest_neglected_gap_first_phase))
@@ -822,25 +823,34 @@ Slicer::Slicer(Mesh* i_mesh, const coord_t thickness, const size_t slice_layer_c
         Raft::getFillerLayerCount());
 
     std::vector<std::pair<int32_t, int32_t>> zbbox = buildZHeightsForFaces(*mesh);
+    sliced_layer_range = getLayerRange(zbbox, layers);
+    spdlog::debug("Slicing layers {} to {} of {}", sliced_layer_range.first, sliced_layer_range.second, layers.size());
 
-    buildSegments(*mesh, zbbox, slicing_tolerance, layers);
+    buildSegments(*mesh, zbbox, slicing_tolerance, sliced_layer_range, layers);
 
     spdlog::info("Slice of mesh took {:03.3f} seconds", slice_timer.restart());
 
-    makePolygons(*i_mesh, slicing_tolerance, layers);
+    makePolygons(*i_mesh, slicing_tolerance, sliced_layer_range, layers);
     scripta::log("sliced_polygons", layers, SectionType::NA);
     spdlog::info("Make polygons took {:03.3f} seconds", slice_timer.restart());
 }
 
-void Slicer::buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbbox, const SlicingTolerance& slicing_tolerance, std::vector<SlicerLayer>& layers)
+void Slicer::buildSegments(
+    const Mesh& mesh,
+    const std::vector<std::pair<int32_t, int32_t>>& zbbox,
+    const SlicingTolerance& slicing_tolerance,
+    const std::pair<size_t, size_t>& layer_range,
+    std::vector<SlicerLayer>& layers)
 {
     cura::parallel_for(
-        layers,
+        layers.begin() + layer_range.first,
+        layers.begin() + layer_range.second,
         [&](auto layer_it)
         {
             SlicerLayer& layer = *layer_it;
             const int32_t& z = layer.z_;
             layer.segments_.reserve(100);
+            layer.segment_face_indices_.reserve(100);
 
             // loop over all mesh faces
             for (unsigned int mesh_idx = 0; mesh_idx < mesh.faces_.size(); mesh_idx++)
@@ -955,7 +965,7 @@ void Slicer::buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t
                 }
 
                 // store the segments per layer
-                layer.face_idx_to_segment_idx_.insert(std::make_pair(mesh_idx, layer.segments_.size()));
+                layer.segment_face_indices_.push_back(mesh_idx);
                 s.faceIndex = mesh_idx;
                 s.endOtherFaceIdx = face.connected_face_index_[end_edge_idx];
                 s.addedToPolygon = false;
@@ -1005,10 +1015,12 @@ std::vector<SlicerLayer> Slicer::buildLayersWithHeight(
     return layers_res;
 }
 
-void Slicer::makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, std::vector<SlicerLayer>& layers)
+void Slicer::makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, const std::pair<size_t, size_t>& layer_range, std::vector<SlicerLayer>& layers)
 {
+    const auto [first_layer, end_layer] = layer_range;
     cura::parallel_for(
-        layers,
+        layers.begin() + first_layer,
+        layers.begin() + end_layer,
         [&mesh](auto layer_it)
         {
             layer_it->makePolygons(&mesh);
@@ -1017,17 +1029,30 @@ void Slicer::makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, std::v
     switch (slicing_tolerance)
     {
     case SlicingTolerance::INCLUSIVE:
-        for (LayerIndex layer_nr = 0; layer_nr + 1 < layers.size(); layer_nr++)
+    case SlicingTolerance::EXCLUSIVE:
+        // The layers around the range are empty, so the combination of any two layers outside of the range is empty too.
+        if (end_layer > first_layer + 1)
         {
-            layers[layer_nr].polygons_ = layers[layer_nr].polygons_.unionPolygons(layers[layer_nr + 1].polygons_);
+            // Each layer is combined with the original outlines of the layer above it, so compute all results before replacing any of them.
+            std::vector<Shape> combined(end_layer - first_layer - 1);
+            cura::parallel_for<size_t>(
+                0,
+                combined.size(),
+                [&layers, &combined, first_layer, slicing_tolerance](const size_t combined_idx)
+                {
+                    const Shape& current = layers[first_layer + combined_idx].polygons_;
+                    const Shape& above = layers[first_layer + combined_idx + 1].polygons_;
+                    combined[combined_idx] = slicing_tolerance == SlicingTolerance::INCLUSIVE ? current.unionPolygons(above) : current.intersection(above);
+                });
+            for (size_t combined_idx = 0; combined_idx < combined.size(); combined_idx++)
+            {
+                layers[first_layer + combined_idx].polygons_ = std::move(combined[combined_idx]);
+            }
         }
-        break;
-    case SlicingTolerance::EXCLUSIVE:
-        for (LayerIndex layer_nr = 0; layer_nr + 1 < layers.size(); layer_nr++)
+        if (slicing_tolerance == SlicingTolerance::EXCLUSIVE && ! layers.empty())
         {
-            layers[layer_nr].polygons_ = layers[layer_nr].polygons_.intersection(layers[layer_nr + 1].polygons_);
+            layers.back().polygons_.clear();
         }
-        layers.back().polygons_.clear();
         break;
     case SlicingTolerance::MIDDLE:
     default:
@@ -1051,8 +1076,8 @@ void Slicer::makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, std::v
     const auto max_hole_area = std::numbers::pi / 4 * static_cast<double>(hole_offset_max_diameter * hole_offset_max_diameter);
 
     cura::parallel_for<size_t>(
-        0,
-        layers.size(),
+        first_layer,
+        end_layer,
         [&layers, layer_apply_initial_xy_offset, xy_offset, xy_offset_0, xy_offset_hole, hole_offset_max_diameter, max_hole_area](size_t layer_nr)
         {
             const auto xy_offset_local = (layer_nr <= layer_apply_initial_xy_offset) ? xy_offset_0 : xy_offset;
@@ -1148,6 +1173,40 @@ std::vector<std::pair<int32_t, int32_t>> Slicer::buildZHeightsForFaces(const Mes
     return zHeights;
 }
 
+std::pair<size_t, size_t> Slicer::getLayerRange(const std::vector<std::pair<int32_t, int32_t>>& zbboxes, const std::vector<SlicerLayer>& layers)
+{
+    if (zbboxes.empty())
+    {
+        return { 0, 0 };
+    }
+    int32_t min_z = std::numeric_limits<int32_t>::max();
+    int32_t max_z = std::numeric_limits<int32_t>::min();
+    for (const auto& [face_min_z, face_max_z] : zbboxes)
+    {
+        min_z = std::min(min_z, face_min_z);
+        max_z = std::max(max_z, face_max_z);
+    }
+
+    // The layer heights are increasing, also with adaptive layers.
+    const auto first = std::partition_point(
+        layers.begin(),
+        layers.end(),
+        [min_z](const SlicerLayer& layer)
+        {
+            return layer.z_ < min_z;
+        });
+    const auto end = std::partition_point(
+        first,
+        layers.end(),
+        [max_z](const SlicerLayer& layer)
+        {
+            return layer.z_ <= max_z;
+        });
+    const size_t first_layer = std::max<ptrdiff_t>(first - layers.begin() - 1, 0);
+    const size_t end_layer = std::min<size_t>(end - layers.begin() + 1, layers.size());
+    return { first_layer, end_layer };
+}
+
 SlicerSegment Slicer::project2D(const Point3LL& p0, const Point3LL& p1, const Point3LL& p2, const coord_t z)
 {
     SlicerSegment seg;
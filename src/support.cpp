@@ -461,7 +461,89 @@ void AreaSupport::cleanup(SliceDataStorage& storage)
     }
 }
 
-Shape AreaSupport::join(const SliceDataStorage& storage, const Shape& supportLayer_up, Shape& supportLayer_this)
+Shape AreaSupport::getMachineVolumeBorder(const SliceDataStorage& storage)
+{
+    const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
+    // Don't go outside the build volume.
+    Shape machine_volume_border;
+    switch (mesh_group_settings.get<BuildPlateShape>("machine_shape"))
+    {
+    case BuildPlateShape::ELLIPTIC:
+    {
+        // Construct an ellipse to approximate the build volume.
+        const coord_t width = storage.machine_size.max_.x_ - storage.machine_size.min_.x_;
+        const coord_t depth = storage.machine_size.max_.y_ - storage.machine_size.min_.y_;
+        Polygon border_circle;
+        constexpr unsigned int circle_resolution = 50;
+        for (unsigned int i = 0; i < circle_resolution; i++)
+        {
+            const AngleRadians angle = TAU * i / circle_resolution;
+            const Point3LL machine_middle = storage.machine_size.getMiddle();
+            const coord_t x = machine_middle.x_ + cos(angle) * width / 2;
+            const coord_t y = machine_middle.y_ + sin(angle) * depth / 2;
+            border_circle.emplace_back(x, y);
+        }
+        machine_volume_border.push_back(border_circle);
+        break;
+    }
+    case BuildPlateShape::RECTANGULAR:
+    default:
+        machine_volume_border.push_back(storage.machine_size.flatten().toPolygon());
+        break;
+    }
+    coord_t adhesion_size = 0; // Make sure there is enough room for the platform adhesion around support.
+    coord_t extra_skirt_line_width = 0;
+    const std::vector<bool> is_extruder_used = storage.getExtrudersUsed();
+    for (size_t extruder_nr = 0; extruder_nr < Application::getInstance().current_slice_->scene.extruders.size(); extruder_nr++)
+    {
+        if (! is_extruder_used[extruder_nr]) // Unused extruders and the primary adhesion extruder don't generate an extra skirt line.
+        {
+            continue;
+        }
+        const ExtruderTrain& other_extruder = Application::getInstance().current_slice_->scene.extruders[extruder_nr];
+        extra_skirt_line_width += other_extruder.settings_.get<coord_t>("skirt_brim_line_width") * other_extruder.settings_.get<Ratio>("initial_layer_line_width_factor");
+    }
+    const std::vector<ExtruderTrain*> skirt_brim_extruders = mesh_group_settings.get<std::vector<ExtruderTrain*>>("skirt_brim_extruder_nr");
+    auto adhesion_width_str{ "brim_width" };
+    auto adhesion_line_count_str{ "brim_line_count" };
+    switch (mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"))
+    {
+    case EPlatformAdhesion::SKIRT:
+        adhesion_width_str = "skirt_gap";
+        adhesion_line_count_str = "skirt_line_count";
+        [[fallthrough]];
+    case EPlatformAdhesion::BRIM:
+        for (ExtruderTrain* skirt_brim_extruder_p : skirt_brim_extruders)
+        {
+            ExtruderTrain& skirt_brim_extruder = *skirt_brim_extruder_p;
+            adhesion_size = std::max(
+                adhesion_size,
+                coord_t(
+                    skirt_brim_extruder.settings_.get<coord_t>(adhesion_width_str)
+                    + skirt_brim_extruder.settings_.get<coord_t>("skirt_brim_line_width")
+                          * (skirt_brim_extruder.settings_.get<size_t>(adhesion_line_count_str) - 1) // - 1 because the line is also included in extra_skirt_line_width
+                          * skirt_brim_extruder.settings_.get<Ratio>("initial_layer_line_width_factor")
+                    + extra_skirt_line_width));
+        }
+        break;
+    case EPlatformAdhesion::RAFT:
+    {
+        adhesion_size = std::max({ mesh_group_settings.get<ExtruderTrain&>("raft_base_extruder_nr").settings_.get<coord_t>("raft_base_margin"),
+                                   mesh_group_settings.get<ExtruderTrain&>("raft_interface_extruder_nr").settings_.get<coord_t>("raft_interface_margin"),
+                                   mesh_group_settings.get<ExtruderTrain&>("raft_surface_extruder_nr").settings_.get<coord_t>("raft_surface_margin") });
+        break;
+    }
+    case EPlatformAdhesion::NONE:
+        adhesion_size = 0;
+        break;
+    default: // Also use 0.
+        spdlog::info("Unknown platform adhesion type! Please implement the width of the platform adhesion here.");
+        break;
+    }
+    return machine_volume_border.offset(-adhesion_size);
+}
+
+Shape AreaSupport::join(const Shape& supportLayer_up, Shape& supportLayer_this, const Shape& machine_volume_border)
 {
     Shape joined;
 
@@ -480,85 +562,6 @@ Shape AreaSupport::join(const SliceDataStorage& storage, const Shape& supportLay
     const bool conical_support = infill_settings.get<bool>("support_conical_enabled") && conical_support_angle != 0;
     if (conical_support)
     {
-        const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
-        // Don't go outside the build volume.
-        Shape machine_volume_border;
-        switch (mesh_group_settings.get<BuildPlateShape>("machine_shape"))
-        {
-        case BuildPlateShape::ELLIPTIC:
-        {
-            // Construct an ellipse to approximate the build volume.
-            const coord_t width = storage.machine_size.max_.x_ - storage.machine_size.min_.x_;
-            const coord_t depth = storage.machine_size.max_.y_ - storage.machine_size.min_.y_;
-            Polygon border_circle;
-            constexpr unsigned int circle_resolution = 50;
-            for (unsigned int i = 0; i < circle_resolution; i++)
-            {
-                const AngleRadians angle = TAU * i / circle_resolution;
-                const Point3LL machine_middle = storage.machine_size.getMiddle();
-                const coord_t x = machine_middle.x_ + cos(angle) * width / 2;
-                const coord_t y = machine_middle.y_ + sin(angle) * depth / 2;
-                border_circle.emplace_back(x, y);
-            }
-            machine_volume_border.push_back(border_circle);
-            break;
-        }
-        case BuildPlateShape::RECTANGULAR:
-        default:
-            machine_volume_border.push_back(storage.machine_size.flatten().toPolygon());
-            break;
-        }
-        coord_t adhesion_size = 0; // Make sure there is enough room for the platform adhesion around support.
-        coord_t extra_skirt_line_width = 0;
-        const std::vector<bool> is_extruder_used = storage.getExtrudersUsed();
-        for (size_t extruder_nr = 0; extruder_nr < Application::getInstance().current_slice_->scene.extruders.size(); extruder_nr++)
-        {
-            if (! is_extruder_used[extruder_nr]) // Unused extruders and the primary adhesion extruder don't generate an extra skirt line.
-            {
-                continue;
-            }
-            const ExtruderTrain& other_extruder = Application::getInstance().current_slice_->scene.extruders[extruder_nr];
-            extra_skirt_line_width += other_extruder.settings_.get<coord_t>("skirt_brim_line_width") * other_extruder.settings_.get<Ratio>("initial_layer_line_width_factor");
-        }
-        const std::vector<ExtruderTrain*> skirt_brim_extruders = mesh_group_settings.get<std::vector<ExtruderTrain*>>("skirt_brim_extruder_nr");
-        auto adhesion_width_str{ "brim_width" };
-        auto adhesion_line_count_str{ "brim_line_count" };
-        switch (mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"))
-        {
-        case EPlatformAdhesion::SKIRT:
-            adhesion_width_str = "skirt_gap";
-            adhesion_line_count_str = "skirt_line_count";
-            [[fallthrough]];
-        case EPlatformAdhesion::BRIM:
-            for (ExtruderTrain* skirt_brim_extruder_p : skirt_brim_extruders)
-            {
-                ExtruderTrain& skirt_brim_extruder = *skirt_brim_extruder_p;
-                adhesion_size = std::max(
-                    adhesion_size,
-                    coord_t(
-                        skirt_brim_extruder.settings_.get<coord_t>(adhesion_width_str)
-                        + skirt_brim_extruder.settings_.get<coord_t>("skirt_brim_line_width")
-                              * (skirt_brim_extruder.settings_.get<size_t>(adhesion_line_count_str) - 1) // - 1 because the line is also included in extra_skirt_line_width
-                              * skirt_brim_extruder.settings_.get<Ratio>("initial_layer_line_width_factor")
-                        + extra_skirt_line_width));
-            }
-            break;
-        case EPlatformAdhesion::RAFT:
-        {
-            adhesion_size = std::max({ mesh_group_settings.get<ExtruderTrain&>("raft_base_extruder_nr").settings_.get<coord_t>("raft_base_margin"),
-                                       mesh_group_settings.get<ExtruderTrain&>("raft_interface_extruder_nr").settings_.get<coord_t>("raft_interface_margin"),
-                                       mesh_group_settings.get<ExtruderTrain&>("raft_surface_extruder_nr").settings_.get<coord_t>("raft_surface_margin") });
-            break;
-        }
-        case EPlatformAdhesion::NONE:
-            adhesion_size = 0;
-            break;
-        default: // Also use 0.
-            spdlog::info("Unknown platform adhesion type! Please implement the width of the platform adhesion here.");
-            break;
-        }
-        machine_volume_border = machine_volume_border.offset(-adhesion_size);
-
         const coord_t conical_smallest_breadth = infill_settings.get<coord_t>("support_conical_min_width");
         Shape insetted = supportLayer_up.offset(-conical_smallest_breadth / 2);
         Shape small_parts = supportLayer_up.difference(insetted.offset(conical_smallest_breadth / 2 + 20));
@@ -801,7 +804,8 @@ void AreaSupport::generateOverhangAreasForMesh(SliceDataStorage& storage, SliceM
     }
 
     // Generate the actual areas and store them in the mesh.
-    cura::parallel_for<size_t>(
+    cura::parallel_for_adaptive<size_t>(
+        "Support overhang",
         1,
         storage.print_layer_count,
         [&](const size_t layer_idx)
@@ -811,6 +815,10 @@ void AreaSupport::generateOverhangAreasForMesh(SliceDataStorage& storage, SliceM
             mesh.full_overhang_areas[layer_idx] = basic_and_full_overhang.second;
             scripta::log("support_basic_overhang_area", basic_and_full_overhang.first, SectionType::SUPPORT, layer_idx);
             scripta::log("support_full_overhang_area", basic_and_full_overhang.second, SectionType::SUPPORT, layer_idx);
+        },
+        [&mesh](const size_t layer_idx)
+        {
+            return mesh.layers[layer_idx].outlineVertexCount() + mesh.layers[layer_idx - 1].outlineVertexCount();
         });
 }
 
@@ -1031,25 +1039,26 @@ void AreaSupport::generateSupportAreasForMesh(
     const coord_t sloped_area_detection_width = 10 + static_cast<coord_t>(layer_thickness / std::tan(sloped_areas_angle)) / 2;
     const double minimum_support_area = mesh.settings.get<double>("minimum_support_area");
     const coord_t min_even_wall_line_width = mesh.settings.get<coord_t>("min_even_wall_line_width");
-    xy_disallowed_per_layer[0] = storage.getLayerOutlines(0, no_support, no_prime_tower).offset(xy_distance);
+    xy_disallowed_per_layer[0] = storage.getModelOutlines(0)->offset(xy_distance);
 
     // The maximum width of an odd wall = 2 * minimum even wall width.
     auto half_min_feature_width = min_even_wall_line_width + 10;
 
-    cura::parallel_for<size_t>(
+    cura::parallel_for_adaptive<size_t>(
+        "Support areas",
         1,
         layer_count,
         [&](const size_t layer_idx)
         {
-            const Shape outlines = storage.getLayerOutlines(layer_idx, no_support, no_prime_tower);
+            const Shape& outlines = *storage.getModelOutlines(layer_idx); // Kept alive by the storage.
 
             // Build sloped areas. We need this for the stair-stepping later on.
             // Specifically, sloped areass are used in 'moveUpFromModel' to prevent a stair step happening over an area where there isn't a slope.
             // This part here only concerns the slope between two layers. This will be post-processed later on (see the other parallel loop below).
             sloped_areas_per_layer[layer_idx] =
                 // Take the outer areas of the previous layer, where the outer areas are (mostly) just _inside_ the shape.
-                storage.getLayerOutlines(layer_idx - 1, no_support, no_prime_tower)
-                    .createTubeShape(sloped_area_detection_width, 10)
+                storage.getModelOutlines(layer_idx - 1)
+                    ->createTubeShape(sloped_area_detection_width, 10)
                     // Intersect those with the outer areas of the current layer, where the outer areas are (mostly) _outside_ the shape.
                     // This will detect every slope (and some/most vertical walls) between those two layers.
                     .intersection(outlines.createTubeShape(10, sloped_area_detection_width))
@@ -1126,36 +1135,64 @@ void AreaSupport::generateSupportAreasForMesh(
             bottom_stair_step_layer_count);
     }
 
-    for (size_t layer_idx = layer_count - 1 - layer_z_distance_top; layer_idx != static_cast<size_t>(-1); layer_idx--)
-    {
-        Shape layer_this = mesh.full_overhang_areas[layer_idx + layer_z_distance_top];
-
-        if (extension_offset && ! is_support_mesh_place_holder)
+    // First the work that doesn't depend on the support of the layers above, concurrently: the horizontal expansion and the struts.
+    // The loop from the top down below then only has to do what does depend on it: joining with the layer above, the towers and the stair steps.
+    const size_t top_support_layer_idx = layer_count - 1 - layer_z_distance_top;
+    std::vector<Shape> overhangs_per_layer(top_support_layer_idx + 1);
+    cura::parallel_for_adaptive<size_t>(
+        "Support overhangs",
+        0,
+        top_support_layer_idx + 1,
+        [&](const size_t layer_idx)
         {
-            // To avoid that the support is folding around the model, the support horizontal expansion should not cause
-            // the support to grow towards the model. Stepwise applying the support horizontal expansion to both the
-            // model outline and the support is effectively calculating a voronoi. The offset is first applied to
-            // the support and next to the model to ensure that the expanded support area is connected to the original
-            // support area. Please note that the horizontal expansion is rounded down to an integer offset_per_step.
-            Shape model_outline = storage.getLayerOutlines(layer_idx, no_support, no_prime_tower);
-            const coord_t offset_per_step = support_line_width / 2;
-
-            // perform a small offset we don't enlarge small features of the support
-            Shape horizontal_expansion = layer_this;
-            for (coord_t offset_cumulative = 0; offset_cumulative <= extension_offset; offset_cumulative += offset_per_step)
+            Shape& layer_this = overhangs_per_layer[layer_idx];
+            layer_this = mesh.full_overhang_areas[layer_idx + layer_z_distance_top];
+
+            if (extension_offset && ! is_support_mesh_place_holder)
             {
-                horizontal_expansion = horizontal_expansion.offset(offset_per_step);
-                model_outline = model_outline.difference(horizontal_expansion);
-                model_outline = model_outline.offset(offset_per_step);
-                horizontal_expansion = horizontal_expansion.difference(model_outline);
+                // To avoid that the support is folding around the model, the support horizontal expansion should not cause
+                // the support to grow towards the model. Stepwise applying the support horizontal expansion to both the
+                // model outline and the support is effectively calculating a voronoi. The offset is first applied to
+                // the support and next to the model to ensure that the expanded support area is connected to the original
+                // support area. Please note that the horizontal expansion is rounded down to an integer offset_per_step.
+                Shape model_outline = storage.getLayerOutlines(layer_idx, no_support, no_prime_tower);
+                const coord_t offset_per_step = support_line_width / 2;
+
+                // perform a small offset we don't enlarge small features of the support
+                Shape horizontal_expansion = layer_this;
+                for (coord_t offset_cumulative = 0; offset_cumulative <= extension_offset; offset_cumulative += offset_per_step)
+                {
+                    horizontal_expansion = horizontal_expansion.offset(offset_per_step);
+                    model_outline = model_outline.difference(horizontal_expansion);
+                    model_outline = model_outline.offset(offset_per_step);
+                    horizontal_expansion = horizontal_expansion.difference(model_outline);
+                }
+                layer_this = layer_this.unionPolygons(horizontal_expansion);
             }
-            layer_this = layer_this.unionPolygons(horizontal_expansion);
-        }
+
+            if (use_towers && ! is_support_mesh_place_holder)
+            {
+                // handle straight walls
+                AreaSupport::handleWallStruts(infill_settings, layer_this);
+            }
+
+            if (is_support_mesh_nondrop_place_holder)
+            {
+                layer_this = layer_this.unionPolygons(storage.support.supportLayers[layer_idx].support_mesh);
+            }
+        },
+        [&mesh, layer_z_distance_top](const size_t layer_idx)
+        {
+            return mesh.full_overhang_areas[layer_idx + layer_z_distance_top].pointCount();
+        });
+
+    const Shape machine_volume_border = AreaSupport::getMachineVolumeBorder(storage);
+    for (size_t layer_idx = top_support_layer_idx; layer_idx != static_cast<size_t>(-1); layer_idx--)
+    {
+        Shape layer_this = std::move(overhangs_per_layer[layer_idx]);
 
         if (use_towers && ! is_support_mesh_place_holder)
         {
-            // handle straight walls
-            AreaSupport::handleWallStruts(infill_settings, layer_this);
             // handle towers
             AreaSupport::handleTowers(infill_settings, xy_disallowed_per_layer[layer_idx], layer_this, tower_roofs, mesh.overhang_points, layer_idx, layer_count);
         }
@@ -1163,14 +1200,9 @@ void AreaSupport::generateSupportAreasForMesh(
         if (layer_idx + 1 < layer_count)
         { // join with support from layer up
             const Shape empty;
-            const Shape* layer_above = (layer_idx < support_areas.size()) ? &support_areas[layer_idx + 1] : &empty;
-            const Shape model_mesh_on_layer = (layer_idx > 0) && ! is_support_mesh_nondrop_place_holder ? storage.getLayerOutlines(layer_idx, no_support, no_prime_tower) : empty;
-            if (is_support_mesh_nondrop_place_holder)
-            {
-                layer_above = &empty;
-                layer_this = layer_this.unionPolygons(storage.support.supportLayers[layer_idx].support_mesh);
-            }
-            layer_this = AreaSupport::join(storage, *layer_above, layer_this).difference(model_mesh_on_layer);
+            const Shape& layer_above = (layer_idx < support_areas.size() && ! is_support_mesh_nondrop_place_holder) ? support_areas[layer_idx + 1] : empty;
+            const Shape& model_mesh_on_layer = (layer_idx > 0) && ! is_support_mesh_nondrop_place_holder ? *storage.getModelOutlines(layer_idx) : empty;
+            layer_this = AreaSupport::join(layer_above, layer_this, machine_volume_border).difference(model_mesh_on_layer);
         }
 
         // make towers for small support
@@ -1289,19 +1321,22 @@ void AreaSupport::generateSupportAreasForMesh(
         const int max_checking_layer_idx
             = std::max(0, std::min(static_cast<int>(storage.support.supportLayers.size()), static_cast<int>(layer_count - (layer_z_distance_top - 1))));
 
-        cura::parallel_for<size_t>(
+        cura::parallel_for_adaptive<size_t>(
+            "Support model distance",
             0,
             max_checking_layer_idx,
             [&](const size_t layer_idx)
             {
-                constexpr bool no_support_here = false;
-                constexpr bool no_prime_tower_here = false;
-                support_areas[layer_idx]
-                    = support_areas[layer_idx].difference(storage.getLayerOutlines(layer_idx + layer_z_distance_top - 1, no_support_here, no_prime_tower_here));
+                support_areas[layer_idx] = support_areas[layer_idx].difference(*storage.getModelOutlines(layer_idx + layer_z_distance_top - 1));
+            },
+            [&support_areas](const size_t layer_idx)
+            {
+                return support_areas[layer_idx].pointCount();
             });
     }
 
     // Procedure to remove floating support
+    // This has to go from bottom to top, since each layer is compared to the layer below as it was already filtered.
     for (size_t layer_idx = 1; layer_idx < layer_count - 1; layer_idx++)
     {
         Shape& layer_this = support_areas[layer_idx];
@@ -1394,16 +1429,16 @@ void AreaSupport::moveUpFromModel(
     const size_t bottom_layer_nr = layer_idx - bottom_empty_layer_count;
     constexpr bool no_support = false;
     constexpr bool no_prime_tower = false;
-    const Shape bottom_outline = storage.getLayerOutlines(bottom_layer_nr, no_support, no_prime_tower);
+    const std::shared_ptr<const Shape> bottom_outline = storage.getModelOutlines(bottom_layer_nr);
 
     Shape to_be_removed;
     if (bottom_stair_step_layer_count <= 1)
     {
-        to_be_removed = bottom_outline;
+        to_be_removed = *bottom_outline;
     }
     else
     {
-        to_be_removed = stair_removal.unionPolygons(bottom_outline);
+        to_be_removed = stair_removal.unionPolygons(*bottom_outline);
         if (layer_idx % bottom_stair_step_layer_count == 0)
         { // update stairs for next step
             const Shape supporting_bottom = storage.getLayerOutlines(bottom_layer_nr - 1, no_support, no_prime_tower);
@@ -1412,8 +1447,7 @@ void AreaSupport::moveUpFromModel(
             const int64_t step_bottom_layer_nr = bottom_layer_nr - bottom_stair_step_layer_count + 1;
             if (step_bottom_layer_nr >= 0)
             {
-                const Shape step_bottom_outline = storage.getLayerOutlines(step_bottom_layer_nr, no_support, no_prime_tower);
-                stair_removal = step_bottom_outline.intersection(allowed_step_width);
+                stair_removal = storage.getModelOutlines(step_bottom_layer_nr)->intersection(allowed_step_width);
             }
             else
             {
@@ -1457,7 +1491,7 @@ std::pair<Shape, Shape> AreaSupport::computeBasicAndFullOverhang(const SliceData
     Shape outlines_below = storage.getLayerOutlines(layer_idx - 1, no_support, no_prime_tower).offset(max_dist_from_lower_layer);
     for (int layer_idx_offset = 2; layer_idx - layer_idx_offset >= 0 && layer_idx_offset <= layers_below; layer_idx_offset++)
     {
-        auto outlines_below_ = storage.getLayerOutlines(layer_idx - layer_idx_offset, no_support, no_prime_tower).offset(max_dist_from_lower_layer * layer_idx_offset);
+        auto outlines_below_ = storage.getModelOutlines(layer_idx - layer_idx_offset)->offset(max_dist_from_lower_layer * layer_idx_offset);
         outlines_below = outlines_below.unionPolygons(outlines_below_);
     }
 
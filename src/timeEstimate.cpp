@@ -4,11 +4,13 @@
 #include "timeEstimate.h"
 
 #include <algorithm>
+#include <cassert>
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "settings/Settings.h"
+#include "utils/ThreadPool.h"
 #include "utils/math.h"
 
 namespace cura
@@ -37,6 +39,18 @@ void TimeEstimateCalculator::setFirmwareDefaults(const Settings& settings)
 void TimeEstimateCalculator::setPosition(Position newPos)
 {
     currentPosition = newPos;
+    if (moves.size() == 0)
+    {
+        return; // The first move will start from here anyway.
+    }
+    if (! moves.position_changes.empty() && moves.position_changes.back().first == moves.size())
+    {
+        moves.position_changes.back().second = newPos;
+    }
+    else
+    {
+        moves.position_changes.emplace_back(moves.size(), newPos);
+    }
 }
 
 void TimeEstimateCalculator::addTime(const Duration& time)
@@ -57,7 +71,27 @@ void TimeEstimateCalculator::setMaxXyJerk(const Velocity& jerk)
 void TimeEstimateCalculator::reset()
 {
     extra_time = 0.0;
-    blocks.clear();
+    moves.clear();
+}
+
+TimeEstimateCalculator TimeEstimateCalculator::takeRecorded()
+{
+    MoveLog recorded = std::move(moves);
+    moves = MoveLog();
+    TimeEstimateCalculator taken = *this; // Only copies the configuration and positions, now that the moves are moved out.
+    taken.moves = std::move(recorded);
+    reset();
+    return taken;
+}
+
+void TimeEstimateCalculator::MoveLog::clear()
+{
+    destinations.clear();
+    feedrates.clear();
+    features.clear();
+    accelerations.clear();
+    max_xy_jerks.clear();
+    position_changes.clear();
 }
 
 // Calculates the maximum allowable speed at this point when you must be able to reach target_velocity using the
@@ -129,7 +163,7 @@ static inline double accelerationTimeFromDistance(const Velocity& initial_feedra
     return (-initial_feedrate + sqrt(discriminant)) / acceleration;
 }
 
-void TimeEstimateCalculator::calculateTrapezoidForBlock(Block* block, const Ratio entry_factor, const Ratio exit_factor)
+void TimeEstimateCalculator::calculateTrapezoidForBlock(Block* block, const Ratio entry_factor, const Ratio exit_factor) const
 {
     const Velocity initial_feedrate = block->nominal_feedrate * entry_factor;
     const Velocity final_feedrate = block->nominal_feedrate * exit_factor;
@@ -159,15 +193,44 @@ void TimeEstimateCalculator::calculateTrapezoidForBlock(Block* block, const Rati
 
 void TimeEstimateCalculator::plan(Position newPos, Velocity feedrate, PrintFeatureType feature)
 {
+    bool moves_somewhere = false;
+    for (size_t n = 0; n < NUM_AXIS; n++)
+    {
+        moves_somewhere |= newPos[n] != currentPosition[n];
+    }
+    if (! moves_somewhere)
+    {
+        return;
+    }
+
+    if (moves.size() == 0)
+    {
+        start_position = currentPosition;
+    }
+    moves.destinations.push_back(newPos);
+    moves.feedrates.push_back(feedrate);
+    moves.features.push_back(feature);
+    moves.accelerations.push_back(acceleration);
+    moves.max_xy_jerks.push_back(max_xy_jerk);
+
+    currentPosition = newPos;
+}
+
+void TimeEstimateCalculator::planBlock(PlannerState& state, const size_t move_idx) const
+{
+    const Position& newPos = moves.destinations[move_idx];
+    Velocity feedrate = moves.feedrates[move_idx];
+    const Velocity move_max_xy_jerk = moves.max_xy_jerks[move_idx];
+
     Block block;
     memset(&block, 0, sizeof(block));
 
-    block.feature = feature;
+    block.feature = moves.features[move_idx];
 
     // block.maxTravel = 0; //Done by memset.
     for (size_t n = 0; n < NUM_AXIS; n++)
     {
-        block.delta[n] = newPos[n] - currentPosition[n];
+        block.delta[n] = newPos[n] - state.current_position[n];
         block.absDelta[n] = std::abs(block.delta[n]);
         block.maxTravel = std::max(block.maxTravel, block.absDelta[n]);
     }
@@ -210,7 +273,7 @@ void TimeEstimateCalculator::plan(Position newPos, Velocity feedrate, PrintFeatu
         block.nominal_feedrate *= feedrate_factor;
     }
 
-    block.acceleration = acceleration;
+    block.acceleration = moves.accelerations[move_idx];
     for (size_t n = 0; n < NUM_AXIS; n++)
     {
         if (block.acceleration * (block.absDelta[n] / block.distance) > max_acceleration[n])
@@ -219,7 +282,7 @@ void TimeEstimateCalculator::plan(Position newPos, Velocity feedrate, PrintFeatu
         }
     }
 
-    Velocity vmax_junction{ max_xy_jerk / 2.0 };
+    Velocity vmax_junction{ move_max_xy_jerk / 2.0 };
     Ratio vmax_junction_factor{ 1.0 };
     if (current_abs_feedrate[Z_AXIS] > max_z_jerk / 2.0)
     {
@@ -232,13 +295,14 @@ void TimeEstimateCalculator::plan(Position newPos, Velocity feedrate, PrintFeatu
     vmax_junction = std::min(vmax_junction, block.nominal_feedrate);
     const Velocity safe_speed = vmax_junction;
 
-    if ((blocks.size() > 0) && (previous_nominal_feedrate > 0.0001))
+    if ((state.blocks.size() > 0) && (state.previous_nominal_feedrate > 0.0001))
     {
+        const Position& previous_feedrate = state.previous_feedrate;
         const Velocity xy_jerk = sqrt(square(current_feedrate[X_AXIS] - previous_feedrate[X_AXIS]) + square(current_feedrate[Y_AXIS] - previous_feedrate[Y_AXIS]));
         vmax_junction = block.nominal_feedrate;
-        if (xy_jerk > max_xy_jerk)
+        if (xy_jerk > move_max_xy_jerk)
         {
-            vmax_junction_factor = Ratio(max_xy_jerk / xy_jerk);
+            vmax_junction_factor = Ratio(move_max_xy_jerk / xy_jerk);
         }
         const double z_jerk = std::abs(current_feedrate[Z_AXIS] - previous_feedrate[Z_AXIS]);
         if (z_jerk > max_z_jerk)
@@ -250,7 +314,7 @@ void TimeEstimateCalculator::plan(Position newPos, Velocity feedrate, PrintFeatu
         {
             vmax_junction_factor = std::min(vmax_junction_factor, Ratio(max_e_jerk / e_jerk));
         }
-        vmax_junction = std::min(previous_nominal_feedrate, Velocity{ vmax_junction * vmax_junction_factor }); // Limit speed to max previous speed
+        vmax_junction = std::min(state.previous_nominal_feedrate, Velocity{ vmax_junction * vmax_junction_factor }); // Limit speed to max previous speed
     }
 
     block.max_entry_speed = vmax_junction;
@@ -260,25 +324,82 @@ void TimeEstimateCalculator::plan(Position newPos, Velocity feedrate, PrintFeatu
     block.nominal_length_flag = block.nominal_feedrate <= v_allowable;
     block.recalculate_flag = true; // Always calculate trapezoid for new block
 
-    previous_feedrate = current_feedrate;
-    previous_nominal_feedrate = block.nominal_feedrate;
+    state.previous_feedrate = current_feedrate;
+    state.previous_nominal_feedrate = block.nominal_feedrate;
 
-    currentPosition = newPos;
+    state.current_position = newPos;
 
     calculateTrapezoidForBlock(&block, Ratio(block.entry_speed / block.nominal_feedrate), Ratio(safe_speed / block.nominal_feedrate));
 
-    blocks.push_back(block);
+    state.blocks.push_back(block);
 }
 
-std::vector<Duration> TimeEstimateCalculator::calculate()
+std::vector<Duration> TimeEstimateCalculator::calculate() const
 {
-    reversePass();
-    forwardPass();
-    recalculateTrapezoids();
-
     std::vector<Duration> totals(static_cast<unsigned char>(PrintFeatureType::NumPrintFeatureTypes), 0.0);
     totals[static_cast<unsigned char>(PrintFeatureType::NoneType)] = extra_time; // Extra time (pause for minimum layer time, etc) is marked as NoneType
-    for (unsigned int n = 0; n < blocks.size(); n++)
+
+    const size_t segment_count = round_up_divide(moves.size(), segment_size);
+    if (segment_count <= 1)
+    {
+        calculateSegment(0, 0, moves.size(), moves.size(), totals);
+        return totals;
+    }
+
+    std::vector<std::vector<Duration>> totals_per_segment(segment_count, std::vector<Duration>(totals.size(), 0.0));
+    cura::parallel_for<size_t>(
+        0,
+        segment_count,
+        [&](const size_t segment_idx)
+        {
+            const size_t first = segment_idx * segment_size;
+            const size_t last = std::min(first + segment_size, moves.size());
+            const size_t plan_start = first - std::min(first, segment_overlap);
+            const size_t plan_end = std::min(last + segment_overlap, moves.size());
+            calculateSegment(plan_start, first, last, plan_end, totals_per_segment[segment_idx]);
+        });
+    for (const std::vector<Duration>& segment_totals : totals_per_segment)
+    {
+        for (size_t feature_idx = 0; feature_idx < totals.size(); feature_idx++)
+        {
+            totals[feature_idx] += segment_totals[feature_idx];
+        }
+    }
+    return totals;
+}
+
+void TimeEstimateCalculator::calculateSegment(const size_t plan_start, const size_t first, const size_t last, const size_t plan_end, std::vector<Duration>& totals) const
+{
+    PlannerState state;
+    state.current_position = (plan_start == 0) ? start_position : moves.destinations[plan_start - 1];
+    state.previous_nominal_feedrate = 0.0;
+    state.blocks.reserve(plan_end - plan_start);
+    auto position_change = std::lower_bound(
+        moves.position_changes.begin(),
+        moves.position_changes.end(),
+        plan_start,
+        [](const std::pair<size_t, Position>& change, const size_t move_idx)
+        {
+            return change.first < move_idx;
+        });
+    for (size_t move_idx = plan_start; move_idx < plan_end; move_idx++)
+    {
+        if (position_change != moves.position_changes.end() && position_change->first == move_idx)
+        {
+            state.current_position = position_change->second;
+            ++position_change;
+        }
+        planBlock(state, move_idx);
+    }
+    std::vector<Block>& blocks = state.blocks;
+
+    reversePass(blocks);
+    forwardPass(blocks);
+    recalculateTrapezoids(blocks);
+
+    // Every recorded move results in a block, so the blocks line up with the moves.
+    assert(blocks.size() == plan_end - plan_start);
+    for (size_t n = first - plan_start; n < last - plan_start; n++)
     {
         const Block& block = blocks[n];
         const double plateau_distance = block.decelerate_after - block.accelerate_until;
@@ -287,10 +408,9 @@ std::vector<Duration> TimeEstimateCalculator::calculate()
         totals[static_cast<unsigned char>(block.feature)] += plateau_distance / block.nominal_feedrate;
         totals[static_cast<unsigned char>(block.feature)] += accelerationTimeFromDistance(block.final_feedrate, (block.distance - block.decelerate_after), block.acceleration);
     }
-    return totals;
 }
 
-void TimeEstimateCalculator::plannerReversePassKernel(Block* previous, Block* current, Block* next)
+void TimeEstimateCalculator::plannerReversePassKernel(Block* previous, Block* current, Block* next) const
 {
     (void)previous;
     if (! current || ! next)
@@ -317,7 +437,7 @@ void TimeEstimateCalculator::plannerReversePassKernel(Block* previous, Block* cu
     }
 }
 
-void TimeEstimateCalculator::reversePass()
+void TimeEstimateCalculator::reversePass(std::vector<Block>& blocks) const
 {
     Block* block[3] = { nullptr, nullptr, nullptr };
     for (size_t n = blocks.size() - 1; int(n) >= 0; n--)
@@ -329,7 +449,7 @@ void TimeEstimateCalculator::reversePass()
     }
 }
 
-void TimeEstimateCalculator::plannerForwardPassKernel(Block* previous, Block* current, Block* next)
+void TimeEstimateCalculator::plannerForwardPassKernel(Block* previous, Block* current, Block* next) const
 {
     (void)next;
     if (! previous)
@@ -357,7 +477,7 @@ void TimeEstimateCalculator::plannerForwardPassKernel(Block* previous, Block* cu
     }
 }
 
-void TimeEstimateCalculator::forwardPass()
+void TimeEstimateCalculator::forwardPass(std::vector<Block>& blocks) const
 {
     Block* block[3] = { nullptr, nullptr, nullptr };
     for (size_t n = 0; n < blocks.size(); n++)
@@ -370,7 +490,7 @@ void TimeEstimateCalculator::forwardPass()
     plannerForwardPassKernel(block[1], block[2], nullptr);
 }
 
-void TimeEstimateCalculator::recalculateTrapezoids()
+void TimeEstimateCalculator::recalculateTrapezoids(std::vector<Block>& blocks) const
 {
     Block* current;
     Block* next = nullptr;
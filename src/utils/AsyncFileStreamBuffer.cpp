@@ -0,0 +1,167 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/AsyncFileStreamBuffer.h"
+
+#include <utility>
+
+namespace cura
+{
+
+AsyncFileStreamBuffer::AsyncFileStreamBuffer(const size_t buffer_size)
+    : buffer_size_(buffer_size)
+{
+    setp(nullptr, nullptr); // Every write ends up in overflow until a file is opened.
+}
+
+AsyncFileStreamBuffer::~AsyncFileStreamBuffer()
+{
+    close();
+}
+
+bool AsyncFileStreamBuffer::open(const char* filename, const bool binary)
+{
+    close();
+    file_.open(filename, binary ? std::ios_base::out | std::ios_base::binary : std::ios_base::out);
+    if (! file_.is_open())
+    {
+        return false;
+    }
+    binary_ = binary;
+    front_buffer_.resize(buffer_size_);
+    back_buffer_.resize(buffer_size_);
+    back_buffer_pending_ = false;
+    stopping_ = false;
+    failed_ = false;
+    setp(front_buffer_.data(), front_buffer_.data() + front_buffer_.size());
+    writer_ = std::thread(&AsyncFileStreamBuffer::writeLoop, this);
+    return true;
+}
+
+bool AsyncFileStreamBuffer::isOpen() const
+{
+    return writer_.joinable();
+}
+
+bool AsyncFileStreamBuffer::isBinary() const
+{
+    return binary_;
+}
+
+void AsyncFileStreamBuffer::close()
+{
+    if (! isOpen())
+    {
+        return;
+    }
+    sync();
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    writer_.join();
+    file_.close();
+    setp(nullptr, nullptr);
+}
+
+AsyncFileStreamBuffer::int_type AsyncFileStreamBuffer::overflow(int_type ch)
+{
+    if (! isOpen())
+    {
+        return traits_type::eof();
+    }
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        return traits_type::not_eof(ch);
+    }
+    if (! handOver(false))
+    {
+        return traits_type::eof();
+    }
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+int AsyncFileStreamBuffer::sync()
+{
+    if (! isOpen())
+    {
+        return 0;
+    }
+    return handOver(true) && waitUntilWritten() ? 0 : -1;
+}
+
+bool AsyncFileStreamBuffer::handOver(const bool flush)
+{
+    const size_t used = static_cast<size_t>(pptr() - pbase());
+    {
+        std::unique_lock lock(mutex_);
+        condition_.wait(
+            lock,
+            [this]()
+            {
+                return ! back_buffer_pending_;
+            });
+        if (failed_)
+        {
+            return false;
+        }
+        std::swap(front_buffer_, back_buffer_); // Swapping vectors keeps their data in place.
+        back_buffer_used_ = used;
+        back_buffer_pending_ = true;
+        flush_requested_ = flush;
+    }
+    condition_.notify_all();
+    setp(front_buffer_.data(), front_buffer_.data() + front_buffer_.size());
+    return true;
+}
+
+bool AsyncFileStreamBuffer::waitUntilWritten()
+{
+    std::unique_lock lock(mutex_);
+    condition_.wait(
+        lock,
+        [this]()
+        {
+            return ! back_buffer_pending_;
+        });
+    return ! failed_;
+}
+
+void AsyncFileStreamBuffer::writeLoop()
+{
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        condition_.wait(
+            lock,
+            [this]()
+            {
+                return back_buffer_pending_ || stopping_;
+            });
+        if (! back_buffer_pending_)
+        {
+            return; // Stopping, and everything is written.
+        }
+        const size_t used = back_buffer_used_;
+        const bool flush = flush_requested_;
+        lock.unlock();
+
+        // The back buffer isn't touched by the stream while it's pending.
+        file_.write(back_buffer_.data(), static_cast<std::streamsize>(used));
+        if (flush)
+        {
+            file_.flush();
+        }
+        const bool good = file_.good();
+
+        lock.lock();
+        failed_ = failed_ || ! good;
+        back_buffer_pending_ = false;
+        condition_.notify_all();
+    }
+}
+
+} // namespace cura
@@ -0,0 +1,585 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/BinaryGCode.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "Application.h"
+#include "utils/ThreadPool.h"
+
+namespace cura
+{
+namespace bgcode
+{
+
+namespace
+{
+
+constexpr uint32_t file_version = 1;
+constexpr uint16_t checksum_crc32 = 1;
+constexpr uint16_t default_encoding = 0; //!< INI for metadata blocks, plain text for g-code blocks
+
+constexpr size_t heatshrink_window_bits = 12;
+constexpr size_t heatshrink_lookahead_bits = 4;
+constexpr size_t heatshrink_max_offset = size_t(1) << heatshrink_window_bits;
+constexpr size_t heatshrink_max_length = size_t(1) << heatshrink_lookahead_bits;
+constexpr size_t heatshrink_min_length = 3; //!< A back-reference takes 17 bits, so it only pays off from 3 bytes on.
+constexpr size_t heatshrink_max_chain = 64; //!< The maximum number of earlier occurrences to try for each match
+constexpr size_t heatshrink_hash_bits = 14;
+
+template<typename T>
+void appendLittleEndian(std::string& out, const T value)
+{
+    for (size_t byte = 0; byte < sizeof(T); byte++)
+    {
+        out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * byte)) & 0xFF));
+    }
+}
+
+template<typename T>
+std::optional<T> readLittleEndian(std::string_view& in)
+{
+    if (in.size() < sizeof(T))
+    {
+        return std::nullopt;
+    }
+    uint64_t value = 0;
+    for (size_t byte = 0; byte < sizeof(T); byte++)
+    {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(in[byte])) << (8 * byte);
+    }
+    in.remove_prefix(sizeof(T));
+    return static_cast<T>(value);
+}
+
+class BitWriter
+{
+public:
+    explicit BitWriter(std::string& out)
+        : out_(out)
+    {
+    }
+
+    void write(const uint32_t value, const size_t bit_count)
+    {
+        for (size_t bit = bit_count; bit-- > 0;)
+        {
+            current_ = static_cast<uint8_t>((current_ << 1) | ((value >> bit) & 1));
+            bits_used_++;
+            if (bits_used_ == 8)
+            {
+                out_.push_back(static_cast<char>(current_));
+                current_ = 0;
+                bits_used_ = 0;
+            }
+        }
+    }
+
+    //! Write the last partial byte, padded with zeroes.
+    void finish()
+    {
+        if (bits_used_ > 0)
+        {
+            out_.push_back(static_cast<char>(current_ << (8 - bits_used_)));
+        }
+    }
+
+private:
+    std::string& out_;
+    uint8_t current_ = 0;
+    size_t bits_used_ = 0;
+};
+
+class BitReader
+{
+public:
+    explicit BitReader(const std::string_view in)
+        : in_(in)
+    {
+    }
+
+    std::optional<uint32_t> read(const size_t bit_count)
+    {
+        if (bit_pos_ + bit_count > in_.size() * 8)
+        {
+            return std::nullopt;
+        }
+        uint32_t value = 0;
+        for (size_t bit = 0; bit < bit_count; bit++, bit_pos_++)
+        {
+            const uint8_t byte = static_cast<uint8_t>(in_[bit_pos_ / 8]);
+            value = (value << 1) | ((byte >> (7 - bit_pos_ % 8)) & 1);
+        }
+        return value;
+    }
+
+private:
+    std::string_view in_;
+    size_t bit_pos_ = 0;
+};
+
+std::array<uint32_t, 256> makeCrc32Table()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t byte = 0; byte < 256; byte++)
+    {
+        uint32_t crc = byte;
+        for (size_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+        table[byte] = crc;
+    }
+    return table;
+}
+
+std::string_view trim(std::string_view text)
+{
+    const size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+    const size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+} // namespace
+
+std::string encodeFileHeader()
+{
+    std::string header = "GCDE";
+    appendLittleEndian(header, file_version);
+    appendLittleEndian(header, checksum_crc32);
+    return header;
+}
+
+std::string encodeBlock(const BlockType type, const std::string_view data, Compression compression)
+{
+    assert(type != BlockType::THUMBNAIL && "Thumbnails have different block parameters.");
+    assert((compression == Compression::NONE || compression == Compression::HEATSHRINK_12_4) && "Only heatshrink 12/4 compression is supported.");
+
+    std::string compressed;
+    if (compression == Compression::HEATSHRINK_12_4)
+    {
+        compressed = heatshrinkCompress(data);
+        if (compressed.size() >= data.size())
+        {
+            compression = Compression::NONE;
+        }
+    }
+    const std::string_view payload = compression == Compression::NONE ? data : std::string_view(compressed);
+
+    std::string block;
+    block.reserve(payload.size() + 20);
+    appendLittleEndian(block, static_cast<uint16_t>(type));
+    appendLittleEndian(block, static_cast<uint16_t>(compression));
+    appendLittleEndian(block, static_cast<uint32_t>(data.size()));
+    if (compression != Compression::NONE)
+    {
+        appendLittleEndian(block, static_cast<uint32_t>(payload.size()));
+    }
+    appendLittleEndian(block, default_encoding);
+    block.append(payload);
+    appendLittleEndian(block, crc32(block));
+    return block;
+}
+
+std::string encodeMetadata(const Metadata& metadata)
+{
+    std::string result;
+    for (const auto& [key, value] : metadata)
+    {
+        result.append(key).append("=").append(value).append("\n");
+    }
+    return result;
+}
+
+Metadata parseHeaderComments(const std::string_view header)
+{
+    Metadata metadata;
+    size_t line_start = 0;
+    while (line_start < header.size())
+    {
+        const size_t line_end = std::min(header.find('\n', line_start), header.size());
+        const std::string_view line = header.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+
+        const size_t separator = line.find(':');
+        if (line.empty() || line[0] != ';' || separator == std::string_view::npos)
+        {
+            continue;
+        }
+        const std::string_view key = trim(line.substr(1, separator - 1));
+        if (! key.empty())
+        {
+            metadata.emplace_back(std::string(key), std::string(trim(line.substr(separator + 1))));
+        }
+    }
+    return metadata;
+}
+
+std::optional<std::vector<Block>> decode(std::string_view file)
+{
+    if (file.substr(0, 4) != "GCDE")
+    {
+        return std::nullopt;
+    }
+    file.remove_prefix(4);
+    const std::optional<uint32_t> version = readLittleEndian<uint32_t>(file);
+    const std::optional<uint16_t> checksum_type = readLittleEndian<uint16_t>(file);
+    if (! version || *version != file_version || ! checksum_type || *checksum_type > checksum_crc32)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<Block> blocks;
+    while (! file.empty())
+    {
+        const std::string_view block_start = file;
+        const std::optional<uint16_t> type = readLittleEndian<uint16_t>(file);
+        const std::optional<uint16_t> compression = readLittleEndian<uint16_t>(file);
+        const std::optional<uint32_t> size = readLittleEndian<uint32_t>(file);
+        if (! type || ! compression || ! size || *type > static_cast<uint16_t>(BlockType::THUMBNAIL))
+        {
+            return std::nullopt;
+        }
+        std::optional<uint32_t> payload_size = size;
+        if (*compression != static_cast<uint16_t>(Compression::NONE))
+        {
+            payload_size = readLittleEndian<uint32_t>(file);
+        }
+        const size_t parameters_size = *type == static_cast<uint16_t>(BlockType::THUMBNAIL) ? 6 : 2;
+        if (! payload_size || file.size() < parameters_size + *payload_size)
+        {
+            return std::nullopt;
+        }
+        file.remove_prefix(parameters_size);
+        const std::string_view payload = file.substr(0, *payload_size);
+        file.remove_prefix(*payload_size);
+
+        if (*checksum_type == checksum_crc32)
+        {
+            const std::string_view checked = block_start.substr(0, block_start.size() - file.size());
+            const std::optional<uint32_t> checksum = readLittleEndian<uint32_t>(file);
+            if (! checksum || *checksum != crc32(checked))
+            {
+                return std::nullopt;
+            }
+        }
+
+        Block block{ static_cast<BlockType>(*type), {} };
+        switch (static_cast<Compression>(*compression))
+        {
+        case Compression::NONE:
+            block.data = payload;
+            break;
+        case Compression::HEATSHRINK_12_4:
+        {
+            std::optional<std::string> data = heatshrinkDecompress(payload, *size);
+            if (! data)
+            {
+                return std::nullopt;
+            }
+            block.data = std::move(*data);
+            break;
+        }
+        default:
+            return std::nullopt;
+        }
+        blocks.push_back(std::move(block));
+    }
+    return blocks;
+}
+
+std::string heatshrinkCompress(const std::string_view data)
+{
+    std::string result;
+    result.reserve(data.size() / 2);
+    BitWriter writer(result);
+
+    // Earlier positions are found through hash chains of the 3 bytes starting at each position.
+    std::vector<int64_t> chain_head(size_t(1) << heatshrink_hash_bits, -1);
+    std::vector<int64_t> chain_previous(data.size(), -1);
+    const auto hash = [&data](const size_t pos)
+    {
+        const uint32_t key = (static_cast<uint32_t>(static_cast<uint8_t>(data[pos])) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(data[pos + 1])) << 8)
+                           | static_cast<uint32_t>(static_cast<uint8_t>(data[pos + 2]));
+        return (key * 2654435761u) >> (32 - heatshrink_hash_bits);
+    };
+    const auto insert = [&](const size_t pos)
+    {
+        if (pos + heatshrink_min_length <= data.size())
+        {
+            const size_t key = hash(pos);
+            chain_previous[pos] = chain_head[key];
+            chain_head[key] = static_cast<int64_t>(pos);
+        }
+    };
+
+    size_t pos = 0;
+    while (pos < data.size())
+    {
+        size_t best_length = 0;
+        size_t best_offset = 0;
+        if (pos + heatshrink_min_length <= data.size())
+        {
+            const size_t max_length = std::min(heatshrink_max_length, data.size() - pos);
+            size_t chain_length = 0;
+            for (int64_t candidate = chain_head[hash(pos)]; candidate >= 0 && pos - static_cast<size_t>(candidate) <= heatshrink_max_offset && chain_length < heatshrink_max_chain;
+                 candidate = chain_previous[candidate], chain_length++)
+            {
+                size_t length = 0;
+                while (length < max_length && data[static_cast<size_t>(candidate) + length] == data[pos + length])
+                {
+                    length++;
+                }
+                if (length > best_length)
+                {
+                    best_length = length;
+                    best_offset = pos - static_cast<size_t>(candidate);
+                    if (length == max_length)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (best_length >= heatshrink_min_length)
+        {
+            writer.write(0, 1);
+            writer.write(static_cast<uint32_t>(best_offset - 1), heatshrink_window_bits);
+            writer.write(static_cast<uint32_t>(best_length - 1), heatshrink_lookahead_bits);
+            for (size_t skipped = 0; skipped < best_length; skipped++)
+            {
+                insert(pos + skipped);
+            }
+            pos += best_length;
+        }
+        else
+        {
+            writer.write(1, 1);
+            writer.write(static_cast<uint8_t>(data[pos]), 8);
+            insert(pos);
+            pos++;
+        }
+    }
+    writer.finish();
+    return result;
+}
+
+std::optional<std::string> heatshrinkDecompress(const std::string_view data, const size_t decompressed_size)
+{
+    std::string result;
+    result.reserve(decompressed_size);
+    BitReader reader(data);
+    while (result.size() < decompressed_size)
+    {
+        const std::optional<uint32_t> is_literal = reader.read(1);
+        if (! is_literal)
+        {
+            return std::nullopt;
+        }
+        if (*is_literal)
+        {
+            const std::optional<uint32_t> byte = reader.read(8);
+            if (! byte)
+            {
+                return std::nullopt;
+            }
+            result.push_back(static_cast<char>(*byte));
+            continue;
+        }
+        const std::optional<uint32_t> offset = reader.read(heatshrink_window_bits);
+        const std::optional<uint32_t> length = reader.read(heatshrink_lookahead_bits);
+        if (! offset || ! length || *offset + 1 > result.size())
+        {
+            return std::nullopt;
+        }
+        // Copied byte by byte, since the reference may overlap with the bytes being written.
+        for (size_t copied = 0; copied <= *length && result.size() < decompressed_size; copied++)
+        {
+            result.push_back(result[result.size() - *offset - 1]);
+        }
+    }
+    return result;
+}
+
+uint32_t crc32(const std::string_view data, const uint32_t crc)
+{
+    static const std::array<uint32_t, 256> table = makeCrc32Table();
+    uint32_t result = ~crc;
+    for (const char byte : data)
+    {
+        result = table[(result ^ static_cast<uint8_t>(byte)) & 0xFF] ^ (result >> 8);
+    }
+    return ~result;
+}
+
+} // namespace bgcode
+
+BinaryGCodeEncoder::BinaryGCodeEncoder(std::ostream& target, const size_t block_size)
+    : target_(target)
+    , block_size_(block_size)
+    , max_pending_blocks_(std::max(size_t(std::thread::hardware_concurrency()), size_t(1)))
+{
+    const std::string header = bgcode::encodeFileHeader();
+    target_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    text_.resize(block_size_);
+    setp(text_.data(), text_.data() + text_.size());
+}
+
+BinaryGCodeEncoder::~BinaryGCodeEncoder()
+{
+    if (pptr() != pbase() || ! pending_blocks_.empty())
+    {
+        sync();
+    }
+    releaseGCode();
+}
+
+void BinaryGCodeEncoder::writeMetadata(const bgcode::BlockType type, const bgcode::Metadata& metadata)
+{
+    if (held_gcode_)
+    {
+        // All pending blocks are g-code that goes to the held back g-code, so the metadata can go to the target stream right away.
+        const std::string block = bgcode::encodeBlock(type, bgcode::encodeMetadata(metadata), bgcode::Compression::NONE);
+        target_.write(block.data(), static_cast<std::streamsize>(block.size()));
+        return;
+    }
+    assert(pptr() == pbase() && "Metadata should be written before any g-code.");
+    enqueue(
+        std::packaged_task<std::string()>(
+            [type, data = bgcode::encodeMetadata(metadata)]()
+            {
+                return bgcode::encodeBlock(type, data, bgcode::Compression::NONE);
+            }),
+        false);
+}
+
+void BinaryGCodeEncoder::holdGCode()
+{
+    assert(! held_gcode_ && "The g-code is held back already.");
+    writePendingBlocks(true); // Metadata that was added before goes in front of the g-code.
+    held_gcode_.emplace();
+}
+
+void BinaryGCodeEncoder::releaseGCode()
+{
+    if (! held_gcode_)
+    {
+        return;
+    }
+    if (pptr() != pbase())
+    {
+        emitBlock(static_cast<size_t>(pptr() - pbase()));
+    }
+    writePendingBlocks(true);
+    target_.write(held_gcode_->data(), static_cast<std::streamsize>(held_gcode_->size()));
+    held_gcode_.reset();
+    target_.flush();
+}
+
+BinaryGCodeEncoder::int_type BinaryGCodeEncoder::overflow(int_type ch)
+{
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        return traits_type::not_eof(ch);
+    }
+    // Cut the block after the last complete line, so that each block only holds whole lines.
+    const std::string_view text(pbase(), static_cast<size_t>(pptr() - pbase()));
+    const size_t last_newline = text.rfind('\n');
+    emitBlock(last_newline == std::string_view::npos ? text.size() : last_newline + 1);
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+int BinaryGCodeEncoder::sync()
+{
+    if (pptr() != pbase())
+    {
+        emitBlock(static_cast<size_t>(pptr() - pbase()));
+    }
+    writePendingBlocks(true);
+    target_.flush();
+    return target_.good() ? 0 : -1;
+}
+
+void BinaryGCodeEncoder::emitBlock(const size_t length)
+{
+    const size_t used = static_cast<size_t>(pptr() - pbase());
+    std::string block_text = std::move(text_);
+    text_ = std::string(block_size_, '\0');
+    const size_t carry_over = used - length;
+    std::memcpy(text_.data(), block_text.data() + length, carry_over);
+    setp(text_.data(), text_.data() + text_.size());
+    pbump(static_cast<int>(carry_over));
+
+    block_text.resize(length);
+    enqueue(
+        std::packaged_task<std::string()>(
+            [text = std::move(block_text)]()
+            {
+                return bgcode::encodeBlock(bgcode::BlockType::GCODE, text, bgcode::Compression::HEATSHRINK_12_4);
+            }),
+        true);
+}
+
+void BinaryGCodeEncoder::enqueue(std::packaged_task<std::string()>&& encode, const bool in_background)
+{
+    if (pending_blocks_.size() >= max_pending_blocks_)
+    {
+        writeFrontBlock();
+    }
+    auto job = std::make_shared<EncodeJob>();
+    job->task = std::move(encode);
+    job->result = job->task.get_future();
+    pending_blocks_.push_back(job);
+
+    ThreadPool* const thread_pool = Application::getInstance().thread_pool_;
+    if (in_background && thread_pool != nullptr && thread_pool->thread_count() > 0)
+    {
+        ThreadPool::lock_t lock = thread_pool->get_lock();
+        thread_pool->push(
+            lock,
+            [job](ThreadPool::lock_t& th_lock)
+            {
+                th_lock.unlock();
+                job->run();
+                th_lock.lock();
+            });
+    }
+    writePendingBlocks(false);
+}
+
+void BinaryGCodeEncoder::writeFrontBlock()
+{
+    const std::shared_ptr<EncodeJob> job = std::move(pending_blocks_.front());
+    pending_blocks_.pop_front();
+    job->run();
+    const std::string encoded = job->result.get();
+    if (held_gcode_)
+    {
+        held_gcode_->append(encoded);
+        return;
+    }
+    target_.write(encoded.data(), static_cast<std::streamsize>(encoded.size()));
+}
+
+void BinaryGCodeEncoder::writePendingBlocks(const bool wait)
+{
+    while (! pending_blocks_.empty() && (wait || pending_blocks_.front()->result.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+    {
+        writeFrontBlock();
+    }
+}
+
+} // namespace cura
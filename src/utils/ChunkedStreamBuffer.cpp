@@ -0,0 +1,76 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/ChunkedStreamBuffer.h"
+
+namespace cura
+{
+
+ChunkedStreamBuffer::ChunkedStreamBuffer(const size_t block_size)
+    : block_size_(block_size)
+{
+    startBlock();
+}
+
+size_t ChunkedStreamBuffer::size() const
+{
+    return full_blocks_.size() * block_size_ + static_cast<size_t>(pptr() - pbase());
+}
+
+std::vector<std::string> ChunkedStreamBuffer::take()
+{
+    std::vector<std::string> result;
+    result.swap(full_blocks_);
+    const size_t used_in_current_block = static_cast<size_t>(pptr() - pbase());
+    if (used_in_current_block == 0)
+    {
+        return result; // Nothing was written after the last full block, so the current block can be kept as it is.
+    }
+
+    current_block_.resize(used_in_current_block);
+    result.push_back(std::move(current_block_));
+    startBlock();
+    return result;
+}
+
+void ChunkedStreamBuffer::recycle(std::vector<std::string>&& blocks)
+{
+    for (std::string& block : blocks)
+    {
+        if (block.capacity() >= block_size_)
+        {
+            spare_blocks_.push_back(std::move(block));
+        }
+    }
+    blocks.clear();
+}
+
+ChunkedStreamBuffer::int_type ChunkedStreamBuffer::overflow(int_type ch)
+{
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        return traits_type::not_eof(ch);
+    }
+    full_blocks_.push_back(std::move(current_block_));
+    startBlock();
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+void ChunkedStreamBuffer::startBlock()
+{
+    if (! spare_blocks_.empty())
+    {
+        current_block_ = std::move(spare_blocks_.back());
+        spare_blocks_.pop_back();
+    }
+    else
+    {
+        current_block_ = std::string();
+    }
+    current_block_.resize(block_size_); // Only new blocks and the part of the last block that wasn't written are filled.
+    setp(current_block_.data(), current_block_.data() + block_size_);
+}
+
+} // namespace cura
@@ -0,0 +1,104 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/CompactShapeArena.h"
+
+#include <cassert>
+
+namespace cura
+{
+
+namespace
+{
+
+void appendVarint(std::vector<uint8_t>& data, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+void appendSigned(std::vector<uint8_t>& data, const int64_t value)
+{
+    // Zigzag encoding, so that small negative numbers get small codes too.
+    appendVarint(data, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+uint64_t readVarint(const uint8_t*& position)
+{
+    uint64_t value = 0;
+    for (size_t shift = 0;; shift += 7)
+    {
+        const uint8_t byte = *position++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (! (byte & 0x80))
+        {
+            return value;
+        }
+    }
+}
+
+int64_t readSigned(const uint8_t*& position)
+{
+    const uint64_t value = readVarint(position);
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace
+
+CompactShapeArena::Handle CompactShapeArena::add(const Shape& shape)
+{
+    const Handle handle = data_.size();
+    appendVarint(data_, shape.size());
+    Point2LL previous(0, 0);
+    for (const Polygon& polygon : shape)
+    {
+        appendVarint(data_, (static_cast<uint64_t>(polygon.size()) << 1) | (polygon.isExplicitelyClosed() ? 1 : 0));
+        for (const Point2LL& point : polygon)
+        {
+            appendSigned(data_, point.X - previous.X);
+            appendSigned(data_, point.Y - previous.Y);
+            previous = point;
+        }
+    }
+    return handle;
+}
+
+Shape CompactShapeArena::get(const Handle handle) const
+{
+    assert(handle < data_.size());
+    const uint8_t* position = data_.data() + handle;
+    Shape shape;
+    const size_t polygon_count = readVarint(position);
+    shape.reserve(polygon_count);
+    Point2LL previous(0, 0);
+    for (size_t polygon_idx = 0; polygon_idx < polygon_count; polygon_idx++)
+    {
+        const uint64_t header = readVarint(position);
+        ClipperLib::Path points;
+        points.reserve(header >> 1);
+        for (uint64_t point_idx = 0; point_idx < (header >> 1); point_idx++)
+        {
+            previous.X += readSigned(position);
+            previous.Y += readSigned(position);
+            points.push_back(previous);
+        }
+        shape.emplace_back(std::move(points), (header & 1) != 0);
+    }
+    return shape;
+}
+
+void CompactShapeArena::shrinkToFit()
+{
+    data_.shrink_to_fit();
+}
+
+size_t CompactShapeArena::memoryUsage() const
+{
+    return data_.capacity();
+}
+
+} // namespace cura
@@ -0,0 +1,228 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/DefinitionBundle.h"
+
+#include <algorithm>
+
+namespace cura
+{
+
+namespace
+{
+
+constexpr std::string_view magic = "CURADEFS";
+constexpr uint32_t format_version = 2;
+
+constexpr uint64_t fnv_offset_basis = 14695981039346656037ULL;
+constexpr uint64_t fnv_prime = 1099511628211ULL;
+
+template<typename T>
+void appendLittleEndian(std::string& out, const T value)
+{
+    for (size_t byte = 0; byte < sizeof(T); byte++)
+    {
+        out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * byte)) & 0xFF));
+    }
+}
+
+template<typename T>
+std::optional<T> readLittleEndian(std::string_view& in)
+{
+    if (in.size() < sizeof(T))
+    {
+        return std::nullopt;
+    }
+    uint64_t value = 0;
+    for (size_t byte = 0; byte < sizeof(T); byte++)
+    {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(in[byte])) << (8 * byte);
+    }
+    in.remove_prefix(sizeof(T));
+    return static_cast<T>(value);
+}
+
+void appendString(std::string& out, const std::string_view str)
+{
+    appendLittleEndian(out, static_cast<uint32_t>(str.size()));
+    out.append(str);
+}
+
+std::optional<std::string_view> readString(std::string_view& in)
+{
+    const std::optional<uint32_t> length = readLittleEndian<uint32_t>(in);
+    if (! length || in.size() < *length)
+    {
+        return std::nullopt;
+    }
+    const std::string_view str = in.substr(0, *length);
+    in.remove_prefix(*length);
+    return str;
+}
+
+void appendSettings(std::string& out, const DefinitionBundle::SettingList& settings)
+{
+    std::vector<const std::pair<std::string, std::string>*> sorted;
+    sorted.reserve(settings.size());
+    for (const std::pair<std::string, std::string>& setting : settings)
+    {
+        sorted.push_back(&setting);
+    }
+    std::sort(
+        sorted.begin(),
+        sorted.end(),
+        [](const auto* a, const auto* b)
+        {
+            return a->first < b->first;
+        });
+
+    appendLittleEndian(out, static_cast<uint32_t>(sorted.size()));
+    for (const std::pair<std::string, std::string>* setting : sorted)
+    {
+        appendString(out, setting->first);
+        appendString(out, setting->second);
+    }
+}
+
+std::optional<DefinitionBundle::SettingList> readSettings(std::string_view& in)
+{
+    const std::optional<uint32_t> count = readLittleEndian<uint32_t>(in);
+    if (! count || in.size() < size_t(*count) * 8) // Every setting takes at least the two lengths.
+    {
+        return std::nullopt;
+    }
+    DefinitionBundle::SettingList settings;
+    settings.reserve(*count);
+    for (uint32_t setting_idx = 0; setting_idx < *count; setting_idx++)
+    {
+        const std::optional<std::string_view> key = readString(in);
+        const std::optional<std::string_view> value = key ? readString(in) : std::nullopt;
+        if (! value)
+        {
+            return std::nullopt;
+        }
+        settings.emplace_back(*key, *value);
+    }
+    return settings;
+}
+
+} // namespace
+
+bool DefinitionBundle::isBundle(const std::string_view data)
+{
+    return data.starts_with(magic);
+}
+
+uint64_t DefinitionBundle::hashSource(const std::string_view data, const uint64_t seed)
+{
+    uint64_t hash = seed == 0 ? fnv_offset_basis : seed;
+    for (const char c : data)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= fnv_prime;
+    }
+    hash ^= data.size(); // Make the boundaries between files count.
+    hash *= fnv_prime;
+    return hash;
+}
+
+std::string DefinitionBundle::serialize() const
+{
+    std::string out(magic);
+    appendLittleEndian(out, format_version);
+    appendLittleEndian(out, source_hash);
+    appendLittleEndian(out, static_cast<uint32_t>(source_files.size()));
+    for (const std::string& source_file : source_files)
+    {
+        appendString(out, source_file);
+    }
+    appendLittleEndian(out, static_cast<uint32_t>(definitions.size()));
+    for (const auto& [stack_idx, definition_file] : definitions)
+    {
+        appendLittleEndian(out, stack_idx);
+        appendString(out, definition_file);
+    }
+    appendLittleEndian(out, static_cast<uint32_t>(1 + extruder_settings.size()));
+    appendSettings(out, global_settings);
+    for (const SettingList& settings : extruder_settings)
+    {
+        appendSettings(out, settings);
+    }
+    return out;
+}
+
+std::optional<DefinitionBundle> DefinitionBundle::deserialize(std::string_view data)
+{
+    if (! isBundle(data))
+    {
+        return std::nullopt;
+    }
+    data.remove_prefix(magic.size());
+    const std::optional<uint32_t> version = readLittleEndian<uint32_t>(data);
+    const std::optional<uint64_t> source_hash = readLittleEndian<uint64_t>(data);
+    if (version != format_version || ! source_hash)
+    {
+        return std::nullopt;
+    }
+
+    DefinitionBundle bundle;
+    bundle.source_hash = *source_hash;
+    const std::optional<uint32_t> source_count = readLittleEndian<uint32_t>(data);
+    if (! source_count || data.size() < size_t(*source_count) * 4) // Every path takes at least its length.
+    {
+        return std::nullopt;
+    }
+    for (uint32_t source_idx = 0; source_idx < *source_count; source_idx++)
+    {
+        const std::optional<std::string_view> source_file = readString(data);
+        if (! source_file)
+        {
+            return std::nullopt;
+        }
+        bundle.source_files.emplace_back(*source_file);
+    }
+    const std::optional<uint32_t> definition_count = readLittleEndian<uint32_t>(data);
+    if (! definition_count || data.size() < size_t(*definition_count) * 8) // Every definition takes at least its stack and the length of its path.
+    {
+        return std::nullopt;
+    }
+    for (uint32_t definition_idx = 0; definition_idx < *definition_count; definition_idx++)
+    {
+        const std::optional<uint32_t> stack_idx = readLittleEndian<uint32_t>(data);
+        const std::optional<std::string_view> definition_file = stack_idx ? readString(data) : std::nullopt;
+        if (! definition_file)
+        {
+            return std::nullopt;
+        }
+        bundle.definitions.emplace_back(*stack_idx, *definition_file);
+    }
+
+    const std::optional<uint32_t> stack_count = readLittleEndian<uint32_t>(data);
+    if (! stack_count || *stack_count == 0)
+    {
+        return std::nullopt;
+    }
+    for (uint32_t stack_idx = 0; stack_idx < *stack_count; stack_idx++)
+    {
+        std::optional<SettingList> settings = readSettings(data);
+        if (! settings)
+        {
+            return std::nullopt;
+        }
+        if (stack_idx == 0)
+        {
+            bundle.global_settings = std::move(*settings);
+        }
+        else
+        {
+            bundle.extruder_settings.push_back(std::move(*settings));
+        }
+    }
+    if (! data.empty())
+    {
+        return std::nullopt;
+    }
+    return bundle;
+}
+
+} // namespace cura
@@ -0,0 +1,108 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/MemoryUsage.h"
+
+#include <numeric>
+
+#ifdef _WIN32
+#include <windows.h>
+// windows.h has to come first.
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "geometry/MixedLinesSet.h"
+#include "geometry/Polyline.h"
+#include "utils/ExtrusionLine.h"
+
+namespace cura
+{
+
+size_t getPeakResidentMemory()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (! GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss); // In bytes on macOS.
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024; // In kilobytes elsewhere.
+#endif
+#endif
+}
+
+void MemoryReport::add(const std::string& structure, const size_t bytes)
+{
+    bytes_per_structure.emplace_back(structure, bytes);
+}
+
+void MemoryReport::addToLayer(const size_t layer_idx, const size_t bytes)
+{
+    if (bytes_per_layer.size() <= layer_idx)
+    {
+        bytes_per_layer.resize(layer_idx + 1, 0);
+    }
+    bytes_per_layer[layer_idx] += bytes;
+}
+
+size_t MemoryReport::total() const
+{
+    return std::accumulate(
+        bytes_per_structure.begin(),
+        bytes_per_structure.end(),
+        size_t(0),
+        [](const size_t sum, const std::pair<std::string, size_t>& structure)
+        {
+            return sum + structure.second;
+        });
+}
+
+void MemoryReport::log(const std::string_view title) const
+{
+    constexpr double mebibyte = 1024.0 * 1024.0;
+    spdlog::info("{} uses {:.1f} MiB (peak resident memory {:.1f} MiB)", title, total() / mebibyte, getPeakResidentMemory() / mebibyte);
+    for (const auto& [structure, bytes] : bytes_per_structure)
+    {
+        spdlog::debug("├── {}: {:.1f} MiB", structure, bytes / mebibyte);
+    }
+    for (size_t layer_idx = 0; layer_idx < bytes_per_layer.size(); layer_idx++)
+    {
+        spdlog::trace("{} layer [{}]: {:.1f} kiB", title, layer_idx, bytes_per_layer[layer_idx] / 1024.0);
+    }
+}
+
+size_t memoryUsage(const PointsSet& points)
+{
+    return points.getPoints().capacity() * sizeof(Point2LL);
+}
+
+size_t memoryUsage(const MixedLinesSet& lines)
+{
+    size_t bytes = lines.capacity() * sizeof(PolylinePtr);
+    for (const PolylinePtr& line : lines)
+    {
+        bytes += sizeof(Polyline) + memoryUsage(*line);
+    }
+    return bytes;
+}
+
+size_t memoryUsage(const ExtrusionLine& line)
+{
+    return line.junctions_.capacity() * sizeof(ExtrusionJunction);
+}
+
+} // namespace cura
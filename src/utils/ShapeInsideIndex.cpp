@@ -0,0 +1,174 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/ShapeInsideIndex.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+
+namespace cura
+{
+
+ShapeInsideIndex::ShapeInsideIndex(const Shape& shape)
+{
+    // Polygons with less than 3 vertices are ignored, like ClipperLib::PointInPolygon does.
+    size_t edge_count = 0;
+    double total_edge_height = 0;
+    coord_t min_y = std::numeric_limits<coord_t>::max();
+    coord_t max_y = std::numeric_limits<coord_t>::lowest();
+    for (const Polygon& polygon : shape)
+    {
+        if (polygon.size() < 3)
+        {
+            continue;
+        }
+        edge_count += polygon.size();
+        Point2LL previous = polygon.back();
+        for (const Point2LL& point : polygon)
+        {
+            min_y = std::min(min_y, point.Y);
+            max_y = std::max(max_y, point.Y);
+            total_edge_height += std::abs(point.Y - previous.Y);
+            previous = point;
+        }
+    }
+    if (edge_count == 0)
+    {
+        return;
+    }
+
+    // Aim for a few edges per slab, but limit the number of slabs so that edges that are tall compared to the slabs don't get copied into too
+    // many of them: the edges are stored at most about 4 times in total.
+    constexpr size_t edges_per_slab = 4;
+    constexpr double max_copies_per_edge = 3.0;
+    const double shape_height = static_cast<double>(max_y - min_y) + 1;
+    size_t slab_count = std::max(size_t(1), edge_count / edges_per_slab);
+    if (total_edge_height > 0)
+    {
+        slab_count = std::min(slab_count, static_cast<size_t>(max_copies_per_edge * edge_count * shape_height / total_edge_height) + 1);
+    }
+    min_y_ = min_y;
+    slab_height_ = (max_y - min_y) / static_cast<coord_t>(slab_count) + 1;
+    slab_count = (max_y - min_y) / slab_height_ + 1;
+
+    const auto for_each_edge = [&shape](auto&& edge_function)
+    {
+        for (const Polygon& polygon : shape)
+        {
+            if (polygon.size() < 3)
+            {
+                continue;
+            }
+            const Point2LL* from = &polygon.back();
+            for (const Point2LL& to : polygon)
+            {
+                edge_function(*from, to);
+                from = &to;
+            }
+        }
+    };
+    const auto first_slab = [this](const Point2LL& from, const Point2LL& to)
+    {
+        return static_cast<size_t>((std::min(from.Y, to.Y) - min_y_) / slab_height_);
+    };
+    const auto last_slab = [this](const Point2LL& from, const Point2LL& to)
+    {
+        return static_cast<size_t>((std::max(from.Y, to.Y) - min_y_) / slab_height_);
+    };
+
+    // Count the edges per slab first, so that they can be stored contiguously.
+    slab_start_.assign(slab_count + 1, 0);
+    for_each_edge(
+        [&](const Point2LL& from, const Point2LL& to)
+        {
+            for (size_t slab = first_slab(from, to); slab <= last_slab(from, to); slab++)
+            {
+                slab_start_[slab + 1]++;
+            }
+        });
+    for (size_t slab = 0; slab < slab_count; slab++)
+    {
+        slab_start_[slab + 1] += slab_start_[slab];
+    }
+
+    const size_t stored_edge_count = slab_start_.back();
+    from_x_.resize(stored_edge_count);
+    from_y_.resize(stored_edge_count);
+    to_x_.resize(stored_edge_count);
+    to_y_.resize(stored_edge_count);
+    std::vector<size_t> slab_end(slab_start_.begin(), slab_start_.end() - 1);
+    for_each_edge(
+        [&](const Point2LL& from, const Point2LL& to)
+        {
+            for (size_t slab = first_slab(from, to); slab <= last_slab(from, to); slab++)
+            {
+                const size_t edge_idx = slab_end[slab]++;
+                from_x_[edge_idx] = from.X;
+                from_y_[edge_idx] = from.Y;
+                to_x_[edge_idx] = to.X;
+                to_y_[edge_idx] = to.Y;
+            }
+        });
+}
+
+bool ShapeInsideIndex::inside(const Point2LL& p, const bool border_result) const
+{
+    if (slab_start_.empty() || p.Y < min_y_)
+    {
+        return false;
+    }
+    const size_t slab = (p.Y - min_y_) / slab_height_;
+    if (slab + 1 >= slab_start_.size())
+    {
+        return false;
+    }
+
+    // The same tests as ClipperLib::PointInPolygon, but without early outs, so that the loop can be vectorized. Since the crossings of all
+    // polygons are counted together, only their parity is the same as the sum of the results of PointInPolygon, but that's all that matters.
+    unsigned int crossings = 0;
+    unsigned int on_border = 0;
+    for (size_t edge_idx = slab_start_[slab]; edge_idx < slab_start_[slab + 1]; edge_idx++)
+    {
+        const coord_t from_x = from_x_[edge_idx] - p.X;
+        const coord_t from_y = from_y_[edge_idx] - p.Y;
+        const coord_t to_x = to_x_[edge_idx] - p.X;
+        const coord_t to_y = to_y_[edge_idx] - p.Y;
+
+        const bool hits_vertex_or_horizontal = (to_y == 0) & ((to_x == 0) | ((from_y == 0) & ((to_x > 0) == (from_x < 0))));
+        const bool straddles = (from_y < 0) != (to_y < 0);
+        const bool both_right = (from_x >= 0) & (to_x > 0);
+        const bool needs_cross_product = straddles & ((from_x >= 0) != (to_x > 0));
+        const double cross_product = static_cast<double>(from_x) * to_y - static_cast<double>(to_x) * from_y;
+        const bool crosses_left = needs_cross_product & (cross_product != 0) & ((cross_product > 0) == (to_y > from_y));
+
+        crossings += (straddles & both_right) | crosses_left;
+        on_border |= hits_vertex_or_horizontal | (needs_cross_product & (cross_product == 0));
+    }
+    if (on_border)
+    {
+        return border_result;
+    }
+    return (crossings % 2) == 1;
+}
+
+std::vector<bool> ShapeInsideIndex::inside(const std::vector<Point2LL>& points, const bool border_result) const
+{
+    std::vector<bool> result;
+    result.reserve(points.size());
+    for (const Point2LL& point : points)
+    {
+        result.push_back(inside(point, border_result));
+    }
+    return result;
+}
+
+size_t ShapeInsideIndex::memoryUsage() const
+{
+    return slab_start_.capacity() * sizeof(size_t) + (from_x_.capacity() + from_y_.capacity() + to_x_.capacity() + to_y_.capacity()) * sizeof(coord_t);
+}
+
+} // namespace cura
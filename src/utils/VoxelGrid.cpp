@@ -0,0 +1,190 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/VoxelGrid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+
+#include "utils/ThreadPool.h"
+
+namespace cura
+{
+
+VoxelGrid::VoxelGrid(const GridPoint3& min, const GridPoint3& max)
+    : min_(min)
+    , size_(std::max(max.x_ - min.x_ + 1, coord_t(0)), std::max(max.y_ - min.y_ + 1, coord_t(0)), std::max(max.z_ - min.z_ + 1, coord_t(0)))
+    , words_per_row_((static_cast<size_t>(size_.x_) + word_bits - 1) / word_bits)
+    , words_(words_per_row_ * static_cast<size_t>(size_.y_) * static_cast<size_t>(size_.z_), 0)
+{
+}
+
+size_t VoxelGrid::size() const
+{
+    return std::transform_reduce(
+        words_.begin(),
+        words_.end(),
+        size_t(0),
+        std::plus<size_t>(),
+        [](const word_t word)
+        {
+            return static_cast<size_t>(std::popcount(word));
+        });
+}
+
+bool VoxelGrid::empty() const
+{
+    return std::all_of(
+        words_.begin(),
+        words_.end(),
+        [](const word_t word)
+        {
+            return word == 0;
+        });
+}
+
+VoxelGrid& VoxelGrid::operator|=(const VoxelGrid& other)
+{
+    assert(min_ == other.min_ && size_ == other.size_);
+    for (size_t word_idx = 0; word_idx < words_.size(); word_idx++)
+    {
+        words_[word_idx] |= other.words_[word_idx];
+    }
+    return *this;
+}
+
+VoxelGrid& VoxelGrid::operator&=(const VoxelGrid& other)
+{
+    assert(min_ == other.min_ && size_ == other.size_);
+    for (size_t word_idx = 0; word_idx < words_.size(); word_idx++)
+    {
+        words_[word_idx] &= other.words_[word_idx];
+    }
+    return *this;
+}
+
+VoxelGrid& VoxelGrid::operator-=(const VoxelGrid& other)
+{
+    assert(min_ == other.min_ && size_ == other.size_);
+    for (size_t word_idx = 0; word_idx < words_.size(); word_idx++)
+    {
+        words_[word_idx] &= ~other.words_[word_idx];
+    }
+    return *this;
+}
+
+VoxelGrid VoxelGrid::dilate(const DilationKernel& kernel) const
+{
+    if (words_.empty())
+    {
+        return *this; // A grid without cells, e.g. with an X extent of 0, stays empty.
+    }
+
+    // Group the kernel per row offset, so that each source row is read once per row it is dilated into.
+    std::map<std::pair<coord_t, coord_t>, std::vector<coord_t>> x_offsets_per_row_offset;
+    for (const GridPoint3& rel : kernel.relative_cells_)
+    {
+        x_offsets_per_row_offset[{ rel.y_, rel.z_ }].push_back(rel.x_);
+    }
+
+    const size_t row_count = static_cast<size_t>(size_.y_) * static_cast<size_t>(size_.z_);
+    std::vector<char> row_is_empty(row_count);
+    for (size_t row = 0; row < row_count; row++)
+    {
+        const auto row_begin = words_.begin() + static_cast<std::ptrdiff_t>(row * words_per_row_);
+        row_is_empty[row] = std::all_of(
+            row_begin,
+            row_begin + static_cast<std::ptrdiff_t>(words_per_row_),
+            [](const word_t word)
+            {
+                return word == 0;
+            });
+    }
+
+    VoxelGrid result(min_, max());
+    // Each task only writes the rows of its own layer.
+    cura::parallel_for<coord_t>(
+        min_.z_,
+        min_.z_ + size_.z_,
+        [&](const coord_t z)
+        {
+            for (const auto& [row_offset, x_offsets] : x_offsets_per_row_offset)
+            {
+                const auto& [dy, dz] = row_offset;
+                const coord_t src_z = z - dz;
+                if (src_z < min_.z_ || src_z >= min_.z_ + size_.z_)
+                {
+                    continue;
+                }
+                for (coord_t y = std::max(min_.y_, min_.y_ + dy); y < std::min(min_.y_ + size_.y_, min_.y_ + size_.y_ + dy); y++)
+                {
+                    const size_t src_row_idx = rowIndex(y - dy, src_z);
+                    if (row_is_empty[src_row_idx / words_per_row_])
+                    {
+                        continue;
+                    }
+                    for (const coord_t dx : x_offsets)
+                    {
+                        orShiftedRow(&words_[src_row_idx], dx, &result.words_[rowIndex(y, z)]);
+                    }
+                }
+            }
+        });
+    result.clearPadding();
+    return result;
+}
+
+void VoxelGrid::orShiftedRow(const word_t* src, const coord_t shift, word_t* dst) const
+{
+    const size_t word_shift = static_cast<size_t>(std::abs(shift)) / word_bits;
+    const size_t bit_shift = static_cast<size_t>(std::abs(shift)) % word_bits;
+    if (word_shift >= words_per_row_)
+    {
+        return;
+    }
+    if (shift >= 0)
+    {
+        for (size_t dst_idx = word_shift; dst_idx < words_per_row_; dst_idx++)
+        {
+            const size_t src_idx = dst_idx - word_shift;
+            word_t shifted = src[src_idx] << bit_shift;
+            if (bit_shift != 0 && src_idx > 0)
+            {
+                shifted |= src[src_idx - 1] >> (word_bits - bit_shift);
+            }
+            dst[dst_idx] |= shifted;
+        }
+    }
+    else
+    {
+        for (size_t dst_idx = 0; dst_idx + word_shift < words_per_row_; dst_idx++)
+        {
+            const size_t src_idx = dst_idx + word_shift;
+            word_t shifted = src[src_idx] >> bit_shift;
+            if (bit_shift != 0 && src_idx + 1 < words_per_row_)
+            {
+                shifted |= src[src_idx + 1] << (word_bits - bit_shift);
+            }
+            dst[dst_idx] |= shifted;
+        }
+    }
+}
+
+void VoxelGrid::clearPadding()
+{
+    const size_t used_bits = static_cast<size_t>(size_.x_) % word_bits;
+    if (used_bits == 0)
+    {
+        return;
+    }
+    const word_t mask = (word_t(1) << used_bits) - 1;
+    for (size_t last_word_idx = words_per_row_ - 1; last_word_idx < words_.size(); last_word_idx += words_per_row_)
+    {
+        words_[last_word_idx] &= mask;
+    }
+}
+
+} // namespace cura
@@ -114,6 +114,11 @@ bool VoxelUtils::walkPolygons(const Shape& polys, coord_t z, const std::function
 }
 
 bool VoxelUtils::walkDilatedPolygons(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const
+{
+    return walkPolygonsForDilation(polys, z, kernel, dilate(kernel, process_cell_func));
+}
+
+bool VoxelUtils::walkPolygonsForDilation(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const
 {
     Shape translated = polys;
     const Point3LL translation = (Point3LL(1, 1, 1) - kernel.kernel_size_ % 2) * cell_size_ / 2;
@@ -121,7 +126,7 @@ bool VoxelUtils::walkDilatedPolygons(const Shape& polys, coord_t z, const Dilati
     {
         translated.translate(Point2LL(translation.x_, translation.y_));
     }
-    return walkPolygons(translated, z + translation.z_, dilate(kernel, process_cell_func));
+    return walkPolygons(translated, z + translation.z_, process_cell_func);
 }
 
 bool VoxelUtils::walkAreas(const Shape& polys, coord_t z, const std::function<bool(GridPoint3)>& process_cell_func) const
@@ -150,6 +155,11 @@ bool VoxelUtils::_walkAreas(const Shape& polys, coord_t z, const std::function<b
 }
 
 bool VoxelUtils::walkDilatedAreas(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const
+{
+    return walkAreasForDilation(polys, z, kernel, dilate(kernel, process_cell_func));
+}
+
+bool VoxelUtils::walkAreasForDilation(const Shape& polys, coord_t z, const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const
 {
     Shape translated = polys;
     const Point3LL translation = (Point3LL(1, 1, 1) - kernel.kernel_size_ % 2) * cell_size_ / 2 // offset half a cell when using a n even kernel
@@ -158,7 +168,7 @@ bool VoxelUtils::walkDilatedAreas(const Shape& polys, coord_t z, const DilationK
     {
         translated.translate(Point2LL(translation.x_, translation.y_));
     }
-    return _walkAreas(translated, z + translation.z_, dilate(kernel, process_cell_func));
+    return _walkAreas(translated, z + translation.z_, process_cell_func);
 }
 
 std::function<bool(GridPoint3)> VoxelUtils::dilate(const DilationKernel& kernel, const std::function<bool(GridPoint3)>& process_cell_func) const
@@ -1,6 +1,7 @@
 // Copyright (c) 2023 UltiMaker
 // CuraEngine is released under the terms of the AGPLv3 or higher
 
+#include <chrono>
 #include <csignal>
 #include <docopt/docopt.h>
 #include <filesystem>
@@ -8,6 +9,8 @@
 #include <iostream>
 #include <map>
 #include <string_view>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #include <vector>
@@ -27,6 +30,8 @@
 #include "rapidjson/writer.h"
 #include "settings/Settings.h"
 #include "sliceDataStorage.h"
+#include "utils/CompactShapeArena.h"
+#include "utils/MemoryUsage.h"
 
 
 constexpr std::string_view USAGE = R"(Stress Benchmark.
@@ -143,8 +148,9 @@ std::vector<Resource> getResources()
     return resources;
 }
 
-void handleChildProcess(const auto& shapes, const auto& settings)
+void handleChildProcess(const auto& shapes, const auto& settings, size_t* shape_copy_count)
 {
+    const size_t copies_before = cura::Shape::getCopyCount();
     cura::SliceLayer layer;
     for (const cura::Shape& shape : shapes)
     {
@@ -155,6 +161,7 @@ void handleChildProcess(const auto& shapes, const auto& settings)
     cura::LayerIndex layer_idx(100);
     cura::WallsComputation walls_computation(settings, layer_idx);
     walls_computation.generateWalls(&layer, cura::SectionType::WALL);
+    *shape_copy_count += cura::Shape::getCopyCount() - copies_before; // The test cases run one after the other, so there is no race.
     exit(EXIT_SUCCESS);
 }
 
@@ -172,6 +179,40 @@ size_t checkCrashCount(size_t crashCount, int status, const auto& resource)
     return crashCount;
 }
 
+struct CompactStorageResult
+{
+    double relative_size; //!< The size of the compact storage, relative to the regular shapes [%]
+    double decode_time; //!< The time to decode all shapes [ms]
+};
+
+CompactStorageResult measureCompactStorage(const std::vector<Resource>& resources)
+{
+    size_t regular_bytes = 0;
+    cura::CompactShapeArena arena;
+    std::vector<cura::CompactShapeArena::Handle> handles;
+    for (const auto& resource : resources)
+    {
+        for (const cura::Shape& shape : resource.polygons())
+        {
+            regular_bytes += sizeof(cura::Shape) + cura::memoryUsage(shape);
+            handles.push_back(arena.add(shape));
+        }
+    }
+    arena.shrinkToFit();
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t decoded_points = 0;
+    for (const cura::CompactShapeArena::Handle handle : handles)
+    {
+        decoded_points += arena.get(handle).pointCount();
+    }
+    const std::chrono::duration<double, std::milli> decode_time = std::chrono::steady_clock::now() - start;
+    spdlog::info("Decoded {} points from the compact storage in {:.3f} ms", decoded_points, decode_time.count());
+
+    const size_t compact_bytes = arena.memoryUsage() + handles.size() * sizeof(cura::CompactShapeArena::Handle);
+    return { .relative_size = regular_bytes == 0 ? 100.0 : 100.0 * compact_bytes / regular_bytes, .decode_time = decode_time.count() };
+}
+
 rapidjson::Value
     createRapidJSONObject(rapidjson::Document::AllocatorType& allocator, const std::string& test_name, const auto value, const std::string& unit, const std::string& extra_info)
 {
@@ -191,7 +232,14 @@ rapidjson::Value
     return obj;
 }
 
-void createAndWriteJson(const std::filesystem::path& out_file, double stress_level, const std::string& extra_info, const size_t no_test_cases)
+void createAndWriteJson(
+    const std::filesystem::path& out_file,
+    double stress_level,
+    const std::string& extra_info,
+    const size_t no_test_cases,
+    const double peak_memory,
+    const size_t shape_copy_count,
+    const CompactStorageResult& compact_storage)
 {
     rapidjson::Document doc;
     doc.SetArray();
@@ -202,6 +250,18 @@ void createAndWriteJson(const std::filesystem::path& out_file, double stress_lev
     auto stress_obj = createRapidJSONObject(allocator, "General Stress Level", stress_level, "%", extra_info);
     doc.PushBack(stress_obj, allocator);
 
+    auto memory_obj = createRapidJSONObject(allocator, "Peak Memory", peak_memory, "MiB", "Largest resident set size of a test case");
+    doc.PushBack(memory_obj, allocator);
+
+    auto copies_obj = createRapidJSONObject(allocator, "Shape Copies", shape_copy_count, "-", "Copies of non-empty shapes in all test cases");
+    doc.PushBack(copies_obj, allocator);
+
+    auto compact_size_obj = createRapidJSONObject(allocator, "Compact Polygon Size", compact_storage.relative_size, "%", "Relative to the regular polygons");
+    doc.PushBack(compact_size_obj, allocator);
+
+    auto compact_decode_obj = createRapidJSONObject(allocator, "Compact Polygon Decode Time", compact_storage.decode_time, "ms", "All polygons of the test cases");
+    doc.PushBack(compact_decode_obj, allocator);
+
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
     doc.Accept(writer);
@@ -225,6 +285,15 @@ int main(int argc, const char** argv)
 
     const auto resources = getResources();
     size_t crash_count = 0;
+
+    // The test cases run in child processes, so they count the copies of shapes in memory that is shared with this process.
+    auto* shape_copy_count = static_cast<size_t*>(mmap(nullptr, sizeof(size_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    if (shape_copy_count == MAP_FAILED)
+    {
+        spdlog::critical("Unable to map the shared copy counter");
+        return EXIT_FAILURE;
+    }
+    *shape_copy_count = 0;
     std::vector<std::string> extra_infos;
 
     for (const auto& resource : resources)
@@ -241,7 +310,7 @@ int main(int argc, const char** argv)
         }
         else if (engine_pid == 0)
         {
-            handleChildProcess(shapes, settings);
+            handleChildProcess(shapes, settings, shape_copy_count);
             return EXIT_SUCCESS;
         }
         else
@@ -274,6 +343,22 @@ int main(int argc, const char** argv)
     const double stress_level = static_cast<double>(crash_count) / static_cast<double>(resources.size()) * 100.0;
     spdlog::info("Stress level: {:.2f} [%]", stress_level);
 
-    createAndWriteJson(std::filesystem::path{ args.at("-o").asString() }, stress_level, fmt::format("Crashes in: {}", fmt::join(extra_infos, ", ")), resources.size());
+    rusage children_usage;
+    getrusage(RUSAGE_CHILDREN, &children_usage);
+    const double peak_memory = static_cast<double>(children_usage.ru_maxrss) / 1024.0; // Kilobytes on Linux.
+    spdlog::info("Peak memory: {:.1f} [MiB]", peak_memory);
+    spdlog::info("Shape copies: {}", *shape_copy_count);
+
+    const CompactStorageResult compact_storage = measureCompactStorage(resources);
+    spdlog::info("Compact polygon storage: {:.1f} [%], decoded in {:.3f} [ms]", compact_storage.relative_size, compact_storage.decode_time);
+
+    createAndWriteJson(
+        std::filesystem::path{ args.at("-o").asString() },
+        stress_level,
+        fmt::format("Crashes in: {}", fmt::join(extra_infos, ", ")),
+        resources.size(),
+        peak_memory,
+        *shape_copy_count,
+        compact_storage);
     return EXIT_SUCCESS;
 }
@@ -140,6 +140,20 @@ TEST_F(GCodeExportTest, CommentTimeFloatRoundingError)
     EXPECT_EQ(std::string(";TIME_ELAPSED:0.300000\n"), output.str()) << "Don't output up to the precision of rounding errors.";
 }
 
+TEST_F(GCodeExportTest, CommentTimeAfterLayer)
+{
+    gcode.estimate_calculator_.addTime(12);
+    gcode.updateTotalPrintTime();
+    EXPECT_EQ(std::string(""), output.str()) << "The estimate is calculated in the background, so the comment must wait until it's asked for.";
+
+    gcode.estimate_calculator_.addTime(30); // Time of the next layer, which must not be part of the first estimate.
+    gcode.writePendingPrintTime();
+    EXPECT_EQ(std::string(";TIME_ELAPSED:12.000000\n"), output.str());
+    gcode.writePendingPrintTime();
+    EXPECT_EQ(std::string(";TIME_ELAPSED:12.000000\n"), output.str()) << "The comment is written only once.";
+    EXPECT_EQ(gcode.getSumTotalPrintTimes(), 12.0);
+}
+
 TEST_F(GCodeExportTest, CommentTypeAllTypesCovered)
 {
     for (auto type = static_cast<PrintFeatureType>(0); type < PrintFeatureType::NumPrintFeatureTypes; type = static_cast<PrintFeatureType>(static_cast<size_t>(type) + 1))
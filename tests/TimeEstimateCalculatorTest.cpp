@@ -1,6 +1,7 @@
 // Copyright (c) 2023 UltiMaker
 // CuraEngine is released under the terms of the AGPLv3 or higher
 
+#include "Application.h" //To plan long sequences of moves in parallel.
 #include "PrintFeature.h" //We get time estimates per print feature.
 #include "settings/Settings.h" //To set firmware settings.
 #include "settings/types/Duration.h"
@@ -430,4 +431,64 @@ TEST_F(TimeEstimateCalculatorTest, StraightAnglePartialJerk)
     EXPECT_NEAR(Duration(first_accelerate_t + first_cruise_distance / 50.0 + first_decelerate_t + second_accelerate_t + second_cruise_distance / 50.0 + second_decelerate_t), result[static_cast<size_t>(PrintFeatureType::Infill)], EPSILON);
 }
 
-} // namespace cura
\ No newline at end of file
+TEST_F(TimeEstimateCalculatorTest, ManySegments)
+{
+    Application::getInstance().startThreadPool();
+    calculator.setFirmwareDefaults(always_50);
+
+    // Enough moves to be planned in several segments, which are planned in parallel.
+    const size_t num_moves = TimeEstimateCalculator::segment_size * 3 + 5;
+    for (size_t move_idx = 1; move_idx <= num_moves; move_idx++)
+    {
+        calculator.plan(TimeEstimateCalculator::Position(static_cast<double>(move_idx), 0, 0, 0), 50.0, PrintFeatureType::Infill);
+    }
+
+    // The first move starts at the speed from which it could still stop within its length, and accelerates to 50mm/s over the next moves.
+    // Then cruise at 50mm/s through all junctions, and decelerate to the minimum planner speed over the last moves.
+    const double initial_speed = std::sqrt(MINIMUM_PLANNER_SPEED * MINIMUM_PLANNER_SPEED + 2.0 * 50.0 * 1.0);
+    const double accelerate_t = (50.0 - initial_speed) / 50.0;
+    const double accelerate_distance = 0.5 * 50.0 * accelerate_t * accelerate_t + initial_speed * accelerate_t;
+    const double decelerate_t = (50.0 - MINIMUM_PLANNER_SPEED) / 50.0;
+    const double decelerate_distance = 0.5 * 50.0 * decelerate_t * decelerate_t + MINIMUM_PLANNER_SPEED * decelerate_t;
+    const double cruise_distance = static_cast<double>(num_moves) - accelerate_distance - decelerate_distance;
+
+    const std::vector<Duration> result = calculator.calculate();
+    EXPECT_NEAR(Duration(accelerate_t + cruise_distance / 50.0 + decelerate_t), result[static_cast<size_t>(PrintFeatureType::Infill)], 0.001);
+}
+
+TEST_F(TimeEstimateCalculatorTest, ManySegmentsWithCorners)
+{
+    Application::getInstance().startThreadPool();
+    calculator.setFirmwareDefaults(jerkless);
+
+    /*
+     * A staircase of 100mm moves, alternating between 25 and 50mm/s, with a jump to another position halfway through the second segment.
+     * Without jerk, the print head stops at every corner. So every move accelerates from 0 to its speed and decelerates to 0 again, except
+     * for the last one, which decelerates to the minimum planner speed.
+     */
+    const size_t num_moves = TimeEstimateCalculator::segment_size * 3 + 5;
+    const size_t jump_move_idx = TimeEstimateCalculator::segment_size * 3 / 2;
+    TimeEstimateCalculator::Position position(0, 0, 0, 0);
+    double expected_time = 0.0;
+    for (size_t move_idx = 0; move_idx < num_moves; move_idx++)
+    {
+        if (move_idx == jump_move_idx)
+        {
+            position = TimeEstimateCalculator::Position(position[0] + 5000.0, position[1] - 3000.0, 0, 0);
+            calculator.setPosition(position);
+        }
+        position[move_idx % 2] += 100.0;
+        const double speed = (move_idx % 2 == 0) ? 25.0 : 50.0;
+        calculator.plan(position, speed, PrintFeatureType::Infill);
+
+        const double end_speed = (move_idx == num_moves - 1) ? MINIMUM_PLANNER_SPEED : 0.0;
+        const double accelerate_distance = speed * speed / (2.0 * 50.0);
+        const double decelerate_distance = (speed * speed - end_speed * end_speed) / (2.0 * 50.0);
+        expected_time += speed / 50.0 + (100.0 - accelerate_distance - decelerate_distance) / speed + (speed - end_speed) / 50.0;
+    }
+
+    const std::vector<Duration> result = calculator.calculate();
+    EXPECT_NEAR(Duration(expected_time), result[static_cast<size_t>(PrintFeatureType::Infill)], 0.01);
+}
+
+} // namespace cura
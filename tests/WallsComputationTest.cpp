@@ -144,6 +144,26 @@ TEST_F(WallsComputationTest, GenerateWallsZeroWalls)
     EXPECT_EQ(layer.parts.size(), 1) << "There is still just 1 part.";
 }
 
+/*!
+ * Tests if the offsets of the outline are shared, and computed again once the walls changed the outline.
+ */
+TEST_F(WallsComputationTest, GenerateWallsClearsOutlineOffsets)
+{
+    SliceLayer layer;
+    layer.parts.emplace_back();
+    SliceLayerPart& part = layer.parts.back();
+    part.outline.push_back(square_shape);
+    const std::shared_ptr<const Shape> before = part.getOutlineOffset(-MM2INT(1));
+    EXPECT_EQ(part.getOutlineOffset(-MM2INT(1)), before) << "The same offset must be shared, not computed again.";
+
+    // Run the test.
+    walls_computation.generateWalls(&layer, SectionType::WALL);
+
+    const std::shared_ptr<const Shape> after = part.getOutlineOffset(-MM2INT(1));
+    EXPECT_NE(after, before) << "Generating the walls may change the outline, so its offsets must be computed again.";
+    EXPECT_EQ(after->area(), part.outline.offset(-MM2INT(1)).area());
+}
+
 /*!
  * Tests if the inner area is properly set.
  */
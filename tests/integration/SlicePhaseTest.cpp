@@ -126,6 +126,32 @@ TEST_F(SlicePhaseTest, Cube)
     }
 }
 
+TEST_F(SlicePhaseTest, CubeBesideTallerMesh)
+{
+    Scene& scene = Application::getInstance().current_slice_->scene;
+    MeshGroup& mesh_group = scene.mesh_groups.back();
+
+    const Matrix4x3D transformation;
+    ASSERT_TRUE(loadMeshIntoMeshGroup(&mesh_group, std::filesystem::path(__FILE__).parent_path().append("resources/cube.stl").string().c_str(), transformation, scene.settings));
+    Mesh& cube_mesh = mesh_group.meshes[0];
+
+    const auto layer_thickness = scene.settings.get<coord_t>("layer_height");
+    const auto initial_layer_thickness = scene.settings.get<coord_t>("layer_height_0");
+    constexpr bool variable_layer_height = false;
+    constexpr std::vector<AdaptiveLayer>* variable_layer_height_values = nullptr;
+    const size_t cube_layers = (cube_mesh.getAABB().max_.z_ - initial_layer_thickness) / layer_thickness + 1;
+    const size_t num_layers = cube_layers * 3; // As if there is another mesh that is three times as high.
+    Slicer slicer(&cube_mesh, layer_thickness, num_layers, variable_layer_height, variable_layer_height_values);
+
+    ASSERT_EQ(slicer.layers.size(), num_layers);
+    EXPECT_EQ(slicer.sliced_layer_range.first, 0);
+    EXPECT_LE(slicer.sliced_layer_range.second, cube_layers + 1) << "Only the layers of the cube need to be sliced.";
+    for (size_t layer_nr = 0; layer_nr < num_layers; layer_nr++)
+    {
+        EXPECT_EQ(slicer.layers[layer_nr].polygons_.size(), layer_nr < cube_layers ? 1 : 0);
+    }
+}
+
 TEST_F(SlicePhaseTest, Cylinder1000)
 {
     Scene& scene = Application::getInstance().current_slice_->scene;
@@ -0,0 +1,117 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "plugins/pluginproxy.h"
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <gtest/gtest.h>
+
+#include "cura/plugins/slots/postprocess/v0/modify.grpc.pb.h"
+#include "plugins/converters.h"
+#include "plugins/validator.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura::plugins
+{
+
+/*
+ * The handshake of a plugin which runs in the test itself.
+ */
+class FakeHandshake : public slots::handshake::v0::HandshakeService::Service
+{
+public:
+    grpc::Status Call(grpc::ServerContext*, const slots::handshake::v0::CallRequest*, slots::handshake::v0::CallResponse* response) override
+    {
+        response->set_plugin_name("FakePostprocessPlugin");
+        response->set_plugin_version("1.0.0");
+        response->set_slot_version_range(">=0.1.0-alpha");
+        return grpc::Status::OK;
+    }
+};
+
+/*
+ * A post-processing plugin which runs in the test itself, and appends a comment to each g-code it gets.
+ */
+class FakePostprocess : public slots::postprocess::v0::modify::PostprocessModifyService::Service
+{
+public:
+    grpc::Status Call(grpc::ServerContext*, const slots::postprocess::v0::modify::CallRequest* request, slots::postprocess::v0::modify::CallResponse* response) override
+    {
+        response->set_gcode_word(request->gcode_word() + ";modified\n");
+        return grpc::Status::OK;
+    }
+};
+
+class PluginProxyTest : public testing::Test
+{
+public:
+    using Proxy = PluginProxy<
+        v0::SlotID::POSTPROCESS_MODIFY,
+        "0.1.0-alpha",
+        slots::postprocess::v0::modify::PostprocessModifyService::Stub,
+        Validator,
+        postprocess_request,
+        postprocess_response>;
+
+    FakeHandshake handshake;
+    FakePostprocess postprocess;
+    std::unique_ptr<grpc::Server> server;
+
+    void SetUp() override
+    {
+        grpc::ServerBuilder builder;
+        builder.RegisterService(&handshake);
+        builder.RegisterService(&postprocess);
+        server = builder.BuildAndStart();
+        ASSERT_NE(server, nullptr);
+    }
+
+    void TearDown() override
+    {
+        server->Shutdown();
+    }
+};
+
+TEST_F(PluginProxyTest, ModifyBatch)
+{
+    Proxy proxy("FakePostprocessPlugin", "1.0.0", server->InProcessChannel(grpc::ChannelArguments()));
+    ASSERT_TRUE(proxy.getPluginInfo().has_value());
+    EXPECT_EQ(proxy.getPluginInfo()->plugin_name, "FakePostprocessPlugin");
+
+    std::vector<std::string> layers;
+    for (size_t layer_nr = 0; layer_nr < 20; layer_nr++)
+    {
+        layers.push_back(";LAYER:" + std::to_string(layer_nr) + "\nG1 X" + std::to_string(layer_nr) + "\n");
+    }
+    const std::vector<std::string> original_layers = layers;
+    proxy.modifyBatch(
+        layers,
+        [](const size_t)
+        {
+            return std::tuple<>{};
+        });
+
+    ASSERT_EQ(layers.size(), original_layers.size());
+    for (size_t layer_nr = 0; layer_nr < layers.size(); layer_nr++)
+    {
+        EXPECT_EQ(layers[layer_nr], original_layers[layer_nr] + ";modified\n") << "The results should be in the order of the batch.";
+    }
+    EXPECT_EQ(proxy.statistics_->calls.load(), layers.size());
+    EXPECT_GT(proxy.statistics_->request_bytes.load(), 0);
+    EXPECT_GT(proxy.statistics_->response_bytes.load(), proxy.statistics_->request_bytes.load());
+
+    proxy.logStatistics();
+    EXPECT_EQ(proxy.statistics_->calls.load(), 0) << "Logging the statistics should reset them.";
+    EXPECT_EQ(proxy.statistics_->latency_us.load(), 0);
+    EXPECT_EQ(proxy.statistics_->request_bytes.load(), 0);
+    EXPECT_EQ(proxy.statistics_->response_bytes.load(), 0);
+}
+
+} // namespace cura::plugins
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,87 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/AsyncFileStreamBuffer.h"
+
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace cura
+{
+
+class AsyncFileStreamBufferTest : public testing::Test
+{
+public:
+    std::filesystem::path filename;
+
+    void SetUp() override
+    {
+        filename = std::filesystem::temp_directory_path() / "AsyncFileStreamBufferTest.gcode";
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(filename);
+    }
+
+    std::string readFile(const bool binary = false) const
+    {
+        std::ifstream file(filename, binary ? std::ios_base::in | std::ios_base::binary : std::ios_base::in);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+};
+
+TEST_F(AsyncFileStreamBufferTest, NotOpen)
+{
+    AsyncFileStreamBuffer buffer(16);
+    std::ostream stream(&buffer);
+    stream << "G28";
+    EXPECT_FALSE(stream.good());
+}
+
+TEST_F(AsyncFileStreamBufferTest, WriteManyBuffers)
+{
+    AsyncFileStreamBuffer buffer(16);
+    ASSERT_TRUE(buffer.open(filename.string().c_str()));
+    std::ostream stream(&buffer);
+    std::string expected;
+    for (int line = 0; line < 1000; line++)
+    {
+        const std::string gcode = "G1 X" + std::to_string(line) + " Y" + std::to_string(line * 2) + "\n";
+        stream << gcode;
+        expected += gcode;
+    }
+
+    stream.flush();
+    EXPECT_TRUE(stream.good());
+    EXPECT_EQ(readFile(), expected) << "Flushing should wait until everything is in the file.";
+
+    stream << "M107\n";
+    buffer.close();
+    EXPECT_EQ(readFile(), expected + "M107\n");
+}
+
+TEST_F(AsyncFileStreamBufferTest, Binary)
+{
+    AsyncFileStreamBuffer buffer(16);
+    ASSERT_TRUE(buffer.open(filename.string().c_str(), true));
+    EXPECT_TRUE(buffer.isBinary());
+    std::ostream stream(&buffer);
+    const std::string data("GCDE\n\r\n\0\x1a\xff", 10);
+    stream << data;
+    buffer.close();
+    EXPECT_EQ(readFile(true), data) << "Binary data should be written as is.";
+
+    ASSERT_TRUE(buffer.open(filename.string().c_str()));
+    EXPECT_FALSE(buffer.isBinary());
+    buffer.close();
+}
+
+} // namespace cura
@@ -0,0 +1,133 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/BinaryGCode.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace cura
+{
+
+namespace
+{
+
+std::string makeGCode(const size_t line_count)
+{
+    std::string gcode;
+    for (size_t line = 0; line < line_count; line++)
+    {
+        gcode += "G1 X" + std::to_string(100 + line % 37) + "." + std::to_string(line % 1000) + " Y" + std::to_string(50 + line % 23) + " E" + std::to_string(line * 3) + "\n";
+    }
+    return gcode;
+}
+
+} // namespace
+
+TEST(BinaryGCodeTest, HeatshrinkRoundTrip)
+{
+    std::mt19937 rng(42);
+    std::string random(10000, '\0');
+    for (char& c : random)
+    {
+        c = static_cast<char>(rng() % 256);
+    }
+    const std::string repetitive(10000, 'a');
+    const std::string gcode = makeGCode(1000);
+
+    for (const std::string& data : { std::string(), std::string("G"), random, repetitive, gcode })
+    {
+        const std::string compressed = bgcode::heatshrinkCompress(data);
+        const std::optional<std::string> decompressed = bgcode::heatshrinkDecompress(compressed, data.size());
+        ASSERT_TRUE(decompressed.has_value());
+        EXPECT_EQ(*decompressed, data);
+    }
+    EXPECT_LT(bgcode::heatshrinkCompress(gcode).size(), gcode.size() / 2) << "G-code should compress well.";
+}
+
+TEST(BinaryGCodeTest, EncoderRoundTrip)
+{
+    const std::string gcode = makeGCode(5000);
+    std::ostringstream file;
+    {
+        BinaryGCodeEncoder encoder(file, 4096);
+        encoder.writeMetadata(bgcode::BlockType::PRINTER_METADATA, bgcode::parseHeaderComments(";FLAVOR:Marlin\n;TIME:6666\n;Generated with Cura\n"));
+        encoder.writeMetadata(bgcode::BlockType::PRINT_METADATA, {});
+        encoder.writeMetadata(bgcode::BlockType::SLICER_METADATA, { { "generator", "Cura_SteamEngine" } });
+        std::ostream stream(&encoder);
+        stream << gcode;
+        stream.flush();
+    }
+
+    const std::optional<std::vector<bgcode::Block>> blocks = bgcode::decode(file.str());
+    ASSERT_TRUE(blocks.has_value());
+    ASSERT_GT(blocks->size(), 4);
+    EXPECT_EQ((*blocks)[0].type, bgcode::BlockType::PRINTER_METADATA);
+    EXPECT_EQ((*blocks)[0].data, "FLAVOR=Marlin\nTIME=6666\n");
+    EXPECT_EQ((*blocks)[1].type, bgcode::BlockType::PRINT_METADATA);
+    EXPECT_EQ((*blocks)[1].data, "");
+    EXPECT_EQ((*blocks)[2].type, bgcode::BlockType::SLICER_METADATA);
+    EXPECT_EQ((*blocks)[2].data, "generator=Cura_SteamEngine\n");
+
+    std::string decoded;
+    for (size_t block_idx = 3; block_idx < blocks->size(); block_idx++)
+    {
+        const bgcode::Block& block = (*blocks)[block_idx];
+        EXPECT_EQ(block.type, bgcode::BlockType::GCODE);
+        EXPECT_LE(block.data.size(), 4096);
+        EXPECT_EQ(block.data.back(), '\n') << "Blocks should only contain complete lines.";
+        decoded += block.data;
+    }
+    EXPECT_EQ(decoded, gcode);
+    EXPECT_LT(file.str().size(), gcode.size() / 2);
+}
+
+TEST(BinaryGCodeTest, MetadataAfterHeldGCode)
+{
+    const std::string gcode = makeGCode(2000);
+    std::ostringstream file;
+    {
+        BinaryGCodeEncoder encoder(file, 4096);
+        encoder.holdGCode();
+        std::ostream stream(&encoder);
+        stream << gcode;
+        stream.flush();
+        EXPECT_EQ(file.str(), bgcode::encodeFileHeader()) << "The g-code should be held back until the metadata is written.";
+
+        encoder.writeMetadata(bgcode::BlockType::PRINTER_METADATA, { { "FLAVOR", "Marlin" } });
+        encoder.writeMetadata(bgcode::BlockType::PRINT_METADATA, { { "TIME", "1234" } });
+        encoder.writeMetadata(bgcode::BlockType::SLICER_METADATA, { { "generator", "Cura_SteamEngine" } });
+        encoder.releaseGCode();
+    }
+
+    const std::optional<std::vector<bgcode::Block>> blocks = bgcode::decode(file.str());
+    ASSERT_TRUE(blocks.has_value());
+    ASSERT_GT(blocks->size(), 3);
+    EXPECT_EQ((*blocks)[0].type, bgcode::BlockType::PRINTER_METADATA);
+    EXPECT_EQ((*blocks)[1].type, bgcode::BlockType::PRINT_METADATA);
+    EXPECT_EQ((*blocks)[1].data, "TIME=1234\n");
+    EXPECT_EQ((*blocks)[2].type, bgcode::BlockType::SLICER_METADATA);
+
+    std::string decoded;
+    for (size_t block_idx = 3; block_idx < blocks->size(); block_idx++)
+    {
+        EXPECT_EQ((*blocks)[block_idx].type, bgcode::BlockType::GCODE);
+        decoded += (*blocks)[block_idx].data;
+    }
+    EXPECT_EQ(decoded, gcode);
+}
+
+TEST(BinaryGCodeTest, DecodeDetectsCorruption)
+{
+    std::string file = bgcode::encodeFileHeader() + bgcode::encodeBlock(bgcode::BlockType::GCODE, makeGCode(100), bgcode::Compression::HEATSHRINK_12_4);
+    ASSERT_TRUE(bgcode::decode(file).has_value());
+
+    file[file.size() / 2] ^= 0x10;
+    EXPECT_FALSE(bgcode::decode(file).has_value());
+    EXPECT_FALSE(bgcode::decode(file.substr(0, file.size() - 1)).has_value());
+}
+
+} // namespace cura
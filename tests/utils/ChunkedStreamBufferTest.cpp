@@ -0,0 +1,87 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/ChunkedStreamBuffer.h"
+
+#include <ostream>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace cura
+{
+
+std::string join(const std::vector<std::string>& blocks)
+{
+    std::string joined;
+    for (const std::string& block : blocks)
+    {
+        joined += block;
+    }
+    return joined;
+}
+
+TEST(ChunkedStreamBufferTest, Empty)
+{
+    ChunkedStreamBuffer buffer(16);
+    EXPECT_EQ(buffer.size(), 0);
+    EXPECT_TRUE(buffer.take().empty());
+}
+
+TEST(ChunkedStreamBufferTest, SingleBlock)
+{
+    ChunkedStreamBuffer buffer(16);
+    std::ostream stream(&buffer);
+    stream << "G1 X10";
+    EXPECT_EQ(buffer.size(), 6);
+
+    const std::vector<std::string> blocks = buffer.take();
+    ASSERT_EQ(blocks.size(), 1);
+    EXPECT_EQ(blocks.front(), "G1 X10");
+    EXPECT_EQ(buffer.size(), 0);
+    EXPECT_TRUE(buffer.take().empty());
+
+    stream << "G0 Y5";
+    EXPECT_EQ(join(buffer.take()), "G0 Y5");
+}
+
+TEST(ChunkedStreamBufferTest, MultipleBlocks)
+{
+    ChunkedStreamBuffer buffer(16);
+    std::ostream stream(&buffer);
+    std::string expected;
+    for (int line = 0; line < 20; line++)
+    {
+        const std::string gcode = "G1 X" + std::to_string(line) + " Y" + std::to_string(line * 2) + "\n";
+        stream << gcode;
+        expected += gcode;
+    }
+    EXPECT_EQ(buffer.size(), expected.size());
+    std::vector<std::string> blocks = buffer.take();
+    EXPECT_EQ(blocks.size(), (expected.size() + 15) / 16);
+    EXPECT_EQ(join(blocks), expected);
+
+    // Writing again after recycling the blocks should reuse them without any old data showing up.
+    std::set<const char*> recycled;
+    for (const std::string& block : blocks)
+    {
+        recycled.insert(block.data());
+    }
+    buffer.recycle(std::move(blocks));
+    stream << "M107\n";
+    for (int line = 0; line < 10; line++)
+    {
+        stream << "G0 X" << line << "\n";
+    }
+    blocks = buffer.take();
+    EXPECT_EQ(join(blocks), "M107\nG0 X0\nG0 X1\nG0 X2\nG0 X3\nG0 X4\nG0 X5\nG0 X6\nG0 X7\nG0 X8\nG0 X9\n");
+    bool reused = false;
+    for (const std::string& block : blocks)
+    {
+        reused |= recycled.contains(block.data());
+    }
+    EXPECT_TRUE(reused);
+}
+
+} // namespace cura
@@ -0,0 +1,141 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/CompactShapeArena.h"
+
+#include <filesystem>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "../ReadTestPolygons.h"
+#include "geometry/Polygon.h"
+#include "geometry/SingleShape.h"
+#include "sliceDataStorage.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+void expectEqual(const Shape& expected, const Shape& result)
+{
+    ASSERT_EQ(result.size(), expected.size());
+    for (size_t polygon_idx = 0; polygon_idx < expected.size(); polygon_idx++)
+    {
+        EXPECT_EQ(result[polygon_idx].getPoints(), expected[polygon_idx].getPoints());
+        EXPECT_EQ(result[polygon_idx].isExplicitelyClosed(), expected[polygon_idx].isExplicitelyClosed());
+    }
+}
+
+Polygon makeSquare(const Point2LL& corner, const coord_t size, const bool explicitely_closed)
+{
+    ClipperLib::Path points{ corner, corner + Point2LL(size, 0), corner + Point2LL(size, size), corner + Point2LL(0, size) };
+    return Polygon(std::move(points), explicitely_closed);
+}
+
+TEST(CompactShapeArenaTest, RoundTrip)
+{
+    Shape shape;
+    shape.push_back(makeSquare(Point2LL(-20000, -30000), 10000, false));
+    shape.push_back(makeSquare(Point2LL(150000, 4), 7, true));
+    Shape single;
+    single.push_back(makeSquare(Point2LL(std::numeric_limits<int32_t>::min(), 0), std::numeric_limits<int32_t>::max(), false));
+
+    CompactShapeArena arena;
+    const CompactShapeArena::Handle shape_handle = arena.add(shape);
+    const CompactShapeArena::Handle empty_handle = arena.add(Shape());
+    const CompactShapeArena::Handle single_handle = arena.add(single);
+    arena.shrinkToFit();
+
+    EXPECT_TRUE(arena.get(empty_handle).empty());
+    for (const auto& [handle, original] : { std::make_pair(shape_handle, &shape), std::make_pair(single_handle, &single) })
+    {
+        expectEqual(*original, arena.get(handle));
+    }
+}
+
+TEST(CompactShapeArenaTest, Size)
+{
+    Shape shape;
+    for (coord_t offset = 0; offset < 100000; offset += 1000)
+    {
+        shape.push_back(makeSquare(Point2LL(offset, offset), 800, false));
+    }
+
+    CompactShapeArena arena;
+    arena.add(shape);
+    arena.shrinkToFit();
+    EXPECT_LT(arena.memoryUsage(), shape.pointCount() * sizeof(Point2LL) / 3);
+}
+
+TEST(CompactShapeArenaTest, SliceLayerRoundTrip)
+{
+    std::vector<Shape> shapes;
+    ASSERT_TRUE(readTestPolygons((std::filesystem::path(__FILE__).parent_path().parent_path() / "resources" / "slice_polygon_1.txt").string(), shapes));
+    ASSERT_FALSE(shapes.empty());
+
+    SliceLayer layer;
+    for (const SingleShape& outline : shapes.front().splitIntoParts())
+    {
+        SliceLayerPart& part = layer.parts.emplace_back();
+        part.outline = outline;
+        part.inner_area = outline.offset(-800);
+        part.infill_area = part.inner_area.offset(-200);
+        part.infill_area_per_combine_per_density = { { part.infill_area.offset(-400), part.infill_area.offset(-1200) }, { part.infill_area } };
+        SkinPart& skin_part = part.skin_parts.emplace_back();
+        skin_part.outline = SingleShape(part.inner_area.difference(part.infill_area.offset(-1000)));
+        skin_part.skin_fill = skin_part.outline.offset(-200);
+        skin_part.top_most_surface_fill = skin_part.skin_fill.offset(-200);
+        part.skin_parts.emplace_back(); // A skin part without any fill.
+    }
+    ASSERT_FALSE(layer.parts.empty());
+    const SliceLayer original = layer;
+    const size_t memory_usage = layer.memoryUsage();
+
+    layer.compact();
+    EXPECT_TRUE(layer.isCompact());
+    EXPECT_LT(layer.memoryUsage(), memory_usage);
+    for (size_t part_idx = 0; part_idx < layer.parts.size(); part_idx++)
+    {
+        const SliceLayerPart& part = layer.parts[part_idx];
+        EXPECT_TRUE(part.inner_area.empty());
+        EXPECT_TRUE(part.infill_area_per_combine_per_density.front().front().empty());
+        // Other layers read the outline, and the extruders used are found from the skin fill, so those stay as they are.
+        expectEqual(original.parts[part_idx].outline, part.outline);
+        expectEqual(original.parts[part_idx].skin_parts.front().skin_fill, part.skin_parts.front().skin_fill);
+    }
+
+    layer.expand();
+    EXPECT_FALSE(layer.isCompact());
+    ASSERT_EQ(layer.parts.size(), original.parts.size());
+    for (size_t part_idx = 0; part_idx < layer.parts.size(); part_idx++)
+    {
+        const SliceLayerPart& part = layer.parts[part_idx];
+        const SliceLayerPart& original_part = original.parts[part_idx];
+        expectEqual(original_part.outline, part.outline);
+        expectEqual(original_part.inner_area, part.inner_area);
+        expectEqual(original_part.infill_area, part.infill_area);
+        ASSERT_EQ(part.infill_area_per_combine_per_density.size(), original_part.infill_area_per_combine_per_density.size());
+        for (size_t density_idx = 0; density_idx < part.infill_area_per_combine_per_density.size(); density_idx++)
+        {
+            ASSERT_EQ(part.infill_area_per_combine_per_density[density_idx].size(), original_part.infill_area_per_combine_per_density[density_idx].size());
+            for (size_t combine_idx = 0; combine_idx < part.infill_area_per_combine_per_density[density_idx].size(); combine_idx++)
+            {
+                expectEqual(original_part.infill_area_per_combine_per_density[density_idx][combine_idx], part.infill_area_per_combine_per_density[density_idx][combine_idx]);
+            }
+        }
+        ASSERT_EQ(part.skin_parts.size(), original_part.skin_parts.size());
+        for (size_t skin_part_idx = 0; skin_part_idx < part.skin_parts.size(); skin_part_idx++)
+        {
+            const SkinPart& skin_part = part.skin_parts[skin_part_idx];
+            const SkinPart& original_skin_part = original_part.skin_parts[skin_part_idx];
+            expectEqual(original_skin_part.skin_fill, skin_part.skin_fill);
+            expectEqual(original_skin_part.roofing_fill, skin_part.roofing_fill);
+            expectEqual(original_skin_part.top_most_surface_fill, skin_part.top_most_surface_fill);
+            expectEqual(original_skin_part.bottom_most_surface_fill, skin_part.bottom_most_surface_fill);
+        }
+    }
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,67 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/DefinitionBundle.h"
+
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace cura
+{
+
+TEST(DefinitionBundleTest, RoundTrip)
+{
+    DefinitionBundle bundle;
+    bundle.source_hash = DefinitionBundle::hashSource("{\"name\": \"Printer\"}");
+    bundle.source_files = { "/definitions/printer.def.json", "/definitions/fdmprinter.def.json", "/extruders/printer_extruder_0.def.json" };
+    bundle.definitions = { { 0, "/definitions/printer.def.json" }, { 2, "/extruders/printer_extruder_1.def.json" } };
+    bundle.global_settings = { { "machine_name", "Printer" }, { "machine_extruder_count", "2" }, { "machine_start_gcode", "G28\nG1 Z5\n" }, { "empty", "" } };
+    bundle.extruder_settings = { { { "machine_nozzle_size", "0.4" } }, {} };
+
+    const std::string data = bundle.serialize();
+    EXPECT_TRUE(DefinitionBundle::isBundle(data));
+    const std::optional<DefinitionBundle> loaded = DefinitionBundle::deserialize(data);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->source_hash, bundle.source_hash);
+    EXPECT_EQ(loaded->source_files, bundle.source_files);
+    EXPECT_EQ(loaded->definitions, bundle.definitions);
+    EXPECT_EQ(loaded->global_settings.size(), 4);
+    for (const auto& setting : bundle.global_settings)
+    {
+        EXPECT_NE(std::find(loaded->global_settings.begin(), loaded->global_settings.end(), setting), loaded->global_settings.end()) << setting.first;
+    }
+    EXPECT_EQ(loaded->extruder_settings, bundle.extruder_settings);
+
+    DefinitionBundle shuffled = bundle;
+    std::reverse(shuffled.global_settings.begin(), shuffled.global_settings.end());
+    EXPECT_EQ(shuffled.serialize(), data) << "The order in which the settings were loaded shouldn't matter.";
+}
+
+TEST(DefinitionBundleTest, RejectInvalid)
+{
+    EXPECT_FALSE(DefinitionBundle::isBundle("{\"inherits\": \"fdmprinter\"}"));
+    EXPECT_FALSE(DefinitionBundle::deserialize("{\"inherits\": \"fdmprinter\"}").has_value());
+
+    DefinitionBundle bundle;
+    bundle.source_files = { "fdmprinter.def.json" };
+    bundle.definitions = { { 0, "fdmprinter.def.json" } };
+    bundle.global_settings = { { "layer_height", "0.1" } };
+    const std::string data = bundle.serialize();
+    for (size_t length = 0; length < data.size(); length++)
+    {
+        EXPECT_FALSE(DefinitionBundle::deserialize(data.substr(0, length)).has_value()) << "Truncated to " << length << " bytes.";
+    }
+    EXPECT_FALSE(DefinitionBundle::deserialize(data + "x").has_value());
+}
+
+TEST(DefinitionBundleTest, HashSource)
+{
+    const uint64_t hash = DefinitionBundle::hashSource("b", DefinitionBundle::hashSource("a"));
+    EXPECT_EQ(hash, DefinitionBundle::hashSource("b", DefinitionBundle::hashSource("a")));
+    EXPECT_NE(hash, DefinitionBundle::hashSource("a", DefinitionBundle::hashSource("b")));
+    EXPECT_NE(hash, DefinitionBundle::hashSource("ab"));
+}
+
+} // namespace cura
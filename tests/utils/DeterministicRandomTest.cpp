@@ -0,0 +1,45 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/DeterministicRandom.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace cura
+{
+
+TEST(DeterministicRandomTest, SameSeedSameSequence)
+{
+    DeterministicRandom first(42);
+    DeterministicRandom second(42);
+    DeterministicRandom other(43);
+    size_t differences = 0;
+    for (size_t i = 0; i < 100; i++)
+    {
+        const uint64_t number = first.next();
+        EXPECT_EQ(number, second.next());
+        differences += number != other.next();
+    }
+    EXPECT_GT(differences, 90) << "Neighbouring seeds must give different sequences.";
+}
+
+TEST(DeterministicRandomTest, Below)
+{
+    DeterministicRandom random(7);
+    std::vector<size_t> histogram(10, 0);
+    for (size_t i = 0; i < 10000; i++)
+    {
+        const int64_t number = random.below(10);
+        ASSERT_GE(number, 0);
+        ASSERT_LT(number, 10);
+        histogram[number]++;
+    }
+    for (const size_t count : histogram)
+    {
+        EXPECT_GT(count, 800) << "The numbers must be spread over the whole range.";
+    }
+}
+
+} // namespace cura
@@ -0,0 +1,51 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/MemoryUsage.h"
+
+#include <gtest/gtest.h>
+
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+#include "utils/ExtrusionLine.h"
+
+namespace cura
+{
+
+TEST(MemoryUsageTest, Geometry)
+{
+    Polygon square;
+    square.reserve(4);
+    square.push_back(Point2LL(0, 0));
+    square.push_back(Point2LL(1000, 0));
+    square.push_back(Point2LL(1000, 1000));
+    square.push_back(Point2LL(0, 1000));
+    EXPECT_EQ(memoryUsage(square), 4 * sizeof(Point2LL));
+
+    Shape shape;
+    shape.push_back(square);
+    shape.push_back(square);
+    EXPECT_GE(memoryUsage(shape), 2 * sizeof(Polygon) + 8 * sizeof(Point2LL));
+
+    std::vector<Shape> shapes{ shape, Shape() };
+    EXPECT_GE(memoryUsage(shapes), 2 * sizeof(Shape) + memoryUsage(shape));
+
+    VariableWidthLines lines(1);
+    lines.front().junctions_.reserve(10);
+    EXPECT_EQ(memoryUsage(lines), sizeof(ExtrusionLine) + 10 * sizeof(ExtrusionJunction));
+}
+
+TEST(MemoryUsageTest, Report)
+{
+    MemoryReport report;
+    report.add("walls", 100);
+    report.add("support", 50);
+    report.addToLayer(2, 30);
+    report.addToLayer(0, 10);
+    report.addToLayer(2, 5);
+    EXPECT_EQ(report.total(), 150);
+    EXPECT_EQ(report.bytes_per_layer, std::vector<size_t>({ 10, 0, 35 }));
+    EXPECT_GT(getPeakResidentMemory(), 0);
+}
+
+} // namespace cura
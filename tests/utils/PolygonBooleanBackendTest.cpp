@@ -0,0 +1,191 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "geometry/PolygonBooleanBackend.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <boost/geometry/geometries/multi_polygon.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+#include <boost/geometry/io/wkt/read.hpp>
+#include <gtest/gtest.h>
+
+#include "../ReadTestPolygons.h"
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+#include "geometry/SingleShape.h"
+#include "utils/AABB.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+// NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+class PolygonBooleanBackendTest : public testing::Test
+{
+public:
+    std::vector<Shape> shapes;
+
+    void SetUp() override
+    {
+        const std::filesystem::path tests_path = std::filesystem::path(__FILE__).parent_path().parent_path();
+        for (const auto& file : std::filesystem::directory_iterator(tests_path / "resources"))
+        {
+            if (file.path().filename().string().starts_with("polygon_"))
+            {
+                ASSERT_TRUE(readTestPolygons(file.path().string(), shapes)) << "Could not read " << file.path();
+            }
+        }
+
+        using point_type = boost::geometry::model::d2::point_xy<double>;
+        using polygon_type = boost::geometry::model::polygon<point_type>;
+        using multi_polygon_type = boost::geometry::model::multi_polygon<polygon_type>;
+        for (const auto& file : std::filesystem::directory_iterator(tests_path.parent_path() / "stress_benchmark" / "resources"))
+        {
+            if (file.path().extension() != ".wkt")
+            {
+                continue;
+            }
+            std::ifstream stream{ file.path() };
+            std::stringstream buffer;
+            buffer << stream.rdbuf();
+            multi_polygon_type boost_polygons;
+            boost::geometry::read_wkt(buffer.str(), boost_polygons);
+
+            Shape& shape = shapes.emplace_back();
+            for (const auto& boost_polygon : boost_polygons)
+            {
+                Polygon& outer = shape.newLine();
+                for (const auto& point : boost_polygon.outer())
+                {
+                    outer.emplace_back(point.x(), point.y());
+                }
+                for (const auto& hole : boost_polygon.inners())
+                {
+                    Polygon& inner = shape.newLine();
+                    for (const auto& point : hole)
+                    {
+                        inner.emplace_back(point.x(), point.y());
+                    }
+                }
+            }
+        }
+        ASSERT_FALSE(shapes.empty());
+    }
+
+    static void expectEqual(const Shape& expected, const Shape& result)
+    {
+        ASSERT_EQ(result.size(), expected.size());
+        for (size_t polygon_idx = 0; polygon_idx < expected.size(); polygon_idx++)
+        {
+            EXPECT_EQ(result[polygon_idx].getPoints(), expected[polygon_idx].getPoints());
+        }
+    }
+
+    /*!
+     * The results of different backends may differ in rounding, so allow for about one unit of difference along the outlines, plus the
+     * arc tolerance of rounded offsets.
+     */
+    static void expectSimilar(const Shape& expected, const Shape& result, const Shape& input, const std::string& operation)
+    {
+        const double tolerance = 10.0 * (input.length() + expected.length()) + 1e-6 * std::abs(expected.area());
+        EXPECT_NEAR(result.area(), expected.area(), tolerance) << operation;
+        EXPECT_LE(result.xorPolygons(expected).area(), tolerance) << operation;
+    }
+};
+// NOLINTEND(misc-non-private-member-variables-in-classes)
+
+TEST_F(PolygonBooleanBackendTest, FindByName)
+{
+    const PolygonBooleanBackend* clipper = PolygonBooleanBackend::find("clipper");
+    ASSERT_NE(clipper, nullptr);
+    EXPECT_EQ(clipper->name(), "clipper");
+    EXPECT_EQ(PolygonBooleanBackend::find("unknown"), nullptr);
+    EXPECT_EQ(PolygonBooleanBackend::find(PolygonBooleanBackend::get().name()), &PolygonBooleanBackend::get());
+}
+
+TEST_F(PolygonBooleanBackendTest, ShapeUsesSelectedBackend)
+{
+    const PolygonBooleanBackend& backend = PolygonBooleanBackend::get();
+    for (const Shape& shape : shapes)
+    {
+        const AABB box(shape);
+        Shape moved = shape;
+        moved.translate((box.max_ - box.min_) / 3);
+
+        expectEqual(shape.difference(moved), backend.clip(ClipperLib::ctDifference, shape.getLines(), moved.getLines(), ClipperLib::pftEvenOdd));
+        expectEqual(shape.offset(100), backend.offset(shape.unionPolygons().getLines(), 100, ClipperLib::jtMiter, 1.2));
+    }
+}
+
+TEST_F(PolygonBooleanBackendTest, BackendsAgree)
+{
+    const PolygonBooleanBackend* reference = PolygonBooleanBackend::find("clipper");
+    const PolygonBooleanBackend* clipper2 = PolygonBooleanBackend::find("clipper2");
+    if (clipper2 == nullptr)
+    {
+        GTEST_SKIP() << "Built without Clipper2.";
+    }
+
+    for (const Shape& shape : shapes)
+    {
+        const AABB box(shape);
+        Shape moved = shape;
+        moved.translate((box.max_ - box.min_) / 3);
+        const Shape unioned = reference->clip(ClipperLib::ctUnion, shape.getLines(), {}, ClipperLib::pftNonZero);
+
+        for (const auto& [clip_type, operation] : { std::pair{ ClipperLib::ctUnion, "union" },
+                                                    std::pair{ ClipperLib::ctDifference, "difference" },
+                                                    std::pair{ ClipperLib::ctIntersection, "intersection" },
+                                                    std::pair{ ClipperLib::ctXor, "xor" } })
+        {
+            for (const ClipperLib::PolyFillType fill_type : { ClipperLib::pftEvenOdd, ClipperLib::pftNonZero })
+            {
+                expectSimilar(
+                    reference->clip(clip_type, shape.getLines(), moved.getLines(), fill_type),
+                    clipper2->clip(clip_type, shape.getLines(), moved.getLines(), fill_type),
+                    shape,
+                    operation);
+            }
+        }
+
+        for (const coord_t distance : { -200, -20, 20, 200 })
+        {
+            for (const ClipperLib::JoinType join_type : { ClipperLib::jtMiter, ClipperLib::jtRound, ClipperLib::jtSquare })
+            {
+                expectSimilar(
+                    reference->offset(unioned.getLines(), distance, join_type, 1.2),
+                    clipper2->offset(unioned.getLines(), distance, join_type, 1.2),
+                    unioned,
+                    "offset");
+            }
+        }
+
+        for (const ClipperLib::PolyFillType fill_type : { ClipperLib::pftEvenOdd, ClipperLib::pftNonZero })
+        {
+            const std::vector<SingleShape> expected_parts = reference->splitIntoParts(shape, fill_type);
+            const std::vector<SingleShape> parts = clipper2->splitIntoParts(shape, fill_type);
+            EXPECT_EQ(parts.size(), expected_parts.size());
+            Shape expected_joined;
+            Shape joined;
+            for (const SingleShape& part : expected_parts)
+            {
+                expected_joined.push_back(part);
+            }
+            for (const SingleShape& part : parts)
+            {
+                joined.push_back(part);
+            }
+            expectSimilar(expected_joined, joined, shape, "split");
+        }
+    }
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
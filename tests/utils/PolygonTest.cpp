@@ -3,6 +3,7 @@
 
 #include "geometry/Polygon.h" // The class under test.
 
+#include <cmath>
 #include <numbers>
 
 #include <gtest/gtest.h>
@@ -130,6 +131,19 @@ TEST_F(PolygonTest, polygonOffsetTest)
     ASSERT_NEAR(expanded_length, contracted_length, 5) << "Offset on outside poly is different from offset on inverted poly!";
 }
 
+TEST_F(PolygonTest, temporaryShapeIsNotCopied)
+{
+    Shape shape(test_square);
+    const size_t copies_before = Shape::getCopyCount();
+
+    Shape result = Shape(shape).offset(0).difference(Shape()).getOutsidePolygons();
+    EXPECT_EQ(Shape::getCopyCount(), copies_before + 1) << "Only the explicit copy is made, the operations without effect move the shape along.";
+    EXPECT_EQ(result.area(), shape.area());
+
+    result = shape.offset(0);
+    EXPECT_EQ(Shape::getCopyCount(), copies_before + 2) << "A shape that is not temporary must still be copied.";
+}
+
 TEST_F(PolygonTest, polygonOffsetBugTest)
 {
     Shape polys;
@@ -562,6 +576,29 @@ TEST_F(PolygonTest, removeSmallAreas_complex)
     twoPolygonsAreEqual(act_polygons, exp_polygons);
 }
 
+TEST_F(PolygonTest, offsetConvexSameAsOffset)
+{
+    Polygon ellipse;
+    constexpr size_t vertex_count = 12;
+    for (size_t vertex_idx = 0; vertex_idx < vertex_count; vertex_idx++)
+    {
+        const double angle = 2 * std::numbers::pi * vertex_idx / vertex_count;
+        ellipse.emplace_back(std::llround(1000 + 800 * std::cos(angle)), std::llround(-500 + 300 * std::sin(angle)));
+    }
+
+    for (const Polygon& polygon : { ellipse, test_square, triangle, clockwise_large, pointy_square })
+    {
+        for (const coord_t distance : { -20, 0, 10, 50, 333 })
+        {
+            const Shape expected = polygon.offset(distance);
+            const Shape result = polygon.offsetConvex(distance);
+            ASSERT_EQ(result.size(), expected.size()) << "The offset of a single polygon should have as many parts as the general offset.";
+            EXPECT_NEAR(result.area(), expected.area(), polygon.length()) << "Rounding may differ at most one unit along the outline.";
+            EXPECT_LE(result.xorPolygons(expected).area(), polygon.length()) << "The offsets should overlap.";
+        }
+    }
+}
+
 /*
  * Test that we can iterate over segments of open/closed polylines and convert them to each other
  */
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/ResultCache.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace cura
+{
+
+TEST(ResultCacheTest, GetPut)
+{
+    ResultCache<int, std::string> cache(100);
+    EXPECT_FALSE(cache.get(1).has_value());
+
+    cache.put(1, "one", 10);
+    cache.put(2, "two", 10);
+    ASSERT_TRUE(cache.get(1).has_value());
+    EXPECT_EQ(*cache.get(1), "one");
+    EXPECT_EQ(*cache.get(2), "two");
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.usedBytes(), 20);
+
+    cache.put(1, "uno", 10);
+    EXPECT_EQ(*cache.get(1), "one") << "Results that are already cached shouldn't be replaced.";
+    EXPECT_EQ(cache.usedBytes(), 20);
+}
+
+TEST(ResultCacheTest, EvictLeastRecentlyUsed)
+{
+    ResultCache<int, int> cache(30);
+    cache.put(1, 1, 10);
+    cache.put(2, 2, 10);
+    cache.put(3, 3, 10);
+    EXPECT_TRUE(cache.get(1).has_value()); // Now 2 is the least recently used.
+
+    cache.put(4, 4, 10);
+    EXPECT_TRUE(cache.get(1).has_value());
+    EXPECT_FALSE(cache.get(2).has_value());
+    EXPECT_TRUE(cache.get(3).has_value());
+    EXPECT_TRUE(cache.get(4).has_value());
+
+    cache.put(5, 5, 25);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.usedBytes(), 25);
+
+    cache.put(6, 6, 31);
+    EXPECT_FALSE(cache.get(6).has_value()) << "Results larger than the cache shouldn't be stored.";
+    EXPECT_TRUE(cache.get(5).has_value());
+}
+
+TEST(ResultCacheTest, Clear)
+{
+    ResultCache<int, int> cache(30);
+    cache.put(1, 1, 10);
+    cache.put(2, 2, 10);
+    cache.clear();
+    EXPECT_FALSE(cache.get(1).has_value());
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.usedBytes(), 0);
+
+    cache.put(3, 3, 30);
+    EXPECT_TRUE(cache.get(3).has_value()) << "The cleared results shouldn't take up space anymore.";
+}
+
+} // namespace cura
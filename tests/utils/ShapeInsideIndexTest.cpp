@@ -0,0 +1,83 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/ShapeInsideIndex.h"
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "geometry/Polygon.h"
+#include "geometry/Shape.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+TEST(ShapeInsideIndexTest, SameAsShape)
+{
+    std::mt19937_64 random(42);
+    for (size_t trial = 0; trial < 200; trial++)
+    {
+        // A small coordinate range, so that many points fall exactly on vertices and edges.
+        const coord_t range = (trial % 2 == 0) ? 10 : 1000;
+        Shape shape;
+        const size_t polygon_count = 1 + random() % 4;
+        for (size_t polygon_idx = 0; polygon_idx < polygon_count; polygon_idx++)
+        {
+            Polygon& polygon = shape.newLine();
+            const size_t point_count = 1 + random() % 20; // Also polygons with fewer than 3 vertices, which are ignored.
+            for (size_t point_idx = 0; point_idx < point_count; point_idx++)
+            {
+                polygon.emplace_back(random() % range, random() % range);
+            }
+        }
+        const ShapeInsideIndex index(shape);
+
+        std::vector<Point2LL> points;
+        for (size_t point_idx = 0; point_idx < 100; point_idx++)
+        {
+            points.emplace_back(coord_t(random() % (range + 4)) - 2, coord_t(random() % (range + 4)) - 2);
+        }
+        for (const bool border_result : { false, true })
+        {
+            const std::vector<bool> batch = index.inside(points, border_result);
+            ASSERT_EQ(batch.size(), points.size());
+            for (size_t point_idx = 0; point_idx < points.size(); point_idx++)
+            {
+                const bool expected = shape.inside(points[point_idx], border_result);
+                EXPECT_EQ(index.inside(points[point_idx], border_result), expected);
+                EXPECT_EQ(batch[point_idx], expected);
+            }
+        }
+    }
+}
+
+TEST(ShapeInsideIndexTest, Hole)
+{
+    Shape donut;
+    Polygon& outer = donut.newLine();
+    outer.emplace_back(0, 0);
+    outer.emplace_back(1000, 0);
+    outer.emplace_back(1000, 1000);
+    outer.emplace_back(0, 1000);
+    Polygon& hole = donut.newLine();
+    hole.emplace_back(250, 250);
+    hole.emplace_back(250, 750);
+    hole.emplace_back(750, 750);
+    hole.emplace_back(750, 250);
+    const ShapeInsideIndex index(donut);
+
+    EXPECT_TRUE(index.inside(Point2LL(100, 500)));
+    EXPECT_FALSE(index.inside(Point2LL(500, 500)));
+    EXPECT_FALSE(index.inside(Point2LL(1500, 500)));
+    EXPECT_FALSE(index.inside(Point2LL(500, -10)));
+    EXPECT_FALSE(index.inside(Point2LL(250, 500), false));
+    EXPECT_TRUE(index.inside(Point2LL(250, 500), true));
+
+    const ShapeInsideIndex empty_index{ Shape() };
+    EXPECT_FALSE(empty_index.inside(Point2LL(0, 0), true));
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,77 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/ThreadPool.h"
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h"
+
+namespace cura
+{
+
+class ThreadPoolTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool(4);
+    }
+};
+
+TEST_F(ThreadPoolTest, AdaptiveVisitsEveryItemOnce)
+{
+    constexpr size_t item_count = 1000;
+    std::vector<std::atomic<size_t>> visits(item_count);
+    parallel_for_adaptive<size_t>(
+        "uniform",
+        0,
+        item_count,
+        [&visits](const size_t item)
+        {
+            visits[item]++;
+        });
+    for (const std::atomic<size_t>& visit_count : visits)
+    {
+        EXPECT_EQ(visit_count, 1);
+    }
+}
+
+TEST_F(ThreadPoolTest, AdaptiveWithCostHint)
+{
+    std::vector<size_t> costs(500, 0);
+    costs[3] = 100000; // One item that costs much more than all others together.
+    costs[499] = 1000;
+    std::vector<std::atomic<size_t>> visits(costs.size());
+    parallel_for_adaptive(
+        "uneven",
+        costs.begin(),
+        costs.end(),
+        [&costs, &visits](const std::vector<size_t>::iterator item)
+        {
+            visits[item - costs.begin()]++;
+        },
+        [](const std::vector<size_t>::iterator item)
+        {
+            return *item;
+        });
+    for (const std::atomic<size_t>& visit_count : visits)
+    {
+        EXPECT_EQ(visit_count, 1);
+    }
+
+    // Empty ranges are allowed.
+    parallel_for_adaptive<size_t>(
+        "empty",
+        7,
+        7,
+        [](const size_t)
+        {
+            FAIL();
+        });
+}
+
+} // namespace cura
@@ -0,0 +1,136 @@
+// Copyright (c) 2026 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/VoxelGrid.h"
+
+#include <random>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "Application.h"
+
+namespace cura
+{
+
+class VoxelGridTest : public testing::TestWithParam<DilationKernel::Type>
+{
+public:
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool();
+    }
+
+    static std::unordered_set<GridPoint3> toSet(const VoxelGrid& grid)
+    {
+        std::unordered_set<GridPoint3> cells;
+        grid.forEach(
+            [&cells](const GridPoint3& cell)
+            {
+                cells.emplace(cell);
+            });
+        return cells;
+    }
+};
+
+TEST_F(VoxelGridTest, InsertContains)
+{
+    VoxelGrid grid(GridPoint3(-70, -3, -2), GridPoint3(70, 3, 2));
+    EXPECT_TRUE(grid.empty());
+
+    grid.insert(GridPoint3(-70, -3, -2));
+    grid.insert(GridPoint3(-7, 0, 1));
+    grid.insert(GridPoint3(70, 3, 2));
+    grid.insert(GridPoint3(71, 0, 0)); // outside of the grid
+
+    EXPECT_EQ(grid.size(), 3);
+    EXPECT_TRUE(grid.contains(GridPoint3(-70, -3, -2)));
+    EXPECT_TRUE(grid.contains(GridPoint3(-7, 0, 1)));
+    EXPECT_TRUE(grid.contains(GridPoint3(70, 3, 2)));
+    EXPECT_FALSE(grid.contains(GridPoint3(-6, 0, 1)));
+    EXPECT_FALSE(grid.contains(GridPoint3(71, 0, 0)));
+
+    const std::unordered_set<GridPoint3> expected{ GridPoint3(-70, -3, -2), GridPoint3(-7, 0, 1), GridPoint3(70, 3, 2) };
+    EXPECT_EQ(toSet(grid), expected);
+}
+
+TEST_F(VoxelGridTest, SetOperations)
+{
+    const GridPoint3 min(0, 0, 0);
+    const GridPoint3 max(99, 1, 1);
+    VoxelGrid a(min, max);
+    VoxelGrid b(min, max);
+    for (coord_t x = 0; x < 100; x++)
+    {
+        if (x % 2 == 0)
+        {
+            a.insert(GridPoint3(x, 1, 1));
+        }
+        if (x % 3 == 0)
+        {
+            b.insert(GridPoint3(x, 1, 1));
+        }
+    }
+
+    VoxelGrid intersection = a;
+    intersection &= b;
+    EXPECT_EQ(intersection.size(), 17); // multiples of 6
+
+    VoxelGrid difference = a;
+    difference -= b;
+    EXPECT_EQ(difference.size(), 50 - 17);
+
+    VoxelGrid unioned = a;
+    unioned |= b;
+    EXPECT_EQ(unioned.size(), 50 + 34 - 17);
+}
+
+TEST_F(VoxelGridTest, EmptyExtent)
+{
+    const VoxelGrid grid(GridPoint3(10, 0, 0), GridPoint3(9, 5, 5)); // No cells along the X axis.
+    EXPECT_TRUE(grid.empty());
+    EXPECT_FALSE(grid.inBounds(GridPoint3(10, 0, 0)));
+
+    const VoxelGrid dilated = grid.dilate(DilationKernel(GridPoint3(3, 3, 3), DilationKernel::Type::CUBE));
+    EXPECT_TRUE(dilated.empty());
+    EXPECT_EQ(dilated.size(), 0);
+}
+
+TEST_P(VoxelGridTest, DilateMatchesKernel)
+{
+    std::mt19937 rng(42);
+    const GridPoint3 min(-70, -5, -3);
+    const GridPoint3 max(100, 6, 4);
+    VoxelGrid grid(min, max);
+    std::unordered_set<GridPoint3> cells;
+    for (size_t cell_idx = 0; cell_idx < 50; cell_idx++)
+    {
+        const GridPoint3 cell(min.x_ + rng() % 171, min.y_ + rng() % 12, min.z_ + rng() % 8);
+        grid.insert(cell);
+        cells.emplace(cell);
+    }
+
+    for (coord_t kernel_size = 1; kernel_size < 6; kernel_size++)
+    {
+        const DilationKernel kernel(GridPoint3(kernel_size, kernel_size, kernel_size), GetParam());
+        std::unordered_set<GridPoint3> expected;
+        for (const GridPoint3& cell : cells)
+        {
+            for (const GridPoint3& rel : kernel.relative_cells_)
+            {
+                if (grid.inBounds(cell + rel))
+                {
+                    expected.emplace(cell + rel);
+                }
+            }
+        }
+
+        const VoxelGrid dilated = grid.dilate(kernel);
+        EXPECT_EQ(dilated.size(), expected.size()) << "kernel size " << kernel_size;
+        EXPECT_EQ(toSet(dilated), expected) << "kernel size " << kernel_size;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(DilateInstantiation, VoxelGridTest, testing::Values(DilationKernel::Type::CUBE, DilationKernel::Type::DIAMOND, DilationKernel::Type::PRISM));
+
+} // namespace cura